@@ -0,0 +1,19 @@
+# Computes the build identifier of the compiler, i.e. a hash of the contents of its sources (passed as the ;-separated
+# SOURCES, relative to SOURCE_DIR), and writes it to the header at OUTPUT, which is only rewritten if the identifier
+# changed. Program images are keyed by this identifier (see vm/program_image.cpp), such that images compiled by a build
+# from different sources are never loaded.
+
+set(contents "")
+foreach(source IN LISTS SOURCES)
+    file(SHA256 "${SOURCE_DIR}/${source}" source_hash)
+    string(APPEND contents "${source} ${source_hash}\n")
+endforeach()
+string(SHA256 build_id "${contents}")
+
+set(header "// generated by cmake/build_id.cmake\n#define TEALANG_BUILD_ID \"${build_id}\"\n")
+if(EXISTS "${OUTPUT}")
+    file(READ "${OUTPUT}" previous)
+endif()
+if(NOT "${previous}" STREQUAL "${header}")
+    file(WRITE "${OUTPUT}" "${header}")
+endif()
@@ -0,0 +1,388 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "constant_folder.h"
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+// ----- FOLDING UTILITY FUNCTIONS -----
+
+// Visits the child at position i of an internal node, replacing it by the literal to which it folds (if any)
+void constant_folder::fold_child(astInnerNode* node, size_t i){
+    astNode* child = node->children.at(i);
+    folded = nullptr;
+
+    if(child != nullptr){
+        child->accept(this);
+
+        if(folded != nullptr){
+            node->children.at(i) = folded;
+        }
+    }
+}
+
+// Folds the (constant expressions in the) subtree of each child of a node which does not itself fold, eg. a statement
+void constant_folder::fold_children(astInnerNode* node){
+    for(size_t i = 0; i < node->children.size(); i++){
+        fold_child(node, i);
+    }
+
+    folded = nullptr;
+}
+
+// Creates a literal holding a constant; the lexeme is only maintained for labelling the node
+astLITERAL* constant_folder::make_literal(const value& constant, grammarDFA::Symbol type, const string& type_str,
+                                          unsigned int line){
+    std::ostringstream lexeme;
+
+    switch(type){
+        case grammarDFA::T_BOOL: lexeme << (constant.b ? "true" : "false"); break;
+        case grammarDFA::T_INT: lexeme << constant.i; break;
+        case grammarDFA::T_FLOAT: lexeme << constant.f; break;
+        case grammarDFA::T_CHAR: lexeme << '\'' << constant.c << '\''; break;
+        default: lexeme << '"' << constant.str() << '"';
+    }
+
+    auto* literal = arena->make<astLITERAL>(lexeme.str(), type, type_str, line);
+    literal->constant = type == grammarDFA::T_STRING ? value::intern(constant.str()) : constant;
+
+    return literal;
+}
+
+/* Applies a binary op on two constants of the specified type (that of the operands), with the same semantics as the
+ * interpreter, except that int arithmetic is carried out on unsigned integers such that overflow wraps around (rather
+ * than being undefined) as on the targets supported. Returns false if the op cannot be applied at compile time, i.e. a
+ * division by zero, or the division of the least int by -1 (which traps); such an op is left unfolded, and hence fails at
+ * run-time only if evaluated (eg. it may lie in a branch which is never taken).
+ */
+bool constant_folder::binop(const string& op, grammarDFA::Symbol type, const value& lit1, const value& lit2,
+                            value& result){
+    if(op == "*"){
+        if(type == grammarDFA::T_INT){
+            result = (int32_t) ((uint32_t) lit1.i * (uint32_t) lit2.i);
+        }
+        else{
+            result = lit1.f * lit2.f;
+        }
+    }
+    else if(op == "/"){
+        if(type == grammarDFA::T_INT){
+            if(lit2.i == 0 || (lit1.i == INT32_MIN && lit2.i == -1)){
+                return false;
+            }
+
+            result = lit1.i / lit2.i;
+        }
+        else{
+            if(lit2.f == 0){
+                return false;
+            }
+
+            result = lit1.f / lit2.f;
+        }
+    }
+    else if(op == "and"){
+        result = lit1.b && lit2.b;
+    }
+    else if(op == "+"){
+        if(type == grammarDFA::T_INT){
+            result = (int32_t) ((uint32_t) lit1.i + (uint32_t) lit2.i);
+        }
+        else if(type == grammarDFA::T_FLOAT){
+            result = lit1.f + lit2.f;
+        }
+        else if(type == grammarDFA::T_CHAR){
+            result = (char) (lit1.c + lit2.c);
+        }
+        else{
+            result = lit1.str() + lit2.str();
+        }
+    }
+    else if(op == "-"){
+        if(type == grammarDFA::T_INT){
+            result = (int32_t) ((uint32_t) lit1.i - (uint32_t) lit2.i);
+        }
+        else if(type == grammarDFA::T_FLOAT){
+            result = lit1.f - lit2.f;
+        }
+        else{
+            result = (char) (lit1.c - lit2.c);
+        }
+    }
+    else if(op == "or"){
+        result = lit1.b || lit2.b;
+    }
+    else{ // otherwise a relational op, which is applied on the operands compared as a three-way comparison
+        int cmp;
+
+        switch(type){
+            case grammarDFA::T_BOOL: cmp = (lit1.b > lit2.b) - (lit1.b < lit2.b); break;
+            case grammarDFA::T_INT: cmp = (lit1.i > lit2.i) - (lit1.i < lit2.i); break;
+            case grammarDFA::T_CHAR: cmp = (lit1.c > lit2.c) - (lit1.c < lit2.c); break;
+            case grammarDFA::T_STRING: cmp = lit1.str().compare(lit2.str()); break;
+            default: // floats are compared directly, since NaN operands are unordered
+                if(op == "=="){ result = lit1.f == lit2.f;}
+                else if(op == "!="){ result = lit1.f != lit2.f;}
+                else if(op == "<="){ result = lit1.f <= lit2.f;}
+                else if(op == ">="){ result = lit1.f >= lit2.f;}
+                else if(op == "<"){ result = lit1.f < lit2.f;}
+                else{ result = lit1.f > lit2.f;}
+                return true;
+        }
+
+        if(op == "=="){ result = cmp == 0;}
+        else if(op == "!="){ result = cmp != 0;}
+        else if(op == "<="){ result = cmp <= 0;}
+        else if(op == ">="){ result = cmp >= 0;}
+        else if(op == "<"){ result = cmp < 0;}
+        else{ result = cmp > 0;}
+    }
+
+    return true;
+}
+
+// Folds the operands of a binary op, and then the op itself if both operands fold
+void constant_folder::fold_binop(astBinaryOp* node){
+    fold_child(node, 0);
+    fold_child(node, 1);
+    folded = nullptr;
+
+    auto* lit1 = node->operand1()->kind == astNode::LITERAL ? (astLITERAL*) node->operand1() : nullptr;
+    auto* lit2 = node->operand2()->kind == astNode::LITERAL ? (astLITERAL*) node->operand2() : nullptr;
+
+    // warn of (but do not count as an error) a division by a literal zero, which is left unfolded (see binop)
+    if(node->op == "/" && lit2 != nullptr && ((lit2->type == grammarDFA::T_INT && lit2->constant.i == 0) ||
+                                              (lit2->type == grammarDFA::T_FLOAT && lit2->constant.f == 0))){
+        std::cerr << "ln " << node->line << ": division by zero will fail if evaluated" << std::endl;
+    }
+
+    value result;
+    if(lit1 != nullptr && lit2 != nullptr && binop(node->op, lit2->type, lit1->constant, lit2->constant, result)){
+        if(node->kind == astNode::RELOP){
+            folded = make_literal(result, grammarDFA::T_BOOL, "bool", node->line);
+        }
+        else{
+            folded = make_literal(result, lit2->type, lit2->type_str, node->line);
+        }
+    }
+}
+
+// ----- CONSTANT FOLDER VISITOR RULES -----
+
+void constant_folder::visit(astTYPE* node){
+    folded = nullptr;
+}
+
+/* Decodes the lexeme of the literal, in the same manner as the interpreter did upon each evaluation: numeric lexemes are
+ * converted (reporting those out of range), and the opening and closing apostrophes (or quotation marks) are removed
+ * from character (or string) literals, binding escaped characters to the corresponding character in C++.
+ */
+void constant_folder::visit(astLITERAL* node){
+    const string& lexeme = node->lexeme;
+
+    if(node->type == grammarDFA::T_BOOL){
+        node->constant = (lexeme == "true");
+    }
+    else if(node->type == grammarDFA::T_INT || node->type == grammarDFA::T_FLOAT){
+        try{
+            if(node->type == grammarDFA::T_INT){
+                node->constant = (int32_t) stoi(lexeme);
+            }
+            else{
+                node->constant = stof(lexeme);
+            }
+        }
+        catch(const std::out_of_range&){
+            err_count++;
+            std::cerr << "ln " << node->line << ": " << node->type_str << " literal " << lexeme << " is out of range"
+            << std::endl;
+        }
+    }
+    else if(node->type == grammarDFA::T_CHAR){
+        string literal_cpy = lexeme;
+
+        std::size_t opening_apost = literal_cpy.find_first_of('\'');
+        if(opening_apost != string::npos){
+            literal_cpy.erase(opening_apost, 1);
+        }
+
+        std::size_t closing_apost = literal_cpy.find_last_of('\'');
+        if(closing_apost != string::npos){
+            literal_cpy.erase(closing_apost, 1);
+        }
+
+        char c;
+        if(literal_cpy[0] == '\\'){
+            switch(literal_cpy[1]){
+                case '0': c = '\0'; break;
+                case '\\': c = '\\'; break;
+                case '\'': c = '\''; break;
+                case '"': c = '\"'; break;
+                case 'n': c = '\n'; break;
+                case 't': c = '\t'; break;
+                case 'r': c = '\r'; break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                default: c = '\v';
+            }
+        }
+        else{
+            c = literal_cpy[0];
+        }
+
+        node->constant = c;
+    }
+    else{
+        string literal_cpy = lexeme;
+
+        std::size_t opening_dquotes = literal_cpy.find_first_of('\"');
+        if(opening_dquotes != string::npos){
+            literal_cpy.erase(opening_dquotes, 1);
+        }
+
+        std::size_t closing_dquotes = literal_cpy.find_last_of('\"');
+        if(closing_dquotes != string::npos){
+            literal_cpy.erase(closing_dquotes, 1);
+        }
+
+        node->constant = value::intern(literal_cpy);
+    }
+
+    folded = node;
+}
+
+void constant_folder::visit(astIDENTIFIER* node){
+    folded = nullptr;
+}
+
+void constant_folder::visit(astELEMENT* node){
+    fold_children(node); // i.e. the index
+}
+
+void constant_folder::visit(astMULTOP* node){
+    fold_binop(node);
+}
+
+void constant_folder::visit(astADDOP* node){
+    fold_binop(node);
+}
+
+void constant_folder::visit(astRELOP* node){
+    fold_binop(node);
+}
+
+void constant_folder::visit(astAPARAMS* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astFUNC_CALL* node){
+    fold_children(node);
+}
+
+// A sub-expression folds to the literal to which its expression folds (if any)
+void constant_folder::visit(astSUBEXPR* node){
+    fold_child(node, 0);
+}
+
+void constant_folder::visit(astUNARY* node){
+    fold_child(node, 0);
+    folded = nullptr;
+
+    if(node->operand()->kind == astNode::LITERAL){
+        auto* literal = (astLITERAL*) node->operand();
+        value result;
+
+        if(node->op == "-"){
+            if(literal->type == grammarDFA::T_INT){
+                result = (int32_t) (0u - (uint32_t) literal->constant.i);
+            }
+            else{
+                result = -1 * literal->constant.f;
+            }
+        }
+        else{
+            result = !literal->constant.b;
+        }
+
+        folded = make_literal(result, literal->type, literal->type_str, node->line);
+    }
+}
+
+void constant_folder::visit(astASSIGNMENT_IDENTIFIER* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astASSIGNMENT_ELEMENT* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astASSIGNMENT_MEMBER* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astVAR_DECL* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astARR_DECL* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astTLS_DECL* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astPRINT* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astRETURN* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astIF* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astFOR* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astPAR_FOR* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astWHILE* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astFPARAMS* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astFPARAM* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astFUNC_DECL* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astMEMBER_ACCESS* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astBLOCK* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astPROGRAM* node){
+    fold_children(node);
+}
+
+void constant_folder::visit(astHOISTED* node){
+    fold_children(node);
+}
@@ -0,0 +1,77 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_CONSTANT_FOLDER_H
+#define CPS2000_CONSTANT_FOLDER_H
+
+#include "../visitor_ast/astNode.h"
+#include "../visitor_ast/ast_arena.h"
+#include "../visitor_ast/visitor.h"
+
+/* Carries out constant folding on a (semantically checked) abstract syntax tree, such that neither the interpreter nor
+ * the bytecode compiler need decode literals or evaluate constant operations.
+ *
+ * Each literal is decoded once into its typed value (see astLITERAL::constant), i.e. numeric lexemes are converted and
+ * the apostrophes/quotation marks of character and string literals are stripped (with escaped characters bound), with
+ * strings interned (see value::intern) such that equal string literals share a single string. Then
+ * every binary operation, unary operation or sub-expression whose operands are all literals is replaced by the literal
+ * holding its result (allocated from the arena holding the tree), bottom-up, such that constant expressions fold
+ * entirely. Operations are applied with the same semantics as at run-time (eg. integer arithmetic wraps around).
+ *
+ * Numeric literals which are out of range are reported at compile time; such errors are counted in err_count, in which
+ * case the program should not be executed. A division by a literal zero is instead left unfolded, and hence reported at
+ * run-time (if ever evaluated), as before; since it may lie in a branch which is never taken, it is only warned of at
+ * compile time, without being counted in err_count.
+ */
+class constant_folder: public visitor{
+public:
+    void visit(astTYPE* node) override;
+    void visit(astLITERAL* node) override;
+    void visit(astIDENTIFIER* node) override;
+    void visit(astELEMENT* node) override;
+    void visit(astMULTOP* node) override;
+    void visit(astADDOP* node) override;
+    void visit(astRELOP* node) override;
+    void visit(astAPARAMS* node) override;
+    void visit(astFUNC_CALL* node) override;
+    void visit(astSUBEXPR* node) override;
+    void visit(astUNARY* node) override;
+    void visit(astASSIGNMENT_IDENTIFIER* node) override;
+    void visit(astASSIGNMENT_ELEMENT* node) override;
+    void visit(astASSIGNMENT_MEMBER* node) override;
+    void visit(astVAR_DECL* node) override;
+    void visit(astARR_DECL* node) override;
+    void visit(astTLS_DECL* node) override;
+    void visit(astPRINT* node) override;
+    void visit(astRETURN* node) override;
+    void visit(astIF* node) override;
+    void visit(astFOR* node) override;
+    void visit(astPAR_FOR* node) override;
+    void visit(astWHILE* node) override;
+    void visit(astFPARAMS* node) override;
+    void visit(astFPARAM* node) override;
+    void visit(astFUNC_DECL* node) override;
+    void visit(astMEMBER_ACCESS* node) override;
+    void visit(astBLOCK* node) override;
+    void visit(astPROGRAM* node) override;
+    void visit(astHOISTED* node) override;
+
+    explicit constant_folder(ast_arena* arena){
+        this->arena = arena;
+    }
+
+    int err_count = 0;
+
+private:
+    ast_arena* arena;
+    astLITERAL* folded = nullptr; // the literal to which the last expression visited folds, nullptr if not constant
+
+    void fold_child(astInnerNode* node, size_t i);
+    void fold_children(astInnerNode* node);
+    void fold_binop(astBinaryOp* node);
+    astLITERAL* make_literal(const value& constant, grammarDFA::Symbol type, const string& type_str, unsigned int line);
+    static bool binop(const string& op, grammarDFA::Symbol type, const value& lit1, const value& lit2, value& result);
+};
+
+#endif //CPS2000_CONSTANT_FOLDER_H
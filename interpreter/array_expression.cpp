@@ -0,0 +1,218 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "array_expression.h"
+#include "array_kernels.h"
+
+// ----- EXPRESSION CONSTRUCTION -----
+
+int array_expression::leaf(literal_arr_t arr){
+    nodes.push_back(node{LEAF, arr->elt_tag, arr->size, -1, -1, arr, {}});
+    return (int) nodes.size() - 1;
+}
+
+int array_expression::binop(Op op, int lhs, int rhs){
+    // arithmetic yields the type of the operands (taken from the second, as in the interpreter), otherwise a bool
+    value::Tag tag = op == ADD || op == SUB || op == MUL || op == DIV ? nodes[rhs].tag : value::BOOL;
+
+    nodes.push_back(node{op, tag, nodes[lhs].size, lhs, rhs, value(), {}});
+    return (int) nodes.size() - 1;
+}
+
+int array_expression::unary(Op op, int operand){
+    nodes.push_back(node{op, nodes[operand].tag, nodes[operand].size, operand, -1, value(), {}});
+    return (int) nodes.size() - 1;
+}
+
+// ----- EVALUATION -----
+
+// Returns a pointer to the elements of the array starting from the specified (chunk aligned) index
+array_expression::chunk_ptr array_expression::offset(literal_arr_t arr, int32_t base){
+    chunk_ptr ptr{};
+
+    switch(arr->elt_tag){
+        case value::INT: ptr.ints = arr->ints + base; break;
+        case value::FLOAT: ptr.floats = arr->floats + base; break;
+        case value::CHAR: ptr.chars = arr->chars + base; break;
+        case value::BOOL: ptr.bits = arr->bits + base / 64; break;
+        default: ptr.values = arr->values + base;
+    }
+
+    return ptr;
+}
+
+literal_arr_t array_expression::evaluate(){
+    int root = (int) nodes.size() - 1;
+    if(nodes[root].op == LEAF){ return nodes[root].operand.a;} // nothing to evaluate
+
+    int32_t size = nodes[root].size;
+    auto* result = new tl_array(nodes[root].tag, size);
+
+    /* Each intermediate node is assigned a fixed-size buffer holding its results for the current chunk (string results
+     * are held as values, everything else fits in CHUNK_SIZE / 2 words); leaves and the root instead point directly into
+     * the operand arrays and the resulting array respectively.
+     */
+    int n_words = 0, n_values = 0;
+    for(int i = 0; i < root; i++){
+        if(nodes[i].op != LEAF){
+            if(nodes[i].tag == value::STRING){ n_values += CHUNK_SIZE;}
+            else{ n_words += CHUNK_SIZE / 2;}
+        }
+    }
+
+    std::vector<uint64_t> words(n_words);
+    std::vector<value> values(n_values);
+
+    n_words = 0, n_values = 0;
+    for(int i = 0; i < root; i++){
+        if(nodes[i].op != LEAF){
+            if(nodes[i].tag == value::STRING){
+                nodes[i].chunk.values = values.data() + n_values;
+                n_values += CHUNK_SIZE;
+            }
+            else{
+                nodes[i].chunk.bits = words.data() + n_words;
+                n_words += CHUNK_SIZE / 2;
+            }
+        }
+    }
+
+    // apply the operations chunk by chunk, in the order in which they were added (i.e. operands before operations)
+    for(int32_t base = 0; base < size; base += CHUNK_SIZE){
+        int32_t len = std::min(CHUNK_SIZE, size - base);
+
+        for(int i = 0; i <= root; i++){
+            node& n = nodes[i];
+
+            if(n.op == LEAF){
+                n.chunk = offset(n.operand.a, base);
+            }
+            else{
+                if(i == root){ n.chunk = offset(result, base);}
+                apply(n, len);
+            }
+        }
+    }
+
+    if(result->elt_tag == value::BOOL){ result->clear_tail();} // word-wise operations may set bits beyond the last element
+    return result;
+}
+
+// Applies the operation of the node on the current chunk (of len elements) of its operands
+void array_expression::apply(node& n, int32_t len){
+    const node& x = nodes[n.lhs];
+    int32_t n_words = (len + 63) / 64;
+
+    switch(n.op){
+        case AND: bits_and(x.chunk.bits, nodes[n.rhs].chunk.bits, n.chunk.bits, n_words); break;
+        case OR: bits_or(x.chunk.bits, nodes[n.rhs].chunk.bits, n.chunk.bits, n_words); break;
+        case NOT: bits_not(x.chunk.bits, n.chunk.bits, n_words); break;
+        case NEG:
+            if(n.tag == value::INT){
+                neg_i32(x.chunk.ints, n.chunk.ints, len);
+            }
+            else if(n.tag == value::FLOAT){
+                neg_f32(x.chunk.floats, n.chunk.floats, len);
+            }
+            else{
+                for(int32_t i = 0; i < len; i++){ n.chunk.chars[i] = (char) (-1 * x.chunk.chars[i]);}
+            }
+            break;
+        case ADD: case SUB: case MUL: case DIV:
+            arith(n, x, nodes[n.rhs], len);
+            break;
+        default:
+            compare(n, x, nodes[n.rhs], len);
+    }
+}
+
+void array_expression::arith(node& n, const node& x, const node& y, int32_t len){
+    if(n.tag == value::INT || n.tag == value::FLOAT){
+        kernel_op k_op = n.op == ADD ? K_ADD : n.op == SUB ? K_SUB : n.op == MUL ? K_MUL : K_DIV;
+
+        if(n.tag == value::INT){
+            arith_i32(k_op, x.chunk.ints, y.chunk.ints, n.chunk.ints, len);
+        }
+        else{
+            arith_f32(k_op, x.chunk.floats, y.chunk.floats, n.chunk.floats, len);
+        }
+    }
+    else if(n.tag == value::CHAR){
+        if(n.op == ADD){
+            for(int32_t i = 0; i < len; i++){ n.chunk.chars[i] = (char) (x.chunk.chars[i] + y.chunk.chars[i]);}
+        }
+        else{
+            for(int32_t i = 0; i < len; i++){ n.chunk.chars[i] = (char) (x.chunk.chars[i] - y.chunk.chars[i]);}
+        }
+    }
+    else{ // otherwise the elements are strings, which are concatenated element by element
+        for(int32_t i = 0; i < len; i++){ n.chunk.values[i] = x.chunk.values[i].str() + y.chunk.values[i].str();}
+    }
+}
+
+// Utility function applying a relational op on two elements
+template <typename T>
+static bool compare_elt(array_expression::Op op, const T& a, const T& b){
+    switch(op){
+        case array_expression::EQ: return a == b;
+        case array_expression::NE: return a != b;
+        case array_expression::LT: return a < b;
+        case array_expression::LE: return a <= b;
+        case array_expression::GT: return a > b;
+        default: return a >= b;
+    }
+}
+
+// Utility function applying a relational op on two string elements, comparing interned strings in constant time
+static bool compare_str(array_expression::Op op, const value& a, const value& b){
+    switch(op){
+        case array_expression::EQ: return a.str_equals(b);
+        case array_expression::NE: return !a.str_equals(b);
+        default: return compare_elt(op, a.str(), b.str());
+    }
+}
+
+void array_expression::compare(node& n, const node& x, const node& y, int32_t len){
+    int32_t n_words = (len + 63) / 64;
+
+    if(x.tag == value::BOOL){ // bool elements are compared on entire words of the bitsets
+        for(int32_t w = 0; w < n_words; w++){
+            uint64_t a = x.chunk.bits[w];
+            uint64_t b = y.chunk.bits[w];
+
+            switch(n.op){
+                case EQ: n.chunk.bits[w] = ~(a ^ b); break;
+                case NE: n.chunk.bits[w] = a ^ b; break;
+                case LT: n.chunk.bits[w] = ~a & b; break;
+                case LE: n.chunk.bits[w] = ~a | b; break;
+                case GT: n.chunk.bits[w] = a & ~b; break;
+                default: n.chunk.bits[w] = a | ~b;
+            }
+        }
+    }
+    else if(x.tag == value::INT || x.tag == value::FLOAT){
+        kernel_cmp cmp = n.op == EQ ? K_EQ : n.op == NE ? K_NE : n.op == LT ? K_LT : n.op == LE ? K_LE : n.op == GT ? K_GT : K_GE;
+
+        if(x.tag == value::INT){
+            compare_i32(cmp, x.chunk.ints, y.chunk.ints, n.chunk.bits, len);
+        }
+        else{
+            compare_f32(cmp, x.chunk.floats, y.chunk.floats, n.chunk.bits, len);
+        }
+    }
+    else{ // otherwise the elements are chars or strings, which are compared element by element
+        for(int32_t w = 0; w < n_words; w++){
+            uint64_t word = 0;
+
+            for(int32_t i = w * 64; i < std::min(len, w * 64 + 64); i++){
+                bool b = x.tag == value::CHAR ? compare_elt(n.op, x.chunk.chars[i], y.chunk.chars[i])
+                                              : compare_str(n.op, x.chunk.values[i], y.chunk.values[i]);
+
+                word |= (uint64_t) b << (i & 63);
+            }
+
+            n.chunk.bits[w] = word;
+        }
+    }
+}
@@ -0,0 +1,76 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_ARRAY_EXPRESSION_H
+#define CPS2000_ARRAY_EXPRESSION_H
+
+#include "../symbol_table/value.h"
+#include <vector>
+
+/* A fused array expression, i.e. a tree of element-wise operations over arrays (eg. v*s + t*u), evaluated in a single
+ * pass over the elements without allocating arrays for the intermediate results (in the spirit of expression templates).
+ *
+ * The interpreter builds the expression bottom-up, adding the (already evaluated) array operands as leaves and each
+ * operation as a node over previously added nodes; the last node added is the root. The elements are then evaluated in
+ * chunks of CHUNK_SIZE elements: for each chunk, each operation is applied (using the vectorised kernels) on the chunks of
+ * its operands, with intermediate results held in fixed-size per-node buffers, and the root writing directly into the
+ * resulting array. Hence the extra memory required is independent of the size of the arrays, and the intermediate
+ * results of a chunk remain in cache until consumed.
+ *
+ * No run-time errors arise during evaluation: the interpreter checks that operand sizes match as nodes are added, and
+ * ensures that divisors do not contain 0 (see interpreter::fuse).
+ */
+class array_expression{
+public:
+    enum Op : uint8_t{
+        LEAF, ADD, SUB, MUL, DIV, AND, OR, EQ, NE, LT, LE, GT, GE, NEG, NOT
+    };
+
+    static constexpr int32_t CHUNK_SIZE = 256; // a multiple of 64, such that chunks of bool elements are word aligned
+
+    // adds an array operand, returning the index of the node
+    int leaf(literal_arr_t arr);
+
+    // adds a binary operation on (the results of) the nodes lhs and rhs, of equal size, returning the index of the node
+    int binop(Op op, int lhs, int rhs);
+
+    // adds a unary operation (NEG or NOT) on (the result of) the node operand, returning the index of the node
+    int unary(Op op, int operand);
+
+    // the number of elements resulting from the node
+    int32_t size(int index) const{
+        return nodes[index].size;
+    }
+
+    // evaluates the expression, returning the array resulting from the root (i.e. the array itself, if a leaf)
+    literal_arr_t evaluate();
+
+private:
+    // pointer to the elements of the current chunk, for the element type of the node
+    union chunk_ptr{
+        int32_t* ints;
+        float* floats;
+        char* chars;
+        uint64_t* bits;
+        value* values;
+    };
+
+    struct node{
+        Op op;
+        value::Tag tag; // element type of the result
+        int32_t size;
+        int lhs, rhs; // operand nodes (-1 if none)
+        value operand; // in the case of a leaf, the array operand (held until the expression is evaluated)
+        chunk_ptr chunk;
+    };
+
+    std::vector<node> nodes;
+
+    static chunk_ptr offset(literal_arr_t arr, int32_t base);
+    void apply(node& n, int32_t len);
+    void arith(node& n, const node& x, const node& y, int32_t len);
+    void compare(node& n, const node& x, const node& y, int32_t len);
+};
+
+#endif //CPS2000_ARRAY_EXPRESSION_H
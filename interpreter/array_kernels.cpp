@@ -0,0 +1,426 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "array_kernels.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define TL_KERNELS_X86
+#include <immintrin.h>
+#endif
+
+// ----- SCALAR IMPLEMENTATIONS (also used for the elements remaining after the vectorised loops) -----
+
+template<typename T>
+static void arith_scalar(kernel_op op, const T* x, const T* y, T* z, int32_t i, int32_t n){
+    switch(op){
+        case K_ADD: for(; i < n; i++){ z[i] = x[i] + y[i];} break;
+        case K_SUB: for(; i < n; i++){ z[i] = x[i] - y[i];} break;
+        case K_MUL: for(; i < n; i++){ z[i] = x[i] * y[i];} break;
+        case K_DIV: for(; i < n; i++){ z[i] = x[i] / y[i];} break;
+    }
+}
+
+template<typename T>
+static void neg_scalar(const T* x, T* z, int32_t i, int32_t n){
+    for(; i < n; i++){ z[i] = -1 * x[i];}
+}
+
+// packs the comparisons of the elements from index i (a multiple of 64) onwards into words of the bitset z
+template<typename T, typename C>
+static void compare_words(const T* x, const T* y, uint64_t* z, int32_t i, int32_t n, C c){
+    for(; i < n; i += 64){
+        int32_t end = n < i + 64 ? n : i + 64;
+        uint64_t word = 0;
+
+        for(int32_t j = i; j < end; j++){
+            word |= (uint64_t) c(x[j], y[j]) << (j - i);
+        }
+
+        z[i >> 6] = word;
+    }
+}
+
+template<typename T>
+static void compare_scalar(kernel_cmp cmp, const T* x, const T* y, uint64_t* z, int32_t i, int32_t n){
+    switch(cmp){
+        case K_EQ: compare_words(x, y, z, i, n, [](T a, T b){ return a == b;}); break;
+        case K_NE: compare_words(x, y, z, i, n, [](T a, T b){ return a != b;}); break;
+        case K_LT: compare_words(x, y, z, i, n, [](T a, T b){ return a < b;}); break;
+        case K_LE: compare_words(x, y, z, i, n, [](T a, T b){ return a <= b;}); break;
+        case K_GT: compare_words(x, y, z, i, n, [](T a, T b){ return a > b;}); break;
+        case K_GE: compare_words(x, y, z, i, n, [](T a, T b){ return a >= b;}); break;
+    }
+}
+
+#ifdef TL_KERNELS_X86
+
+// ----- SSE2 IMPLEMENTATIONS -----
+
+// SSE2 lacks a 32-bit integer multiply (low), hence it is composed from the even and odd 32x32->64-bit products
+static inline __m128i mullo_epi32_sse2(__m128i a, __m128i b){
+    __m128i even = _mm_mul_epu32(a, b);
+    __m128i odd = _mm_mul_epu32(_mm_srli_si128(a, 4), _mm_srli_si128(b, 4));
+
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                              _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static void arith_i32_sse2(kernel_op op, const int32_t* x, const int32_t* y, int32_t* z, int32_t n){
+    int32_t i = 0;
+
+    if(op != K_DIV){ // no vector integer division; fall through to the scalar loop
+        for(; i + 4 <= n; i += 4){
+            __m128i a = _mm_loadu_si128((const __m128i*) (x + i));
+            __m128i b = _mm_loadu_si128((const __m128i*) (y + i));
+            __m128i c = op == K_ADD ? _mm_add_epi32(a, b) : op == K_SUB ? _mm_sub_epi32(a, b) : mullo_epi32_sse2(a, b);
+
+            _mm_storeu_si128((__m128i*) (z + i), c);
+        }
+    }
+
+    arith_scalar(op, x, y, z, i, n);
+}
+
+static void arith_f32_sse2(kernel_op op, const float* x, const float* y, float* z, int32_t n){
+    int32_t i = 0;
+
+    for(; i + 4 <= n; i += 4){
+        __m128 a = _mm_loadu_ps(x + i);
+        __m128 b = _mm_loadu_ps(y + i);
+        __m128 c;
+
+        switch(op){
+            case K_ADD: c = _mm_add_ps(a, b); break;
+            case K_SUB: c = _mm_sub_ps(a, b); break;
+            case K_MUL: c = _mm_mul_ps(a, b); break;
+            default: c = _mm_div_ps(a, b);
+        }
+
+        _mm_storeu_ps(z + i, c);
+    }
+
+    arith_scalar(op, x, y, z, i, n);
+}
+
+static void neg_i32_sse2(const int32_t* x, int32_t* z, int32_t n){
+    int32_t i = 0;
+
+    for(; i + 4 <= n; i += 4){
+        __m128i a = _mm_loadu_si128((const __m128i*) (x + i));
+        _mm_storeu_si128((__m128i*) (z + i), _mm_sub_epi32(_mm_setzero_si128(), a));
+    }
+
+    neg_scalar(x, z, i, n);
+}
+
+static void neg_f32_sse2(const float* x, float* z, int32_t n){
+    int32_t i = 0;
+    __m128 minus_one = _mm_set1_ps(-1.0f);
+
+    for(; i + 4 <= n; i += 4){
+        _mm_storeu_ps(z + i, _mm_mul_ps(minus_one, _mm_loadu_ps(x + i)));
+    }
+
+    neg_scalar(x, z, i, n);
+}
+
+// returns a 4-bit mask of the lane-wise comparison
+static inline int cmp_i32_sse2(kernel_cmp cmp, __m128i a, __m128i b){
+    __m128i m;
+
+    switch(cmp){
+        case K_EQ: case K_NE: m = _mm_cmpeq_epi32(a, b); break;
+        case K_LT: case K_GE: m = _mm_cmplt_epi32(a, b); break;
+        default: m = _mm_cmpgt_epi32(a, b); // K_GT, K_LE
+    }
+
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(m));
+    return cmp == K_NE || cmp == K_GE || cmp == K_LE ? mask ^ 0xF : mask;
+}
+
+static inline int cmp_f32_sse2(kernel_cmp cmp, __m128 a, __m128 b){
+    switch(cmp){
+        case K_EQ: return _mm_movemask_ps(_mm_cmpeq_ps(a, b));
+        case K_NE: return _mm_movemask_ps(_mm_cmpneq_ps(a, b));
+        case K_LT: return _mm_movemask_ps(_mm_cmplt_ps(a, b));
+        case K_LE: return _mm_movemask_ps(_mm_cmple_ps(a, b));
+        case K_GT: return _mm_movemask_ps(_mm_cmpgt_ps(a, b));
+        default: return _mm_movemask_ps(_mm_cmpge_ps(a, b));
+    }
+}
+
+static void compare_i32_sse2(kernel_cmp cmp, const int32_t* x, const int32_t* y, uint64_t* z, int32_t n){
+    int32_t i = 0;
+
+    for(; i + 64 <= n; i += 64){ // each word packs the masks of 16 vectors
+        uint64_t word = 0;
+
+        for(int k = 0; k < 64; k += 4){
+            __m128i a = _mm_loadu_si128((const __m128i*) (x + i + k));
+            __m128i b = _mm_loadu_si128((const __m128i*) (y + i + k));
+            word |= (uint64_t) cmp_i32_sse2(cmp, a, b) << k;
+        }
+
+        z[i >> 6] = word;
+    }
+
+    compare_scalar(cmp, x, y, z, i, n);
+}
+
+static void compare_f32_sse2(kernel_cmp cmp, const float* x, const float* y, uint64_t* z, int32_t n){
+    int32_t i = 0;
+
+    for(; i + 64 <= n; i += 64){
+        uint64_t word = 0;
+
+        for(int k = 0; k < 64; k += 4){
+            word |= (uint64_t) cmp_f32_sse2(cmp, _mm_loadu_ps(x + i + k), _mm_loadu_ps(y + i + k)) << k;
+        }
+
+        z[i >> 6] = word;
+    }
+
+    compare_scalar(cmp, x, y, z, i, n);
+}
+
+// ----- AVX2 IMPLEMENTATIONS -----
+
+__attribute__((target("avx2")))
+static void arith_i32_avx2(kernel_op op, const int32_t* x, const int32_t* y, int32_t* z, int32_t n){
+    int32_t i = 0;
+
+    if(op != K_DIV){
+        for(; i + 8 <= n; i += 8){
+            __m256i a = _mm256_loadu_si256((const __m256i*) (x + i));
+            __m256i b = _mm256_loadu_si256((const __m256i*) (y + i));
+            __m256i c = op == K_ADD ? _mm256_add_epi32(a, b) : op == K_SUB ? _mm256_sub_epi32(a, b) : _mm256_mullo_epi32(a, b);
+
+            _mm256_storeu_si256((__m256i*) (z + i), c);
+        }
+    }
+
+    arith_scalar(op, x, y, z, i, n);
+}
+
+__attribute__((target("avx2")))
+static void arith_f32_avx2(kernel_op op, const float* x, const float* y, float* z, int32_t n){
+    int32_t i = 0;
+
+    for(; i + 8 <= n; i += 8){
+        __m256 a = _mm256_loadu_ps(x + i);
+        __m256 b = _mm256_loadu_ps(y + i);
+        __m256 c;
+
+        switch(op){
+            case K_ADD: c = _mm256_add_ps(a, b); break;
+            case K_SUB: c = _mm256_sub_ps(a, b); break;
+            case K_MUL: c = _mm256_mul_ps(a, b); break;
+            default: c = _mm256_div_ps(a, b);
+        }
+
+        _mm256_storeu_ps(z + i, c);
+    }
+
+    arith_scalar(op, x, y, z, i, n);
+}
+
+__attribute__((target("avx2")))
+static void neg_i32_avx2(const int32_t* x, int32_t* z, int32_t n){
+    int32_t i = 0;
+
+    for(; i + 8 <= n; i += 8){
+        __m256i a = _mm256_loadu_si256((const __m256i*) (x + i));
+        _mm256_storeu_si256((__m256i*) (z + i), _mm256_sub_epi32(_mm256_setzero_si256(), a));
+    }
+
+    neg_scalar(x, z, i, n);
+}
+
+__attribute__((target("avx2")))
+static void neg_f32_avx2(const float* x, float* z, int32_t n){
+    int32_t i = 0;
+    __m256 minus_one = _mm256_set1_ps(-1.0f);
+
+    for(; i + 8 <= n; i += 8){
+        _mm256_storeu_ps(z + i, _mm256_mul_ps(minus_one, _mm256_loadu_ps(x + i)));
+    }
+
+    neg_scalar(x, z, i, n);
+}
+
+// returns an 8-bit mask of the lane-wise comparison
+__attribute__((target("avx2")))
+static inline int cmp_i32_avx2(kernel_cmp cmp, __m256i a, __m256i b){
+    __m256i m;
+
+    switch(cmp){
+        case K_EQ: case K_NE: m = _mm256_cmpeq_epi32(a, b); break;
+        case K_LT: case K_GE: m = _mm256_cmpgt_epi32(b, a); break;
+        default: m = _mm256_cmpgt_epi32(a, b); // K_GT, K_LE
+    }
+
+    int mask = _mm256_movemask_ps(_mm256_castsi256_ps(m));
+    return cmp == K_NE || cmp == K_GE || cmp == K_LE ? mask ^ 0xFF : mask;
+}
+
+__attribute__((target("avx2")))
+static inline int cmp_f32_avx2(kernel_cmp cmp, __m256 a, __m256 b){
+    switch(cmp){
+        case K_EQ: return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+        case K_NE: return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ));
+        case K_LT: return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ));
+        case K_LE: return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ));
+        case K_GT: return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GT_OQ));
+        default: return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_GE_OQ));
+    }
+}
+
+__attribute__((target("avx2")))
+static void compare_i32_avx2(kernel_cmp cmp, const int32_t* x, const int32_t* y, uint64_t* z, int32_t n){
+    int32_t i = 0;
+
+    for(; i + 64 <= n; i += 64){ // each word packs the masks of 8 vectors
+        uint64_t word = 0;
+
+        for(int k = 0; k < 64; k += 8){
+            __m256i a = _mm256_loadu_si256((const __m256i*) (x + i + k));
+            __m256i b = _mm256_loadu_si256((const __m256i*) (y + i + k));
+            word |= (uint64_t) cmp_i32_avx2(cmp, a, b) << k;
+        }
+
+        z[i >> 6] = word;
+    }
+
+    compare_scalar(cmp, x, y, z, i, n);
+}
+
+__attribute__((target("avx2")))
+static void compare_f32_avx2(kernel_cmp cmp, const float* x, const float* y, uint64_t* z, int32_t n){
+    int32_t i = 0;
+
+    for(; i + 64 <= n; i += 64){
+        uint64_t word = 0;
+
+        for(int k = 0; k < 64; k += 8){
+            word |= (uint64_t) cmp_f32_avx2(cmp, _mm256_loadu_ps(x + i + k), _mm256_loadu_ps(y + i + k)) << k;
+        }
+
+        z[i >> 6] = word;
+    }
+
+    compare_scalar(cmp, x, y, z, i, n);
+}
+
+// bitwise operations on 4 words at a time (0: and, 1: or, 2: not)
+__attribute__((target("avx2")))
+static int32_t bits_avx2(int kind, const uint64_t* x, const uint64_t* y, uint64_t* z, int32_t n_words){
+    int32_t w = 0;
+
+    for(; w + 4 <= n_words; w += 4){
+        __m256i a = _mm256_loadu_si256((const __m256i*) (x + w));
+        __m256i c;
+
+        if(kind == 2){
+            c = _mm256_xor_si256(a, _mm256_set1_epi64x(-1));
+        }
+        else{
+            __m256i b = _mm256_loadu_si256((const __m256i*) (y + w));
+            c = kind == 0 ? _mm256_and_si256(a, b) : _mm256_or_si256(a, b);
+        }
+
+        _mm256_storeu_si256((__m256i*) (z + w), c);
+    }
+
+    return w; // index of the first word not processed
+}
+
+// ----- RUN-TIME DISPATCH -----
+
+static bool has_avx2(){
+    static const bool avx2 = [](){
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+
+    return avx2;
+}
+
+void arith_i32(kernel_op op, const int32_t* x, const int32_t* y, int32_t* z, int32_t n){
+    has_avx2() ? arith_i32_avx2(op, x, y, z, n) : arith_i32_sse2(op, x, y, z, n);
+}
+
+void arith_f32(kernel_op op, const float* x, const float* y, float* z, int32_t n){
+    has_avx2() ? arith_f32_avx2(op, x, y, z, n) : arith_f32_sse2(op, x, y, z, n);
+}
+
+void neg_i32(const int32_t* x, int32_t* z, int32_t n){
+    has_avx2() ? neg_i32_avx2(x, z, n) : neg_i32_sse2(x, z, n);
+}
+
+void neg_f32(const float* x, float* z, int32_t n){
+    has_avx2() ? neg_f32_avx2(x, z, n) : neg_f32_sse2(x, z, n);
+}
+
+void compare_i32(kernel_cmp cmp, const int32_t* x, const int32_t* y, uint64_t* z, int32_t n){
+    has_avx2() ? compare_i32_avx2(cmp, x, y, z, n) : compare_i32_sse2(cmp, x, y, z, n);
+}
+
+void compare_f32(kernel_cmp cmp, const float* x, const float* y, uint64_t* z, int32_t n){
+    has_avx2() ? compare_f32_avx2(cmp, x, y, z, n) : compare_f32_sse2(cmp, x, y, z, n);
+}
+
+// word-wise operations on bitsets are left to the compiler (which vectorises them using SSE2) if AVX2 is unsupported
+void bits_and(const uint64_t* x, const uint64_t* y, uint64_t* z, int32_t n_words){
+    for(int32_t w = has_avx2() ? bits_avx2(0, x, y, z, n_words) : 0; w < n_words; w++){ z[w] = x[w] & y[w];}
+}
+
+void bits_or(const uint64_t* x, const uint64_t* y, uint64_t* z, int32_t n_words){
+    for(int32_t w = has_avx2() ? bits_avx2(1, x, y, z, n_words) : 0; w < n_words; w++){ z[w] = x[w] | y[w];}
+}
+
+void bits_not(const uint64_t* x, uint64_t* z, int32_t n_words){
+    for(int32_t w = has_avx2() ? bits_avx2(2, x, nullptr, z, n_words) : 0; w < n_words; w++){ z[w] = ~x[w];}
+}
+
+#else
+
+// ----- SCALAR FALLBACK (non-x86 targets) -----
+
+void arith_i32(kernel_op op, const int32_t* x, const int32_t* y, int32_t* z, int32_t n){
+    arith_scalar(op, x, y, z, 0, n);
+}
+
+void arith_f32(kernel_op op, const float* x, const float* y, float* z, int32_t n){
+    arith_scalar(op, x, y, z, 0, n);
+}
+
+void neg_i32(const int32_t* x, int32_t* z, int32_t n){
+    neg_scalar(x, z, 0, n);
+}
+
+void neg_f32(const float* x, float* z, int32_t n){
+    neg_scalar(x, z, 0, n);
+}
+
+void compare_i32(kernel_cmp cmp, const int32_t* x, const int32_t* y, uint64_t* z, int32_t n){
+    compare_scalar(cmp, x, y, z, 0, n);
+}
+
+void compare_f32(kernel_cmp cmp, const float* x, const float* y, uint64_t* z, int32_t n){
+    compare_scalar(cmp, x, y, z, 0, n);
+}
+
+void bits_and(const uint64_t* x, const uint64_t* y, uint64_t* z, int32_t n_words){
+    for(int32_t w = 0; w < n_words; w++){ z[w] = x[w] & y[w];}
+}
+
+void bits_or(const uint64_t* x, const uint64_t* y, uint64_t* z, int32_t n_words){
+    for(int32_t w = 0; w < n_words; w++){ z[w] = x[w] | y[w];}
+}
+
+void bits_not(const uint64_t* x, uint64_t* z, int32_t n_words){
+    for(int32_t w = 0; w < n_words; w++){ z[w] = ~x[w];}
+}
+
+#endif
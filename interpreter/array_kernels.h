@@ -0,0 +1,48 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_ARRAY_KERNELS_H
+#define CPS2000_ARRAY_KERNELS_H
+
+#include <cstdint>
+
+/* Kernels carrying out element-wise operations on the typed buffers of arrays (see tl_array), used by the interpreter
+ * for array-valued expressions.
+ *
+ * On x86 targets, each kernel is implemented using SSE2 (which is always available on x86-64) and AVX2 intrinsics, with
+ * the implementation selected once at run-time based on the features supported by the processor. On other targets, a
+ * scalar implementation is used. In every case, the results are identical to applying the scalar operation element by
+ * element (in particular, negation is carried out as multiplication by -1, and comparisons involving NaN are false
+ * except for !=).
+ *
+ * Comparison results are packed into bitsets of 64-bit words, as held by bool arrays; any unused bits in the last word
+ * are left clear.
+ */
+
+enum kernel_op{
+    K_ADD, K_SUB, K_MUL, K_DIV
+};
+
+enum kernel_cmp{
+    K_EQ, K_NE, K_LT, K_LE, K_GT, K_GE
+};
+
+// z[i] = x[i] op y[i] for 0 <= i < n; the divisor must not contain 0 for K_DIV (integer division is not vectorised)
+void arith_i32(kernel_op op, const int32_t* x, const int32_t* y, int32_t* z, int32_t n);
+void arith_f32(kernel_op op, const float* x, const float* y, float* z, int32_t n);
+
+// z[i] = -1 * x[i] for 0 <= i < n
+void neg_i32(const int32_t* x, int32_t* z, int32_t n);
+void neg_f32(const float* x, float* z, int32_t n);
+
+// bit i of z is set to x[i] cmp y[i] for 0 <= i < n
+void compare_i32(kernel_cmp cmp, const int32_t* x, const int32_t* y, uint64_t* z, int32_t n);
+void compare_f32(kernel_cmp cmp, const float* x, const float* y, uint64_t* z, int32_t n);
+
+// word-wise logical operations on bitsets of n_words words (the caller clears unused bits following bits_not)
+void bits_and(const uint64_t* x, const uint64_t* y, uint64_t* z, int32_t n_words);
+void bits_or(const uint64_t* x, const uint64_t* y, uint64_t* z, int32_t n_words);
+void bits_not(const uint64_t* x, uint64_t* z, int32_t n_words);
+
+#endif //CPS2000_ARRAY_KERNELS_H
@@ -4,153 +4,279 @@
 
 #include "interpreter.h"
 
-void interpreter::visit(astTYPE* node){}
+#include <sys/resource.h>
+#include <atomic>
 
-void interpreter::visit(astLITERAL* node){
-    curr_obj_class = grammarDFA::SINGLETON; // literals are always singular values
-    curr_type = type_t(node->type, node->type_str); // extract current type from node
+interpreter::interpreter(size_t max_depth, output_sink* out, int n_threads){
+    this->max_depth = max_depth;
+    this->out = out;
+    this->n_threads = n_threads;
+
+    // the stacks of the threads executing parallel for loops are of the same size as that of the process, if limited
+    struct rlimit stack_size{};
+    if(getrlimit(RLIMIT_STACK, &stack_size) == 0 && stack_size.rlim_cur != RLIM_INFINITY &&
+       stack_size.rlim_cur > 2 * STACK_RESERVE){
+        stack_limit = native_stack_limit(stack_size.rlim_cur);
+        worker_stack_size = stack_size.rlim_cur;
+    }
+}
+
+// The native stack grows downwards from (approximately) the current frame of the calling thread, up to the stack size
+uintptr_t interpreter::native_stack_limit(size_t stack_size){
+    char base;
+    return (uintptr_t) &base - (stack_size - STACK_RESERVE);
+}
+
+// ----- FRAME UTILITY FUNCTIONS -----
+
+// Returns the frame reached by following the specified number of static links from the current frame
+interpreter::frame* interpreter::static_parent(int depth){
+    frame* ret_frame = curr_frame;
+
+    for(int i = 0; i < depth; i++){
+        ret_frame = ret_frame->parent;
+    }
+
+    return ret_frame;
+}
+
+// Creates a frame with the specified number of slots and static parent, allocating the slots from the top of the arena
+interpreter::frame* interpreter::push_frame(int size, frame* parent){
+    if(n_frames == frame_pool.size()){ frame_pool.push_back(new frame);}
+    frame* new_frame = frame_pool[n_frames++];
+
+    new_frame->size = size;
+    new_frame->parent = parent;
+    new_frame->block = curr_block;
+    new_frame->top = block_top;
+
+    // if the slots do not fit in the current block, move on to the next block (allocated or enlarged as need be)
+    if(slot_blocks.empty() || block_top + size > slot_blocks[curr_block].size()){
+        if(!slot_blocks.empty()){ curr_block++;}
+        block_top = 0;
 
-    // carry out case by case analysis of each type, type casting the lexeme associated with the node to the correct type
-    if(node->type == grammarDFA::T_BOOL){
-        if(node->lexeme == "true"){
-            curr_result = true;
+        if(curr_block == slot_blocks.size()){
+            slot_blocks.emplace_back(max(BLOCK_SLOTS, size));
         }
-        else{
-            curr_result = false;
+        else if(slot_blocks[curr_block].size() < (size_t) size){ // the block is free, since it is above the top
+            slot_blocks[curr_block] = vector<symbol>(size);
         }
     }
-    else if(node->type == grammarDFA::T_INT){
-        curr_result = stoi(node->lexeme);
+
+    new_frame->slots = slot_blocks[curr_block].data() + block_top;
+    block_top += size;
+
+    return new_frame;
+}
+
+// Reports a run-time error if a call (or tlstruct instantiation) would exceed the maximum depth or the native stack
+void interpreter::check_depth(unsigned int line){
+    char top;
+
+    if(depth_base + n_frames > max_depth){
+        report_error(line, "maximum call depth of " + to_string(max_depth) + " exceeded");
     }
-    else if(node->type == grammarDFA::T_FLOAT){
-        curr_result = stof(node->lexeme);
+    else if((uintptr_t) &top < stack_limit){
+        report_error(line, "call depth of " + to_string(depth_base + n_frames) + " exceeds the native stack of the "
+        "interpreter (run with -vm=1 for deeper recursion)");
     }
-    else if(node->type == grammarDFA::T_CHAR){
-        string literal_cpy = node->lexeme;
+}
 
-        // recall that character literals are written between apostrophes ''
-        // we begin by first removing the opening apostrophe
-        std::size_t opening_apost = literal_cpy.find_first_of('\'');
-        if(opening_apost != string::npos){
-            literal_cpy.erase(opening_apost, 1);
-        }
+/* Reports a run-time error, terminating the execution of the program. A worker instead throws the report, which is
+ * reported by the interpreter on whose behalf it executes iterations (see visit(astPAR_FOR)).
+ */
+void interpreter::report_error(unsigned int line, const string& message){
+    string report = "ln " + to_string(line) + ": " + message;
 
-        // and then remove the closing apostrophe
-        std::size_t closing_apost = literal_cpy.find_last_of('\'');
-        if(closing_apost != string::npos){
-            literal_cpy.erase(closing_apost, 1);
-        }
+    if(worker){
+        throw std::runtime_error(report);
+    }
 
-        // in the case the character is an escaped character, bind to the appropriate escaped character in C++ by checking
-        // the second character in the lexeme after apostrophe removal
-        if(literal_cpy[0] == '\\'){
-            if(literal_cpy[1] == '0'){
-                curr_result = '\0';
-            }
-            else if(literal_cpy[1] == '\\'){
-                curr_result = '\\';
-            }
-            else if(literal_cpy[1] == '\''){
-                curr_result = '\'';
-            }
-            else if(literal_cpy[1] == '"'){
-                curr_result = '\"';
-            }
-            else if(literal_cpy[1] == 'n'){
-                curr_result = '\n';
-            }
-            else if(literal_cpy[1] == 't'){
-                curr_result = '\t';
-            }
-            else if(literal_cpy[1] == 'r'){
-                curr_result = '\r';
-            }
-            else if(literal_cpy[1] == 'b'){
-                curr_result = '\b';
-            }
-            else if(literal_cpy[1] == 'f'){
-                curr_result = '\f';
-            }
-            else{
-                curr_result = '\v';
-            }
-        }
-        else{ // otherwise the input is a single character i.e. we can simply cast it to a char
-            curr_result = (char) literal_cpy[0];
+    std::cerr << report << std::endl;
+    throw std::runtime_error("Runtime errors encountered, see trace above.");
+}
+
+// Destroys the most recently created frame, releasing the values held by its slots and restoring the top of the arena
+void interpreter::pop_frame(){
+    frame* top_frame = frame_pool[--n_frames];
+
+    for(int i = 0; i < top_frame->size; i++){
+        top_frame->slots[i].set_object(value());
+    }
+
+    curr_block = top_frame->block;
+    block_top = top_frame->top;
+}
+
+/* Returns the symbol bound to an identifier referring to a variable, using the frame address set by the resolver. Members
+ * of tlstruct instances (depth -1) are instead held in the lookup instance, at the offset with which the identifier is
+ * annotated, after which the lookup instance is reset to the current instance.
+ */
+symbol* interpreter::resolve(astIDENTIFIER* identifier){
+    if(identifier->depth == -1){
+        tl_record* record = lookup_record;
+        lookup_record = curr_record;
+
+        return &(record->fields()[identifier->slot]);
+    }
+
+    return &(static_parent(identifier->depth)->slots[identifier->slot]);
+}
+
+// Binds a declared identifier to a symbol with the specified type and object class, returning the symbol
+symbol* interpreter::declare(astIDENTIFIER* identifier, type_t type, grammarDFA::Symbol object_class){
+    // members are bound to their offset in the tlstruct instance being constructed, and other identifiers to a slot in
+    // the current frame
+    symbol* slot = identifier->depth == -1 ? &(curr_record->fields()[identifier->slot]) :
+                   &(curr_frame->slots[identifier->slot]);
+    slot->type = type;
+    slot->object_class = object_class;
+
+    return slot;
+}
+
+// ----- FUSED ARRAY EXPRESSIONS -----
+
+// Utility function mapping a binary op to the corresponding operation of a fused array expression
+static array_expression::Op fused_op(const string& op){
+    if(op == "*"){ return array_expression::MUL;}
+    else if(op == "/"){ return array_expression::DIV;}
+    else if(op == "and"){ return array_expression::AND;}
+    else if(op == "+"){ return array_expression::ADD;}
+    else if(op == "-"){ return array_expression::SUB;}
+    else if(op == "or"){ return array_expression::OR;}
+    else if(op == "=="){ return array_expression::EQ;}
+    else if(op == "!="){ return array_expression::NE;}
+    else if(op == "<="){ return array_expression::LE;}
+    else if(op == ">="){ return array_expression::GE;}
+    else if(op == "<"){ return array_expression::LT;}
+    else{ return array_expression::GT;}
+}
+
+// Returns true if evaluating an expression may call a function (and hence assign to the elements of an array operand)
+static bool has_call(astNode* node){
+    if(node == nullptr || node->kind == astNode::T_TYPE || node->kind == astNode::LITERAL ||
+       node->kind == astNode::T_IDENTIFIER || node->kind == astNode::HOISTED){ // hoisted calls are pure, see loop_hoister
+        return false;
+    }
+    else if(node->kind == astNode::FUNC_CALL){
+        return true;
+    }
+
+    for(auto &c : ((astInnerNode*) node)->children){
+        if(has_call(c)){
+            return true;
         }
     }
+
+    return false;
+}
+
+/* Adds the subtree of an array-valued expression to the fused array expression, returning the index of its root node.
+ * Operators (and sub-expressions) are added as operations, whereas any other expression (i.e. a variable, member or
+ * function call yielding an array) is evaluated as usual and added as a leaf. Since the leaves are evaluated in the same
+ * order, and sizes are checked as each operation is added, side effects and run-time errors occur exactly as when
+ * evaluating (and allocating the result of) one operation at a time.
+ *
+ * The exceptions are the following, where an operand is evaluated (as a separate fused expression, unless a leaf) and
+ * added as a leaf instead:
+ * (i)  the divisor of a division, since it must be checked for 0 prior to dividing (once the sizes are checked),
+ * (ii) the left operand of an operation whose right operand calls a function, since the function may assign to the
+ *      elements of the arrays read by the left operand, the result of which must hence be computed beforehand.
+ */
+int interpreter::fuse(astNode* node, array_expression& expr){
+    if(auto* subexpr = dynamic_cast<astSUBEXPR*>(node)){
+        return fuse(subexpr->subexpr(), expr);
+    }
+
+    if(auto* unary_node = dynamic_cast<astUNARY*>(node)){
+        int operand = fuse(unary_node->operand(), expr);
+        return expr.unary(unary_node->op == "-" ? array_expression::NEG : array_expression::NOT, operand);
+    }
+
+    auto* binop_node = dynamic_cast<astBinaryOp*>(node);
+    if(binop_node == nullptr){ // otherwise the node is an array operand, which is evaluated as usual
+        node->accept(this);
+        return expr.leaf(curr_result.a);
+    }
+
+    int lhs;
+    if(has_call(binop_node->operand2())){
+        array_expression operand;
+        fuse(binop_node->operand1(), operand);
+
+        lhs = expr.leaf(operand.evaluate());
+    }
     else{
-        string literal_cpy = node->lexeme;
+        lhs = fuse(binop_node->operand1(), expr);
+    }
 
-        // recall that string literals are written between quotation marks ""
-        // begin by removing the opening quoatation marks
-        std::size_t opening_dquotes = literal_cpy.find_first_of('\"');
-        if(opening_dquotes != string::npos){
-            literal_cpy.erase(opening_dquotes, 1);
-        }
+    int rhs;
+    literal_arr_t divisor_arr = nullptr;
+
+    if(binop_node->op == "/"){
+        array_expression divisor;
+        fuse(binop_node->operand2(), divisor);
+
+        divisor_arr = divisor.evaluate();
+        rhs = expr.leaf(divisor_arr);
+    }
+    else{
+        rhs = fuse(binop_node->operand2(), expr);
+    }
+
+    if(expr.size(lhs) != expr.size(rhs)){ // if sizes do not match, report a run--time error
+        report_error(binop_node->line, "arrays have mismatched sizes " + to_string(expr.size(lhs)) + " and " +
+        to_string(expr.size(rhs)));
+    }
 
-        // and then the closing quoatation marks
-        std::size_t closing_dquotes = literal_cpy.find_last_of('\"');
-        if(closing_dquotes != string::npos){
-            literal_cpy.erase(closing_dquotes, 1);
+    if(divisor_arr != nullptr){
+        // report a division by zero if encountered in any element of the divisor
+        for(int32_t i = 0; i < divisor_arr->size; i++){
+            if(divisor_arr->elt_tag == value::INT ? divisor_arr->ints[i] == 0 : divisor_arr->floats[i] == 0){
+                report_error(binop_node->line, "division by zero encountered");
+            }
         }
+    }
 
-        curr_result = literal_cpy;
+    if(dynamic_cast<astRELOP*>(node) != nullptr){
+        curr_type = type_t(grammarDFA::T_BOOL, "bool"); // for relational operators, the resulting type is always a boolean
     }
+
+    return expr.binop(fused_op(binop_node->op), lhs, rhs);
+}
+
+// Evaluates an array-valued expression as a single fused array expression, setting the current result to the array
+void interpreter::evaluate_fused(astNode* node){
+    array_expression expr;
+    fuse(node, expr);
+
+    curr_result = expr.evaluate();
+    curr_obj_class = grammarDFA::ARRAY;
+}
+
+// ----- INTERPRETER VISITOR RULES -----
+
+void interpreter::visit(astTYPE* node){}
+
+void interpreter::visit(astLITERAL* node){
+    curr_obj_class = grammarDFA::SINGLETON; // literals are always singular values
+    curr_type = type_t(node->type, node->type_str); // extract current type from node
+    curr_result = node->constant; // decoded once by the constant_folder (strings are shared rather than copied)
 }
 
 // only called when the identifier refers to an operand standing for a variable, not for eg. a function  call
 // not called for assignment; only for value retrieval
 void interpreter::visit(astIDENTIFIER* node){
-    symbol* ret_symb = lookup_symbolTable->lookup(node->lexeme); // find symbol in symbol table with matching identifier
-    lookup_symbolTable = curr_symbolTable;
+    symbol* ret_symb = resolve(node); // find symbol bound to the identifier
 
     // extract the type and object class from the symbol
     curr_type = ret_symb->type;
     curr_obj_class = ret_symb->object_class;
 
-    // if the object class is ARRAY, simply fetch the literal_arr_t value from the variant tagged-union container
-    if(curr_obj_class == grammarDFA::ARRAY){
-        curr_result = get<literal_arr_t>(ret_symb->object);
-    }
-    else{ // else type is SINGLETON and hence we fetch the literal_t value from the variant tagged-union container
-        literal_t elt = get<literal_t>(ret_symb->object);
-
-        // carry out further case by case analysis and fetch the correct type from the variant tagged-union container
-        if(curr_type.first == grammarDFA::T_BOOL){
-            curr_result = get<bool>(elt);
-        }
-        else if(curr_type.first == grammarDFA::T_INT){
-            curr_result = get<int>(elt);
-        }
-        else if(curr_type.first == grammarDFA::T_FLOAT){
-            curr_result = get<float>(elt);
-        }
-        else if(curr_type.first == grammarDFA::T_CHAR){
-            curr_result = get<char>(elt);
-        }
-        else if(curr_type.first == grammarDFA::T_STRING){
-            string literal_cpy = get<string>(elt);
-
-            // recall that string literals are written between quotation marks ""
-            // begin by removing the opening quoatation marks
-            std::size_t opening_dquotes = literal_cpy.find_first_of('\"');
-            if(opening_dquotes != string::npos){
-                literal_cpy.erase(opening_dquotes, 1);
-            }
-
-            // and then the closing quoatation marks
-            std::size_t closing_dquotes = literal_cpy.find_last_of('\"');
-            if(closing_dquotes != string::npos){
-                literal_cpy.erase(closing_dquotes, 1);
-            }
-
-            curr_result = literal_cpy;
-        }
-        else{
-            curr_result = get<symbol_table*>(elt);
-        }
-    }
+    // copy the value held by the symbol (be it an unboxed primitive, or a shared string, array or tlstruct instance);
+    // strings are held without quotation marks, as decoded from the literal by the constant_folder
+    curr_result = ret_symb->object;
 }
 
 // only called when the identifier refers to an operand standing for an array element, not for eg. a function  call
@@ -158,215 +284,145 @@ void interpreter::visit(astIDENTIFIER* node){
 void interpreter::visit(astELEMENT* node){
     type_t ret_type = curr_type; // maintain current type
 
-    string arr_ident = ((astIDENTIFIER*) node->identifier)->lexeme; // extract the identifier of the array
-    symbol* ret_symb = lookup_symbolTable->lookup(arr_ident); // find the arrSymbol instance corresponding to the identifier
-    lookup_symbolTable = curr_symbolTable;
+    string arr_ident = ((astIDENTIFIER*) node->identifier())->lexeme; // extract the identifier of the array
+    symbol* ret_symb = resolve((astIDENTIFIER*) node->identifier()); // find the symbol bound to the identifier
 
     ret_type = ret_symb->type; // set ret_type to that of the returned symbol (i.e. of the array)
 
-    (node->index)->accept(this); // evaluate astEXPRESSION node corresponding to the index
-    int index = get<int>(get<literal_t>(curr_result)); // result is stored in the int container of literal_t
-    int size = ((arrSymbol*) ret_symb)->size; // maintain reference to size of the array as specified in its arrSymbol
+    (node->index())->accept(this); // evaluate astEXPRESSION node corresponding to the index
+    int index = curr_result.i; // result is stored in the int member of the value
+    int size = ret_symb->object.a->size; // maintain reference to size of the array
 
     // run--time bounds checking: check that 0 <= index < size; if not, report a run--time error and terminate immediately
     if(size <= index || index < 0){
-        std::cerr << "ln " << node->line << ": index " << index << " is out of bounds of array " << arr_ident <<
-        " with size " << size << std::endl;
-        throw std::runtime_error("Runtime errors encountered, see trace above.");
-    }
-
-    // otherwise fetch the literal_t held at the specified index of the arrSymbol's literal_arr_t container
-    literal_t elt = get<literal_arr_t>(ret_symb->object)->at(index);
-
-    // carry out case by case analysis and fetch the correct type from the variant tagged-union container
-    if(ret_type.first == grammarDFA::T_BOOL){
-        curr_result = get<bool>(elt);
+        report_error(node->line, "index " + to_string(index) + " is out of bounds of array " + arr_ident + " with size " +
+        to_string(size));
     }
-    else if(ret_type.first == grammarDFA::T_INT){
-        curr_result = get<int>(elt);
-    }
-    else if(ret_type.first == grammarDFA::T_FLOAT){
-        curr_result = get<float>(elt);
-    }
-    else if(ret_type.first == grammarDFA::T_CHAR){
-        curr_result = get<char>(elt);
-    }
-    else if(ret_type.first == grammarDFA::T_STRING){
-        string literal_cpy = get<string>(elt);
-
-        // recall that string literals are written between quotation marks ""
-        // begin by removing the opening quoatation marks
-        std::size_t opening_dquotes = literal_cpy.find_first_of('\"');
-        if(opening_dquotes != string::npos){
-            literal_cpy.erase(opening_dquotes, 1);
-        }
 
-        // and then the closing quoatation marks
-        std::size_t closing_dquotes = literal_cpy.find_last_of('\"');
-        if(closing_dquotes != string::npos){
-            literal_cpy.erase(closing_dquotes, 1);
-        }
-
-        curr_result = literal_cpy;
-    }
-    else{
-        curr_result = get<symbol_table*>(elt);
-    }
+    // otherwise fetch the value held at the specified index of the array
+    curr_result = ret_symb->object.a->get(index);
 
     curr_type = ret_type; // set current type to that of element i.e. of array
     curr_obj_class = grammarDFA::SINGLETON; // since we do not support multi-dim arrays, element is always SINGLETON
 }
 
-/* Utility function which given a multiplicative op and two literal_t instances, finds the corresponding literal_t
- * based on applying the op on the literal_t instances.
+/* Utility function which given a multiplicative op and two values, finds the corresponding value based on applying the
+ * op on the values.
  */
-literal_t interpreter::multop(string op, int line, literal_t lit1, literal_t lit2){
-    literal_t result; // resulting literal_t
+value interpreter::multop(const string& op, int line, const value& lit1, const value& lit2){
+    value result; // resulting value
 
     if(op == "*"){ // in the case of multiplication
-        // if integer types, multiply the two int values in the literal_t containers
+        // if integer types, multiply the two int values
         if(curr_type.first == grammarDFA::T_INT){
-            result = get<int>(lit1) * get<int>(lit2);
+            result = lit1.i * lit2.i;
         }
         else{ // else the only other valid type is float;
-            // multiply the two float values in the literal_t containers
-            result = get<float>(lit1) * get<float>(lit2);
+            // multiply the two float values
+            result = lit1.f * lit2.f;
         }
     }
     else if(op == "/"){ // else in the case of division
         if(curr_type.first == grammarDFA::T_INT){
             // if 2nd operand is 0, report divide by 0 runtime error and terminate
-            if(get<int>(lit2) == 0){
-                std::cerr << "ln " << line << ": division by zero encountered" << std::endl;
-                throw std::runtime_error("Runtime errors encountered, see trace above.");
+            if(lit2.i == 0){
+                report_error(line, "division by zero encountered");
             }
 
-            // divide the two int values in the literal_t containers
-            result = get<int>(lit1) / get<int>(lit2);
+            // divide the two int values
+            result = lit1.i / lit2.i;
         }
         else{
             // if 2nd operand is 0, report divide by 0 runtime error and terminate
-            if(get<float>(lit2) == 0){
-                std::cerr << "ln " << line << ": division by zero encountered" << std::endl;
-                throw std::runtime_error("Runtime errors encountered, see trace above.");
+            if(lit2.f == 0){
+                report_error(line, "division by zero encountered");
             }
 
-            // divide the two float values in the literal_t containers
-            result = get<float>(lit1) / get<float>(lit2);
+            // divide the two float values
+            result = lit1.f / lit2.f;
         }
     }
-    else{ // otherwise op is logical AND; fetch the bool values in the literat_t containers and apply logical AND
-        result = get<bool>(lit1) && get<bool>(lit2);
+    else{ // otherwise op is logical AND; apply logical AND on the bool values
+        result = lit1.b && lit2.b;
     }
 
     return result;
 }
 
 void interpreter::visit(astMULTOP* node){
-    node->operand1->accept(this); // visit astEXPRESSION node corresponding to first operand
-    obj_t op1_value = curr_result; // maintain result for op1
-
-    node->operand2->accept(this); // visit astEXPRESSION node corresponding to second operand
-    obj_t op2_value = curr_result; // maintain result for op2
-
-    if(curr_obj_class == grammarDFA::ARRAY){ // in the case of array, carry out overloaded element-wise multop
-        literal_arr_t arr1 = get<literal_arr_t>(op1_value); // hold reference to first array operand
-        int size1 = arr1->size(); // hold reference to size of first array operand
-
-        literal_arr_t arr2 = get<literal_arr_t>(op2_value); // hold reference to second array operand
-        int size2 = arr2->size(); // hold reference to size of second array operand
+    if(node->object_class == grammarDFA::ARRAY){ // array-valued expressions are evaluated fused, see fuse
+        evaluate_fused(node);
+        return;
+    }
 
-        if(size1 != size2){ // if sizes do not match, report a run--time error
-            std::cerr << "ln " << node->line << ": arrays have mismatched sizes " << size1 << " and " << size2 << std::endl;
-            throw std::runtime_error("Runtime errors encountered, see trace above.");
-        }
+    node->operand1()->accept(this); // visit astEXPRESSION node corresponding to first operand
+    value op1_value = curr_result; // maintain result for op1
 
-        auto* result = new vector<literal_t>(0);
-        for(int i = 0; i < size1; i++){ // call multop on each pair of elements
-            result->push_back(multop(node->op, node->line, arr1->at(i), arr2->at(i)));
-        }
+    node->operand2()->accept(this); // visit astEXPRESSION node corresponding to second operand
+    value op2_value = curr_result; // maintain result for op2
 
-        curr_result = result;
-    }else{ // else if single element, simply apply multop on the two operands
-        curr_result = multop(node->op, node->line, get<literal_t>(op1_value), get<literal_t>(op2_value));
-    }
+    curr_result = multop(node->op, node->line, op1_value, op2_value); // apply multop on the two operands
 }
 
 
-/* Utility function which given a additive op and two literal_t instances, finds the corresponding literal_t
- * based on applying the op on the literal_t instances.
+/* Utility function which given a additive op and two values, finds the corresponding value based on applying the op on
+ * the values.
  */
-literal_t interpreter::addop(string op, literal_t lit1, literal_t lit2){
-    literal_t result; // resulting literal_t
+value interpreter::addop(const string& op, const value& lit1, const value& lit2){
+    value result; // resulting value
 
     if(op == "+"){ // in the case of addition, apply case by case analysis and fetch the correct type from the variant tagged-union containers
         if(curr_type.first == grammarDFA::T_INT){
-            result = get<int>(lit1) + get<int>(lit2);
+            result = lit1.i + lit2.i;
         }
         else if(curr_type.first == grammarDFA::T_FLOAT){
-            result = get<float>(lit1) + get<float>(lit2);
+            result = lit1.f + lit2.f;
         }
         else if(curr_type.first == grammarDFA::T_CHAR){
-            result = (char) (get<char>(lit1) + get<char>(lit2));
+            result = (char) (lit1.c + lit2.c);
         }
         else{
-            result = get<string>(lit1) + get<string>(lit2);
+            result = lit1.str() + lit2.str();
         }
     }
     else if(op == "-"){ // else in the case of subtraction, proceed similarly
         if(curr_type.first == grammarDFA::T_INT){
-            result = get<int>(lit1) - get<int>(lit2);
+            result = lit1.i - lit2.i;
         }
         else if(curr_type.first == grammarDFA::T_FLOAT){
-            result = get<float>(lit1) - get<float>(lit2);
+            result = lit1.f - lit2.f;
         }
         else{
-            result = (char) (get<char>(lit1) - get<char>(lit2));
+            result = (char) (lit1.c - lit2.c);
         }
     }
     else{ // otherwise if logical OR, fetch the boolean types from the variant tagged-union containers and apply logical OR
-        result = get<bool>(lit1) || get<bool>(lit2);
+        result = lit1.b || lit2.b;
     }
 
     return result;
 }
 
 void interpreter::visit(astADDOP* node){
-    node->operand1->accept(this); // visit astEXPRESSION node corresponding to first operand
-    obj_t op1_value = curr_result; // maintain result for op1
-
-    node->operand2->accept(this); // visit astEXPRESSION node corresponding to second operand
-    obj_t op2_value = curr_result; // maintain result for op2
-
-    if(curr_obj_class == grammarDFA::ARRAY){ // in the case of array, carry out overloaded element-wise addop
-        literal_arr_t arr1 = get<literal_arr_t>(op1_value); // hold reference to first array operand
-        int size1 = arr1->size(); // hold reference to size of first array operand
-
-        literal_arr_t arr2 = get<literal_arr_t>(op2_value); // hold reference to second array operand
-        int size2 = arr2->size(); // hold reference to size of second array operand
+    if(node->object_class == grammarDFA::ARRAY){ // array-valued expressions are evaluated fused, see fuse
+        evaluate_fused(node);
+        return;
+    }
 
-        if(size1 != size2){ // if sizes do not match, report a run--time error
-            std::cerr << "ln " << node->line << ": arrays have mismatched sizes " << size1 << " and " << size2 << std::endl;
-            throw std::runtime_error("Runtime errors encountered, see trace above.");
-        }
+    node->operand1()->accept(this); // visit astEXPRESSION node corresponding to first operand
+    value op1_value = curr_result; // maintain result for op1
 
-        auto* result = new vector<literal_t>(0);
-        for(int i = 0; i < size1; i++){ // call addop on each pair of elements
-            result->push_back(addop(node->op, arr1->at(i), arr2->at(i)));
-        }
+    node->operand2()->accept(this); // visit astEXPRESSION node corresponding to second operand
+    value op2_value = curr_result; // maintain result for op2
 
-        curr_result = result;
-    }
-    else{ // else if single element, simply apply addop on the two operands
-        curr_result = addop(node->op, get<literal_t>(op1_value), get<literal_t>(op2_value));
-    }
+    curr_result = addop(node->op, op1_value, op2_value); // apply addop on the two operands
 }
 
-/* Utility function which given a additive op and two literal_t instances, finds the corresponding literal_t
- * based on applying the op on the literal_t instances.
+/* Utility function which given a relational op and two values, finds the corresponding value based on applying the op
+ * on the values.
  */
-literal_t interpreter::relop(string op, literal_t lit1, literal_t lit2){
-    literal_t result; // resulting literal_t
+value interpreter::relop(const string& op, const value& lit1, const value& lit2){
+    value result; // resulting value
 
     /* Apply case by case analysis based on:
      * (i) relational operator
@@ -377,104 +433,104 @@ literal_t interpreter::relop(string op, literal_t lit1, literal_t lit2){
 
     if(op == "=="){
         if(curr_type.first == grammarDFA::T_BOOL){
-            result = get<bool>(lit1) == get<bool>(lit2);
+            result = lit1.b == lit2.b;
         }
         else if(curr_type.first == grammarDFA::T_INT){
-            result = get<int>(lit1) == get<int>(lit2);
+            result = lit1.i == lit2.i;
         }
         else if(curr_type.first == grammarDFA::T_FLOAT){
-            result = get<float>(lit1) == get<float>(lit2);
+            result = lit1.f == lit2.f;
         }
         else if(curr_type.first == grammarDFA::T_CHAR){
-            result = get<char>(lit1) == get<char>(lit2);
+            result = lit1.c == lit2.c;
         }
         else{
-            result = get<string>(lit1) == get<string>(lit2);
+            result = lit1.str_equals(lit2);
         }
     }
     else if(op == "!="){
         if(curr_type.first == grammarDFA::T_BOOL){
-            result = get<bool>(lit1) != get<bool>(lit2);
+            result = lit1.b != lit2.b;
         }
         else if(curr_type.first == grammarDFA::T_INT){
-            result = get<int>(lit1) != get<int>(lit2);
+            result = lit1.i != lit2.i;
         }
         else if(curr_type.first == grammarDFA::T_FLOAT){
-            result = get<float>(lit1) != get<float>(lit2);
+            result = lit1.f != lit2.f;
         }
         else if(curr_type.first == grammarDFA::T_CHAR){
-            result = get<char>(lit1) != get<char>(lit2);
+            result = lit1.c != lit2.c;
         }
         else{
-            result = get<string>(lit1) != get<string>(lit2);
+            result = !lit1.str_equals(lit2);
         }
     }
     else if(op == "<="){
         if(curr_type.first == grammarDFA::T_BOOL){
-            result = get<bool>(lit1) <= get<bool>(lit2);
+            result = lit1.b <= lit2.b;
         }
         else if(curr_type.first == grammarDFA::T_INT){
-            result = get<int>(lit1) <= get<int>(lit2);
+            result = lit1.i <= lit2.i;
         }
         else if(curr_type.first == grammarDFA::T_FLOAT){
-            result = get<float>(lit1) <= get<float>(lit2);
+            result = lit1.f <= lit2.f;
         }
         else if(curr_type.first == grammarDFA::T_CHAR){
-            result = get<char>(lit1) <= get<char>(lit2);
+            result = lit1.c <= lit2.c;
         }
         else{
-            result = get<string>(lit1) <= get<string>(lit2);
+            result = lit1.str() <= lit2.str();
         }
     }
     else if(op == ">="){
         if(curr_type.first == grammarDFA::T_BOOL){
-            result = get<bool>(lit1) >= get<bool>(lit2);
+            result = lit1.b >= lit2.b;
         }
         else if(curr_type.first == grammarDFA::T_INT){
-            result = get<int>(lit1) >= get<int>(lit2);
+            result = lit1.i >= lit2.i;
         }
         else if(curr_type.first == grammarDFA::T_FLOAT){
-            result = get<float>(lit1) >= get<float>(lit2);
+            result = lit1.f >= lit2.f;
         }
         else if(curr_type.first == grammarDFA::T_CHAR){
-            result = get<char>(lit1) >= get<char>(lit2);
+            result = lit1.c >= lit2.c;
         }
         else{
-            result = get<string>(lit1) >= get<string>(lit2);
+            result = lit1.str() >= lit2.str();
         }
     }
     else if(op == "<"){
         if(curr_type.first == grammarDFA::T_BOOL){
-            result = get<bool>(lit1) < get<bool>(lit2);
+            result = lit1.b < lit2.b;
         }
         else if(curr_type.first == grammarDFA::T_INT){
-            result = get<int>(lit1) < get<int>(lit2);
+            result = lit1.i < lit2.i;
         }
         else if(curr_type.first == grammarDFA::T_FLOAT){
-            result = get<float>(lit1) < get<float>(lit2);
+            result = lit1.f < lit2.f;
         }
         else if(curr_type.first == grammarDFA::T_CHAR){
-            result = get<char>(lit1) < get<char>(lit2);
+            result = lit1.c < lit2.c;
         }
         else{
-            result = get<string>(lit1) < get<string>(lit2);
+            result = lit1.str() < lit2.str();
         }
     }
     else{
         if(curr_type.first == grammarDFA::T_BOOL){
-            result = get<bool>(lit1) > get<bool>(lit2);
+            result = lit1.b > lit2.b;
         }
         else if(curr_type.first == grammarDFA::T_INT){
-            result = get<int>(lit1) > get<int>(lit2);
+            result = lit1.i > lit2.i;
         }
         else if(curr_type.first == grammarDFA::T_FLOAT){
-            result = get<float>(lit1) > get<float>(lit2);
+            result = lit1.f > lit2.f;
         }
         else if(curr_type.first == grammarDFA::T_CHAR){
-            result = get<char>(lit1) > get<char>(lit2);
+            result = lit1.c > lit2.c;
         }
         else{
-            result = get<string>(lit1) > get<string>(lit2);
+            result = lit1.str() > lit2.str();
         }
     }
 
@@ -482,34 +538,18 @@ literal_t interpreter::relop(string op, literal_t lit1, literal_t lit2){
 }
 
 void interpreter::visit(astRELOP* node){
-    node->operand1->accept(this); // visit astEXPRESSION node corresponding to first operand
-    obj_t op1_value = curr_result; // maintain result for op1
-
-    node->operand2->accept(this); // visit astEXPRESSION node corresponding to second operand
-    obj_t op2_value = curr_result; // maintain result for op2
-
-    if(curr_obj_class == grammarDFA::ARRAY){ // in the case of array, carry out overloaded element-wise relop
-        literal_arr_t arr1 = get<literal_arr_t>(op1_value); // hold reference to first array operand
-        int size1 = arr1->size(); // hold reference to size of first array operand
-
-        literal_arr_t arr2 = get<literal_arr_t>(op2_value); // hold reference to second array operand
-        int size2 = arr2->size(); // hold reference to size of second array operand
+    if(node->object_class == grammarDFA::ARRAY){ // array-valued expressions are evaluated fused, see fuse
+        evaluate_fused(node);
+        return;
+    }
 
-        if(size1 != size2){ // if sizes do not match, report a run--time error
-            std::cerr << "ln " << node->line << ": arrays have mismatched sizes " << size1 << " and " << size2 << std::endl;
-            throw std::runtime_error("Runtime errors encountered, see trace above.");
-        }
+    node->operand1()->accept(this); // visit astEXPRESSION node corresponding to first operand
+    value op1_value = curr_result; // maintain result for op1
 
-        auto* result = new vector<literal_t>(0);
-        for(int i = 0; i < size1; i++){ // call relop on each pair of elements
-            result->push_back(relop(node->op, arr1->at(i), arr2->at(i)));
-        }
+    node->operand2()->accept(this); // visit astEXPRESSION node corresponding to second operand
+    value op2_value = curr_result; // maintain result for op2
 
-        curr_result = result;
-    }
-    else{ // else if single element, simply apply addop on the two operands
-        curr_result = relop(node->op, get<literal_t>(op1_value), get<literal_t>(op2_value));
-    }
+    curr_result = relop(node->op, op1_value, op2_value); // apply relop on the two operands
 
     curr_type = type_t(grammarDFA::T_BOOL, "bool"); // for relational operators, the resulting type is always a boolean
 }
@@ -517,81 +557,54 @@ void interpreter::visit(astRELOP* node){
 void interpreter::visit(astAPARAMS* node){
     // for each specified param
     for(size_t i = 0; i < node->n_children; i++){
-        (node->children->at(i))->accept(this); // visit astEXPRESSION node
-        symbol* aparam;
-
-        if(curr_obj_class == grammarDFA::SINGLETON){ // if singlular item, create new varSymbol to maintain result
-            aparam = new varSymbol(nullptr, curr_type);
-            aparam->set_object(curr_result);
-        }
-        else{ // else create new arrSymbol to maintain result (as must be array otherwise)
-            aparam = new arrSymbol(nullptr, curr_type, get<literal_arr_t>(curr_result)->size());
-            aparam->set_object(curr_result);
-        }
-
-        (functionStack->top().first)->fparams->push_back(aparam); // push symbol instance to fparams vector of funcSymbol at the stop of the functionStack
+        (node->children.at(i))->accept(this); // visit astEXPRESSION node
+        curr_aparams[i].set_object(curr_result); // and bind the resulting right-value to the slot of the parameter
     }
 }
 
 void interpreter::visit(astFUNC_CALL* node){
-    // extract function identifier from astIDENTIFIER node
-    string func_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
-    auto* expected_func = new funcSymbol(&func_ident, type_t(grammarDFA::T_TYPE, ""), grammarDFA::FUNCTION, new vector<symbol*>(0));
+    funcSymbol* func = node->callee; // function bound to the call during semantic analysis
 
-    // in case function being called is a member of a tlstruct instance
-    symbol_table* ref_tmp_symbolTable = lookup_symbolTable; // maintain reference of lookup symbol table
-    lookup_symbolTable = curr_symbolTable; // set lookup symbol table to current symbol table
+    // in case function being called is a member of a tlstruct instance, the lookup instance is that instance
+    tl_record* call_record = lookup_record;
+    lookup_record = curr_record; // reset lookup instance for evaluating the parameters
 
-    if(node->aparams != nullptr){ // if we have at least 1 parameter...
-        functionStack->push(make_pair(expected_func, false)); // push on top of function stack
-        node->aparams->accept(this); // visit astAPARAMS node to type check the parameters and build the function type-signature
-        functionStack->pop(); // pop expected_func with generated type signature from function stack
-    }
+    /* Binding formal parameters to evaluated right values:
+     * A new frame is created for the call, linked to the frame in which the function is declared. The formal parameters
+     * occupy the first slots of the frame (in order), and hence the actual parameters are evaluated directly into the
+     * slots; for each formal parameter in the funcSymbol, we then set the type and object class of the corresponding slot.
+     */
+    check_depth(node->line);
+    frame* func_frame = push_frame(func->func_ref->frame_size, static_parent(node->depth));
 
-    // revert back lookup and insertion symbol tables...
-    lookup_symbolTable = ref_tmp_symbolTable;
-    ref_tmp_symbolTable = curr_symbolTable;
-    curr_symbolTable = lookup_symbolTable;
+    symbol* ref_aparams = curr_aparams;
+    curr_aparams = func_frame->slots;
 
-    // lookup in symbol table based on fetched identifier and type-signature constructed from visiting astAPARAMS
-    // and then push returned funcSymbol onto the function stack...
-    functionStack->push(make_pair(curr_symbolTable->lookup(func_ident, expected_func->fparams), false));
+    if(node->aparams() != nullptr){ // if we have at least 1 parameter...
+        node->aparams()->accept(this); // visit astAPARAMS node to evaluate the parameters
+    }
 
-    // maintain scoping: new scope for the function definition block
-    curr_symbolTable->push_scope();
+    curr_aparams = ref_aparams;
 
-    /* Binding formal parameters to evaluted right values:
-     * For each fparam in the funcSymbol instance at the top of the function stack, there is a corresponding aparam in
-     * the expected_func funcSymbol, which in particular has the right-value resulting from the evaluation of the corresponding
-     * astEXPRESSION node.
-     *
-     * Hence for each pair of fparam and aparam, we create a new varSymbol or arrSymbol instance (depending on the object
-     * class), with the left value from the fparam and the right value from the aparam. We then push these symbols in
-     * the symbol table, i.e. the identifiers defined in the function signature are within the function scope, and bound
-     * to the right-values positionally specified in the function call.
-     */
-    for(size_t i = 0; i < (functionStack->top().first)->fparams->size(); i++){
-        symbol* aparam;
-        grammarDFA::Symbol obj_class = (functionStack->top().first)->fparams->at(i)->object_class;
+    for(size_t i = 0; i < func->fparams->size(); i++){
+        symbol* fparam = &(func_frame->slots[i]);
 
-        if(obj_class == grammarDFA::SINGLETON){
-            aparam = new varSymbol(&(functionStack->top().first)->fparams->at(i)->identifier,
-                                   (functionStack->top().first)->fparams->at(i)->type);
-        }
-        else{
-            aparam = new arrSymbol(&(functionStack->top().first)->fparams->at(i)->identifier,
-                                   (functionStack->top().first)->fparams->at(i)->type,
-                                   ((arrSymbol*) expected_func->fparams->at(i))->size);
-        }
-
-        aparam->set_object(expected_func->fparams->at(i)->object);
-        curr_symbolTable->insert(aparam);
+        fparam->type = func->fparams->at(i)->type;
+        fparam->object_class = func->fparams->at(i)->object_class;
     }
 
-    delete expected_func; // expected_func no longer required; free associated memory
+    // maintain references to the calling frame and instance
+    frame* ref_frame = curr_frame;
+    tl_record* ref_record = curr_record;
+
+    curr_frame = func_frame;
+    curr_record = call_record;
+    lookup_record = curr_record;
+
+    functionStack->push(make_pair(func, false)); // push funcSymbol onto the function stack
 
     // for each child node (i.e. statement) in the astBLOCK associated with the function definition
-    for(auto &c : *(functionStack->top().first)->func_ref->children){
+    for(auto &c : func->func_ref->children){
         c->accept(this); // visit the node
 
         if(functionStack->top().second){ // if a return statement is encountered, stop traversing astBLOCK subtree
@@ -599,72 +612,100 @@ void interpreter::visit(astFUNC_CALL* node){
         }
     }
 
-    // set type and object class to that of the function return
-    curr_type = (functionStack->top().first)->type;
-    curr_obj_class = (functionStack->top().first)->ret_obj_class;
-
-    // and set the result associated with the function to curr_result (the value set by astRETURN)
-    (functionStack->top().first)->set_object(curr_result);
+    // set type and object class to that of the function return (curr_result holds the value set by astRETURN)
+    curr_type = func->type;
+    curr_obj_class = func->ret_obj_class;
 
     functionStack->pop(); // remove funcSymbol from top of the function stack
-    curr_symbolTable->pop_scope(); // maintain scoping: pop scope associated with the function
+    pop_frame(); // the frame of the call is no longer required
 
-    // set both symbol table references to the 'calling' symbol table
-    curr_symbolTable = ref_tmp_symbolTable;
-    lookup_symbolTable = curr_symbolTable;
+    // restore the calling frame and instance references
+    curr_frame = ref_frame;
+    curr_record = ref_record;
+    lookup_record = curr_record;
 }
 
 void interpreter::visit(astSUBEXPR* node){
-    node->subexpr->accept(this); // visit astEXPRESSION node
+    node->subexpr()->accept(this); // visit astEXPRESSION node
 }
 
-/* Utility function which given a unary op and a literal_t instance, finds the corresponding literal_t
- * based on applying the op on the literal_t instance.
+/* Utility function which given a unary op and a value, finds the corresponding value based on applying the op on the
+ * value.
  */
-literal_t interpreter::unary(string op, literal_t literal){
-    literal_t result; // resulting literal_t
+value interpreter::unary(const string& op, const value& literal){
+    value result; // resulting value
 
     if(op == "-"){ // in the case op is minus
         if(curr_type.first == grammarDFA::T_INT){ // and type is int, get int instance from variant and multiply by -1
-            result = -1 * get<int>(literal);
+            result = -1 * literal.i;
         }
         else if(curr_type.first == grammarDFA::T_FLOAT){ // else if float, get float instance from variant and multiply by -1
-            result =  -1 * get<float>(literal);
+            result =  -1 * literal.f;
         }
     }
     else{ // otherwise op is logical NOT
-        result = !get<bool>(literal);
+        result = !literal.b;
     }
 
     return result;
 }
 
 void interpreter::visit(astUNARY* node){
-    node->operand->accept(this); // visit astEXPRESSION node corresponding to operand
-    obj_t op1_value = curr_result; // maintain result for op1
+    if(node->object_class == grammarDFA::ARRAY){ // array-valued expressions are evaluated fused, see fuse
+        evaluate_fused(node);
+        return;
+    }
 
-    if(curr_obj_class == grammarDFA::ARRAY){ // in the case of array, carry out overloaded element-wise unary op
-        literal_arr_t arr1 = get<literal_arr_t>(op1_value); // hold reference to array operand
-        int size1 = arr1->size(); // maintain reference to size of array
+    node->operand()->accept(this); // visit astEXPRESSION node corresponding to operand
+    curr_result = unary(node->op, curr_result); // apply unary op and store result in curr_result
+}
 
-        auto* result = new vector<literal_t>(0);
-        for(int i = 0; i < size1; i++){ // for each element in the array, apply the unary operation and store result
-            result->push_back(unary(node->op, arr1->at(i)));
-        }
+/* Carries out an assignment of the form s = s + e, appending to the string held by the variable s: if the string is held
+ * by no other value (and is not interned), it is extended in place, and otherwise replaced by the concatenation (which is
+ * then held only by s, such that later appends extend it in place). Since strings grow geometrically, repeated appends to
+ * a variable hence take amortised constant time per character appended, rather than copying the string upon each append.
+ * Returns false (having evaluated nothing) if the assignment is not an append to a string variable.
+ */
+bool interpreter::append_string(symbol* target, astNode* expression){
+    if(target->type.first != grammarDFA::T_STRING || target->object_class != grammarDFA::SINGLETON ||
+       expression->kind != astNode::ADDOP){
+        return false;
+    }
 
-        curr_result = result;
+    auto* addop = (astADDOP*) expression;
+    if(addop->operand1()->kind != astNode::T_IDENTIFIER || resolve((astIDENTIFIER*) addop->operand1()) != target){
+        return false;
     }
-    else{ // otherwise operand is a singular item i.e. SINGLETON
-        curr_result = unary(node->op, get<literal_t>(op1_value)); // apply unary op and store result in curr_result
+
+    // the string held by the variable is held while evaluating the suffix, in case the suffix assigns the variable
+    value prefix = target->object;
+    addop->operand2()->accept(this);
+
+    tl_string* str = prefix.s;
+    if(target->object.s == str && str->refs == 2 && !str->interned){ // i.e. held only by the variable and the prefix
+        prefix = value();
+        str->str += curr_result.str();
+    }
+    else{
+        target->set_object(prefix.str() + curr_result.str());
     }
+
+    curr_type = target->type;
+    curr_obj_class = grammarDFA::SINGLETON;
+
+    return true;
 }
 
 void interpreter::visit(astASSIGNMENT_IDENTIFIER* node){
-    // get symbol corresponding to identifier from symbol table
-    symbol* ret_symb = lookup_symbolTable->lookup(((astIDENTIFIER*) node->identifier)->lexeme);
-    lookup_symbolTable = curr_symbolTable; // reset symbol table references
+    // get symbol bound to the identifier
+    symbol* ret_symb = resolve((astIDENTIFIER*) node->identifier());
+
+    // appending to a string variable (s = s + e) extends the string in place where possible, see append_string
+    if(append_string(ret_symb, node->expression())){
+        return;
+    }
 
-    node->expression->accept(this); // visit astEXPRESSION node (result of which will be the right-value)
+    node->expression()->accept(this); // visit astEXPRESSION node (result of which will be the right-value)
 
     // if type associated with returned symbol is anonymous, set to type of astEXPRESSION result
     if(ret_symb->type.first == grammarDFA::T_AUTO){
@@ -673,10 +714,10 @@ void interpreter::visit(astASSIGNMENT_IDENTIFIER* node){
 
     // if symbol corresponding to identifier is an array, and size of this array and the resulting array do not match
     // then report an appropriate run-time error
-    if(curr_obj_class == grammarDFA::ARRAY && get<literal_arr_t>(curr_result)->size() != ((arrSymbol*) ret_symb)->size){
-        std::cerr << "ln " << node->line << ": arrays have mismatched sizes " << get<literal_arr_t>(curr_result)->size()
-        << " and " << ((arrSymbol*) ret_symb)->size << std::endl;
-        throw std::runtime_error("Runtime errors encountered, see trace above.");
+    if(curr_obj_class == grammarDFA::ARRAY &&
+       curr_result.a->size != ret_symb->object.a->size){
+        report_error(node->line, "arrays have mismatched sizes " + to_string(curr_result.a->size) + " and " +
+        to_string(ret_symb->object.a->size));
     }
 
     ret_symb->set_object(curr_result); // set right value of found symbol to evaluated value of the astEXPRESSION
@@ -684,25 +725,23 @@ void interpreter::visit(astASSIGNMENT_IDENTIFIER* node){
 
 void interpreter::visit(astASSIGNMENT_ELEMENT* node){
     // maintain reference to array identifier
-    string arr_ident = ((astIDENTIFIER*) ((astELEMENT*) node->element)->identifier)->lexeme;
+    string arr_ident = ((astIDENTIFIER*) ((astELEMENT*) node->element())->identifier())->lexeme;
 
-    // get symbol corresponding to array identifier from lookup symbol table
-    symbol* ret_symb = lookup_symbolTable->lookup(arr_ident);
-    lookup_symbolTable = curr_symbolTable; // reset symbol table references
+    // get symbol bound to the array identifier
+    symbol* ret_symb = resolve((astIDENTIFIER*) ((astELEMENT*) node->element())->identifier());
 
-    (((astELEMENT*) node->element)->index)->accept(this); // evaluate astEXPRESSION, the result of which will be the index
+    (((astELEMENT*) node->element())->index())->accept(this); // evaluate astEXPRESSION, the result of which will be the index
     // maintain reference to the index by accessing the int held in the curr_result variant tagged-uniom
-    int index = get<int>(get<literal_t>(curr_result));
-    int size = ((arrSymbol*) ret_symb)->size; // maintain reference to size of the array
+    int index = curr_result.i;
+    int size = ret_symb->object.a->size; // maintain reference to size of the array
 
     // carry out bounds checking; index must be non-negative and less then size; report a run-time error otherwise and terminate
     if(size <= index || index < 0){
-        std::cerr << "ln " << node->line << ": index " << index << " is out of bounds of array " << arr_ident <<
-        " with size " << size << std::endl;
-        throw std::runtime_error("Runtime errors encountered, see trace above.");
+        report_error(node->line, "index " + to_string(index) + " is out of bounds of array " + arr_ident + " with size " +
+        to_string(size));
     }
 
-    node->expression->accept(this); // visit astEXPRESSION node (result of which will be the right-value)
+    node->expression()->accept(this); // visit astEXPRESSION node (result of which will be the right-value)
 
     // if type associated with returned symbol is anonymous, set to type of astEXPRESSION result
     if(ret_symb->type.first == grammarDFA::T_AUTO){
@@ -710,226 +749,215 @@ void interpreter::visit(astASSIGNMENT_ELEMENT* node){
     }
 
     // set right value of element at index to evaluated value of the astEXPRESSION
-    get<literal_arr_t>(ret_symb->object)->at(index) = get<literal_t>(curr_result);
+    ret_symb->object.a->set(index, curr_result);
 }
 
 void interpreter::visit(astASSIGNMENT_MEMBER* node) {
-    // maintain reference to tlstruct type instance
-    string tls_ident = ((astIDENTIFIER*) node->tls_name)->lexeme;
+    // get symbol bound to the tlstruct type instance
+    symbol* ret_symbol = resolve((astIDENTIFIER*) node->tls_name());
 
-    // get symbol corresponding to tlstruct type instance from lookup symbol table
-    symbol* ret_symbol = lookup_symbolTable->lookup(tls_ident);
+    // set lookup instance to the tlstruct instance, in which the member is held
+    lookup_record = ret_symbol->object.r;
+    node->assignment()->accept(this); // visit astASSIGNMENT_IDENTIFIER or astASSIGNMENT_ELEMENT node
+}
 
-    // set lookup symbol table to
-    lookup_symbolTable = get<symbol_table*>(get<literal_t>(ret_symbol->object));
-    node->assignment->accept(this); // visit astASSIGNMENT_IDENTIFIER or astASSIGNMENT_ELEMENT node
+// Utility function mapping an element type to the tag of the typed buffer holding elements of the type
+value::Tag interpreter::element_tag(grammarDFA::Symbol type){
+    switch(type){
+        case grammarDFA::T_BOOL: return value::BOOL;
+        case grammarDFA::T_INT: return value::INT;
+        case grammarDFA::T_FLOAT: return value::FLOAT;
+        case grammarDFA::T_CHAR: return value::CHAR;
+        case grammarDFA::T_STRING: return value::STRING;
+        default: return value::TLSTRUCT;
+    }
 }
 
 // Utility function for defining the default initialisation value of a type instance
-literal_t interpreter::default_literal(type_t type){
-    literal_t result;
+value interpreter::default_literal(astTYPE* type){
+    value result;
 
-    if(type.first == grammarDFA::T_BOOL){ // default: false
+    if(type->type == grammarDFA::T_BOOL){ // default: false
         result = false;
     }
-    else if(type.first == grammarDFA::T_INT){ // default: 0
+    else if(type->type == grammarDFA::T_INT){ // default: 0
         result = 0;
     }
-    else if(type.first == grammarDFA::T_FLOAT){ // default: 0.0
+    else if(type->type == grammarDFA::T_FLOAT){ // default: 0.0
         result = (float) 0.0;
     }
-    else if(type.first == grammarDFA::T_CHAR){ // default: '\0'
+    else if(type->type == grammarDFA::T_CHAR){ // default: '\0'
         result = '\0';
     }
-    else if(type.first == grammarDFA::T_STRING){ // default: ""
-        result = "";
+    else if(type->type == grammarDFA::T_STRING){ // default: "" (interned, hence shared by all default strings)
+        static const value empty_string = value::intern("");
+        result = empty_string;
     }
-        // default: pointer to a symbol table instance with the members of the tlstruct instance, as per definition of the named type
-    else if(type.first == grammarDFA::T_TLSTRUCT){
-        // find tlsSymbol in the lookup symbol table corresponding to the tlstruct type definition
-        symbol* ret_symbol = lookup_symbolTable->lookup(type.second);
-        lookup_symbolTable = curr_symbolTable; // reset symbol table references
+        // default: pointer to a new tlstruct instance, with the members initialised as per definition of the named type
+    else if(type->type == grammarDFA::T_TLSTRUCT){
+        check_depth(type->line); // the definition block is executed in a frame of its own, as for a call
+
+        // maintain reference to current frame and instances
+        frame* ref_frame = curr_frame;
+        tl_record* ref_curr_record = curr_record;
+        tl_record* ref_lookup_record = lookup_record;
 
-        // maintain reference to current symbol tables
-        auto* ref_curr_symbolTable = curr_symbolTable;
-        auto* ref_lookup_symbolTable = lookup_symbolTable;
+        // allocate the record of the instance as per the layout of the named type (held by the result from the outset,
+        // since the instance is reference counted)
+        result = tl_record::make(type->tls_ref->layout);
+        curr_record = result.r;
+        lookup_record = curr_record;
 
-        // set symbol table references to new symbol table instance which will hold symbols corresponding to the tls members
-        curr_symbolTable = new symbol_table(ref_curr_symbolTable); // note: linked to calling symbol table scope
-        lookup_symbolTable = curr_symbolTable;
+        // the tls definition block is executed in a new frame, linked to the frame in which the tlstruct is defined
+        curr_frame = push_frame(type->tls_ref->frame_size, static_parent(type->depth));
 
         // visit AST subtree rooted at the astBLOCK node corresponding to the tls type definition;
-        // in doing so, we will be populating the symbol table with (eventually) accessible members
-        for(auto &c : *((astBLOCK*) ((tlsSymbol*) ret_symbol)->tls_ref)->children){
+        // in doing so, we will be initialising the members of the instance
+        for(auto &c : type->tls_ref->children){
             c->accept(this);
         }
 
-        // restore symbol table references
-        result = curr_symbolTable;
-        curr_symbolTable = ref_curr_symbolTable;
-        lookup_symbolTable = ref_lookup_symbolTable;
+        // restore frame and instance references
+        pop_frame();
+
+        curr_frame = ref_frame;
+        curr_record = ref_curr_record;
+        lookup_record = ref_lookup_record;
     }
 
     return result;
 }
 
 void interpreter::visit(astVAR_DECL* node){
-    // maintain reference of the variable identifier and type
-    string var_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
-    type_t var_type(((astTYPE*) node->type)->type, ((astTYPE*) node->type)->lexeme);
-    varSymbol* var; // create new varSymbol instance
+    // maintain reference of the variable type
+    type_t var_type(((astTYPE*) node->type())->type, ((astTYPE*) node->type())->lexeme);
+    value var_value;
 
     // if assigning on declaration with an expression (recall that we changed variable assignment to being optional)
-    if(node->expression != nullptr){
-        node->expression->accept(this); // visit astEXPRESSION node corresponding to right-value being assigned
+    if(node->expression() != nullptr){
+        node->expression()->accept(this); // visit astEXPRESSION node corresponding to right-value being assigned
 
         // if type associated with definition is anonymous, set to type of astEXPRESSION result
         if(var_type.first == grammarDFA::T_AUTO){
             var_type = curr_type;
         }
 
-        var = new varSymbol(&var_ident, var_type); // initialise varSymbol instance with identifier and type
-        var->set_object(curr_result); // and set right-value
+        var_value = curr_result; // right-value is the result of the astEXPRESSION
     }
     else{
-        var = new varSymbol(&var_ident, var_type); // initialise varSymbol instance with identifier and type
-        var->set_object(default_literal(var_type)); // and set right-value to default value
+        var_value = default_literal((astTYPE*) node->type()); // right-value is the default value
     }
 
-    curr_symbolTable->insert(var); // insert into symbol table
+    // bind identifier to a symbol with the variable type, and set right-value
+    declare((astIDENTIFIER*) node->identifier(), var_type, grammarDFA::SINGLETON)->set_object(var_value);
 }
 
 void interpreter::visit(astARR_DECL* node){
     // maintain reference of array identifier and type
-    string arr_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
-    type_t arr_type(((astTYPE*) node->type)->type, ((astTYPE*) node->type)->lexeme);
+    string arr_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    type_t arr_type(((astTYPE*) node->type())->type, ((astTYPE*) node->type())->lexeme);
 
-    node->size->accept(this); // visit the astEXPRESSION node, the result of which is the size of the declared array
+    node->size()->accept(this); // visit the astEXPRESSION node, the result of which is the size of the declared array
     // maintain reference to the size by accessing the int value in the variant tagged-union
-    int size = get<int>(get<literal_t>(curr_result));
+    int size = curr_result.i;
 
     // check that the size is at least 1, otherwise we report a run-time error and terminate
     if(size < 1){
-        std::cerr << "ln " << node->line << ": size of array " << arr_ident << " must be a positive integer" << std::endl;
-        throw std::runtime_error("Runtime errors encountered, see trace above.");
+        report_error(node->line, "size of array " + arr_ident + " must be a positive integer");
     }
 
     int n_assignment_elts = node->n_children - 3; // work out the number of elements being assigned (can be 0)
     if(size < n_assignment_elts){ // if the number of specified number of elements being assigned exceeds the size of the array...
         // then we report a run-time error and terminate
-        std::cerr << "ln " << node->line << ": cannot assign " << n_assignment_elts << " elements to array " << arr_ident <<
-        " of size " << size << std::endl;
-        throw std::runtime_error("Runtime errors encountered, see trace above.");
+        report_error(node->line, "cannot assign " + to_string(n_assignment_elts) + " elements to array " + arr_ident +
+        " of size " + to_string(size));
     }
 
-    // literal_arr_t instance corresponding to the right value of an array
-    literal_arr_t lit_arr = new vector<literal_t>(size); // i.e. each literal_t entry is an element
+    literal_arr_t lit_arr; // literal_arr_t instance corresponding to the right value of an array
 
     // if the declared type is NOT anonymous and the array is not assigned, then we assign each element to the default value
     if(arr_type.first != grammarDFA::T_AUTO && n_assignment_elts == 0){
-        literal_t default_lit_val = default_literal(arr_type); // hold default value for the array type
+        value default_lit_val = default_literal((astTYPE*) node->type()); // hold default value for the array type
 
-        for(int i = 0; i < size; i++){
-            lit_arr->at(i) = default_lit_val;
-        }
+        lit_arr = new tl_array(element_tag(arr_type.first), size);
+        lit_arr->fill(0, default_lit_val);
     }
     else{
+        // the elements are evaluated prior to creating the typed buffer, since for anonymous typed arrays the element type
+        // is only known once the first element is evaluated
+        vector<value> elts;
         for(int i = 0; i < n_assignment_elts; i++){
-            (node->children->at(i+3))->accept(this); // visit astEXPRESSION node, result of which corresponds to value at i^th element
+            (node->children.at(i+3))->accept(this); // visit astEXPRESSION node, result of which corresponds to value at i^th element
 
             // if type associated with definition is anonymous, set to type of astEXPRESSION result
             if(arr_type.first == grammarDFA::T_AUTO){
                 arr_type = curr_type;
             }
 
-            lit_arr->at(i) = get<literal_t>(curr_result); // set i^th element value
+            elts.push_back(curr_result);
         }
 
-        // for any elements not initialised, set their value to the value of the last initialised element
-        for(int i = n_assignment_elts; i < size; i++){
-            lit_arr->at(i) = get<literal_t>(curr_result);
+        lit_arr = new tl_array(element_tag(arr_type.first), size);
+        for(int i = 0; i < n_assignment_elts; i++){
+            lit_arr->set(i, elts[i]); // set i^th element value
         }
-    }
 
-    // create new arrSymbol instance with specified identifier, type and size
-    auto* arr = new arrSymbol(&arr_ident, arr_type, size);
-    arr->set_object(lit_arr); // set right-value to constructed literal_arr_t
+        // for any elements not initialised, set their value to the value of the last initialised element
+        lit_arr->fill(n_assignment_elts, curr_result);
+    }
 
-    curr_symbolTable->insert(arr); // insert in the symbol table
+    // bind identifier to a symbol with the array type, and set right-value to constructed literal_arr_t
+    declare((astIDENTIFIER*) node->identifier(), arr_type, grammarDFA::ARRAY)->set_object(lit_arr);
 }
 
-void interpreter::visit(astTLS_DECL* node){
-    string tls_ident = ((astIDENTIFIER*) node->identifier)->lexeme; // maintain reference of tls named type identifier
-    auto* tls = new tlsSymbol(&tls_ident, &tls_ident); // initialise new tlsSymbol instance to be inserted
-
-    curr_symbolTable->insert(tls); // insert into the symbol table
-    tls->set_tls_ref((astBLOCK*) node->tls_block); // and set reference to the astBLOCK defining the tls type
-}
+// the tlstruct definition is bound to the named type by the resolver, hence there is nothing to be done at run-time
+void interpreter::visit(astTLS_DECL* node){}
 
 void interpreter::visit(astPRINT* node){
-    node->expression->accept(this); // visit the astEXPRESSION node, the result of which is the value(s) to be printed
+    node->expression()->accept(this); // visit the astEXPRESSION node, the result of which is the value(s) to be printed
 
     if(curr_obj_class == grammarDFA::ARRAY){ // in the case that the result of the astEXPRESSION yields an array...
-        std::cout << "{"; // print curly brack to signify that an array (collection of values) is being displayed
-        for(int i = 0; i < get<literal_arr_t>(curr_result)->size(); i++){
+        out->put_char('{'); // print curly brack to signify that an array (collection of values) is being displayed
+        for(int i = 0; i < curr_result.a->size; i++){
             if(i != 0){
-                std::cout << ", "; // print a comma to delimt between elements
+                out->put_string(", ", 2); // print a comma to delimt between elements
             }
 
-            // carry out case by case analysis, fetching the appropriate data item from the variant tagged-union type
-            // and printing appropriately
-            if(curr_type.first == grammarDFA::T_BOOL){
-                // cout results in true being printed as 1; we explicitly print "true" in this case
-                if(get<bool>(get<literal_arr_t>(curr_result)->at(i))){
-                    std::cout << "true";
-                }
-                else{ // cout results in false being printed as 0; we explicitly print "false" in this case
-                    std::cout << "false";
-                }
-            }
-            else if(curr_type.first == grammarDFA::T_INT){
-                std::cout << get<int>(get<literal_arr_t>(curr_result)->at(i));
-            }
-            else if(curr_type.first == grammarDFA::T_FLOAT){
-                std::cout << get<float>(get<literal_arr_t>(curr_result)->at(i));
-            }
-            else if(curr_type.first == grammarDFA::T_CHAR){
-                std::cout << get<char>(get<literal_arr_t>(curr_result)->at(i));
-            }
-            else{
-                std::cout << get<string>(get<literal_arr_t>(curr_result)->at(i));
-            }
+            print_value(curr_result.a->get(i));
         }
 
-        std::cout << "}" << std::endl; // print closing curly bracket
+        out->put_char('}'); // print closing curly bracket
     }
-    // otherwise, output is a single value, in which case we simply carry out case by case analysis, as we did for elements,
-    // fetching the appropriate data item from the variant tagged-union type and printing appropriately
-    else if(curr_type.first == grammarDFA::T_BOOL){
-        // cout results in true being printed as 1; we explicitly print "true" in this case
-        if(get<bool>(get<literal_t>(curr_result))){
-            std::cout << "true" << std::endl;
-        }
-        else{ // cout results in false being printed as 0; we explicitly print "false" in this case
-            std::cout << "false" << std::endl;
-        }
+    else{ // otherwise, output is a single value
+        print_value(curr_result);
+    }
+
+    out->end_line();
+}
+
+/* Prints a single value of the current type, carrying out case by case analysis to fetch the appropriate data item from
+ * the variant tagged-union type; booleans are printed as "true" and "false" (rather than 1 and 0).
+ */
+void interpreter::print_value(const value& v){
+    if(curr_type.first == grammarDFA::T_BOOL){
+        out->put_bool(v.b);
     }
     else if(curr_type.first == grammarDFA::T_INT){
-        std::cout << get<int>(get<literal_t>(curr_result)) << std::endl;
+        out->put_int(v.i);
     }
     else if(curr_type.first == grammarDFA::T_FLOAT){
-        std::cout << get<float>(get<literal_t>(curr_result)) << std::endl;
+        out->put_float(v.f);
     }
     else if(curr_type.first == grammarDFA::T_CHAR){
-        std::cout << get<char>(get<literal_t>(curr_result)) << std::endl;
+        out->put_char(v.c);
     }
     else{
-        std::cout << get<string>(get<literal_t>(curr_result)) << std::endl;
+        out->put_string(v.str());
     }
 }
 
 void interpreter::visit(astRETURN* node){
-    node->expression->accept(this); // visit astEXPRESSION node, the result of which is the value to be returned
+    node->expression()->accept(this); // visit astEXPRESSION node, the result of which is the value to be returned
     functionStack->top().second = true; // set bool on top of the function stack to true, indicating function has returned
 
     // if the function return type is anonymous...
@@ -943,32 +971,37 @@ void interpreter::visit(astRETURN* node){
 void interpreter::visit(astIF* node){
     // visit astEXPRESSION node, the result of which is a boolean determining whether the if branch or (if declared) the
     // else branch is to be evaluated
-    node->expression->accept(this);
+    node->expression()->accept(this);
 
     // if result is true, visit the AST subtree rooted at the astBLOCK corresponding to the if-branch
-    if(get<bool>(get<literal_t>(curr_result))){
-        node->if_block->accept(this);
+    if(curr_result.b){
+        node->if_block()->accept(this);
     } // else if result is false and else-branch is defined
-    else if(node->else_block != nullptr){ // visit the AST subtree rooted at the astBLOCK corresponding to the else-branch
-        node->else_block->accept(this);
+    else if(node->else_block() != nullptr){ // visit the AST subtree rooted at the astBLOCK corresponding to the else-branch
+        node->else_block()->accept(this);
     }
 }
 
-void interpreter::visit(astFOR* node){
-    // maintain scoping: push scope for for-block
-    curr_symbolTable->push_scope(); // we push new scope since the optional declaration should be accessible in the scope of the for-block
+// Clears the slots caching the expressions hoisted out of a loop, such that these are evaluated afresh upon entering it
+void interpreter::reset_hoisted(int first, int n){
+    for(int i = first; i < first + n; i++){
+        curr_frame->slots[i].set_object(value());
+    }
+}
 
+void interpreter::visit(astFOR* node){
     // if optional declaration statement given, visit
-    if(node->decl != nullptr){ node->decl->accept(this);}
+    if(node->decl() != nullptr){ node->decl()->accept(this);}
+    reset_hoisted(node->hoisted_first, node->n_hoisted);
 
     while(true){ // loop until break
-        node->expression->accept(this); // visit astEXPRESSION, the bool result of which determines whether to continue or break
+        node->expression()->accept(this); // visit astEXPRESSION, the bool result of which determines whether to continue or break
 
-        if(get<bool>(get<literal_t>(curr_result))){ // if true
-            node->for_block->accept(this); // visit astBLOCK associated with the for block
+        if(curr_result.b){ // if true
+            node->for_block()->accept(this); // visit astBLOCK associated with the for block
 
             if(functionStack->empty() || !functionStack->top().second){ // if no return encountered
-                if(node->assignment != nullptr){ node->assignment->accept(this);} // if optional assignment statement given, visit
+                if(node->assignment() != nullptr){ node->assignment()->accept(this);} // if optional assignment statement given, visit
             }
             else{ // else if return encountered, break out of for loop
                 break;
@@ -978,18 +1011,143 @@ void interpreter::visit(astFOR* node){
             break;
         }
     }
+}
+
+/* The iterations of a parallel for loop are independent of each other (see semantic_analysis), and are hence executed by
+ * the threads of a pool (see thread_pool), on a worker each: a worker executes iterations in a copy of the current frame
+ * (made prior to executing the loop), such that the variables declared within the loop are held by each worker, whereas
+ * those declared outside of it are shared (being only read, other than the elements of arrays assigned at index i).
+ *
+ * Should iterations encounter run-time errors, the error reported is that of the first such iteration, once all of the
+ * preceding iterations are executed, as if executed in sequence; the subsequent iterations yet to be started are skipped.
+ */
+void interpreter::visit(astPAR_FOR* node){
+    if(n_threads <= 1){
+        visit((astFOR*) node);
+        return;
+    }
+
+    // the loop is of the form parallel for(let i:int = a; i < b; i = i + 1), with the bound b evaluated once
+    auto* condition = (astRELOP*) node->expression();
+
+    node->decl()->accept(this);
+    reset_hoisted(node->hoisted_first, node->n_hoisted);
+
+    symbol* induction = resolve((astIDENTIFIER*) condition->operand1());
+    int64_t begin = induction->object.i;
+
+    condition->operand2()->accept(this);
+    int64_t end = (int64_t) curr_result.i + (condition->op == "<=" ? 1 : 0);
+
+    if(end - begin <= thread_pool::GRAIN){ // too few iterations to distribute
+        for(int64_t i = begin; i < end; i++){
+            induction->set_object((int32_t) i);
+            node->for_block()->accept(this);
+        }
+
+        return;
+    }
+
+    if(pool == nullptr){ start_workers();}
+
+    for(interpreter* w : workers){
+        w->curr_frame = w->push_frame(curr_frame->size, curr_frame->parent);
 
-    // maintain scoping: pop scope for for-block
-    curr_symbolTable->pop_scope();
+        for(int i = 0; i < curr_frame->size; i++){
+            w->curr_frame->slots[i].type = curr_frame->slots[i].type;
+            w->curr_frame->slots[i].object_class = curr_frame->slots[i].object_class;
+            w->curr_frame->slots[i].set_object(curr_frame->slots[i].object);
+        }
+
+        w->curr_record = curr_record;
+        w->lookup_record = curr_record;
+        w->depth_base = n_frames - 1;
+    }
+
+    long slot = induction - curr_frame->slots;
+
+    // the first iteration which encountered a run-time error (if any), and the error encountered
+    atomic<int64_t> first_error(end);
+    mutex error_lock;
+    exception_ptr error;
+
+    pool->run(begin, end, [&](int participant, int64_t from, int64_t to){
+        interpreter* w = workers[participant];
+        frame* loop_frame = w->curr_frame;
+
+        if(participant != 0){ w->stack_limit = native_stack_limit(worker_stack_size);}
+
+        for(int64_t i = from; i < to && i < first_error.load(memory_order_relaxed); i++){
+            try{
+                loop_frame->slots[slot].set_object((int32_t) i);
+                node->for_block()->accept(w);
+            }
+            catch(...){
+                lock_guard<mutex> guard(error_lock);
+                if(i < first_error.load(memory_order_relaxed)){
+                    error = current_exception();
+                    first_error.store(i, memory_order_relaxed);
+                }
+
+                w->restore_worker(loop_frame, curr_record);
+            }
+        }
+    });
+
+    for(interpreter* w : workers){
+        w->pop_frame();
+    }
+
+    if(error != nullptr){
+        try{
+            rethrow_exception(error);
+        }
+        catch(const std::runtime_error& report){ // i.e. a run-time error reported by the worker
+            std::cerr << report.what() << std::endl;
+            throw std::runtime_error("Runtime errors encountered, see trace above.");
+        }
+    }
+}
+
+// Creates the pool of threads executing parallel for loops, along with a worker per thread (including the calling thread)
+void interpreter::start_workers(){
+    pool = new thread_pool(n_threads, worker_stack_size);
+
+    for(int i = 0; i < n_threads; i++){
+        auto* w = new interpreter(max_depth, out, 1);
+        w->worker = true;
+        w->worker_stack_size = worker_stack_size;
+        workers.push_back(w);
+    }
+
+    workers[0]->stack_limit = stack_limit; // executes on the calling thread
+}
+
+// Restores a worker to the frame of the loop, following a run-time error (i.e. unwinds the calls being executed)
+void interpreter::restore_worker(frame* loop_frame, tl_record* loop_record){
+    while(frame_pool[n_frames - 1] != loop_frame){
+        pop_frame();
+    }
+
+    while(!functionStack->empty()){
+        functionStack->pop();
+    }
+
+    curr_frame = loop_frame;
+    curr_aparams = nullptr;
+    curr_record = loop_record;
+    lookup_record = loop_record;
 }
 
 void interpreter::visit(astWHILE* node){
+    reset_hoisted(node->hoisted_first, node->n_hoisted);
+
     while(true){ // loop until break
-        node->expression->accept(this); // visit astEXPRESSION, the bool result of which determines whether to continue or break
+        node->expression()->accept(this); // visit astEXPRESSION, the bool result of which determines whether to continue or break
 
-        if(get<bool>(get<literal_t>(curr_result))){ // if true
+        if(curr_result.b){ // if true
             // visit astBLOCK associated with the while block, if specified (since it is optional)
-            if(node->while_block != nullptr){ node->while_block->accept(this);}
+            if(node->while_block() != nullptr){ node->while_block()->accept(this);}
 
             // if return encountered, break out of while loop
             if(!functionStack->empty() && functionStack->top().second){
@@ -1005,55 +1163,20 @@ void interpreter::visit(astWHILE* node){
 void interpreter::visit(astFPARAMS* node){}
 void interpreter::visit(astFPARAM* node){}
 
-void interpreter::visit(astFUNC_DECL* node){
-    // maintain reference of function identifier and return type/object class
-    string func_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
-    type_t ret_type = type_t(((astTYPE*) node->type)->type, ((astTYPE*) node->type)->lexeme);
-    grammarDFA::Symbol ret_obj_class = ((astTYPE*) node->type)->object_class;
-
-    auto* fparams = new vector<symbol*>(0); // will hold the type signature of the function in the form of dummy symbol instances
-
-    if(node->fparams != nullptr){ // if at least 1 astFPARAM node specified
-        // for each astFPARAM child node
-        for(auto &c : *((astFPARAMS*) node->fparams)->children){
-            // maintain reference of the parameters identifier, type, and object class
-            string fparam_ident = ((astIDENTIFIER*) ((astFPARAM*) c)->children->at(0))->lexeme;
-            type_t fparam_type = type_t(((astTYPE*) ((astFPARAM*) c)->children->at(1))->type,
-                                                    ((astTYPE*) ((astFPARAM*) c)->children->at(1))->lexeme);
-            grammarDFA::Symbol fparam_obj_class = ((astTYPE*) ((astFPARAM*) c)->children->at(1))->object_class;
-
-            if(fparam_obj_class == grammarDFA::ARRAY){
-                // create new dummy arrSymbol instance and insert into fparams vector to build the type signature
-                fparams->push_back(new arrSymbol(&fparam_ident, fparam_type, 0));
-            }else{
-                // create new dummy varSymbol instance and insert into fparams vector to build the type signature
-                fparams->push_back(new varSymbol(&fparam_ident, fparam_type));
-            }
-        }
-    }
-
-    // create new funcSymbol instance for the function declaration
-    auto* func = new funcSymbol(&func_ident, ret_type, ret_obj_class, fparams);
-    func->set_func_ref((astBLOCK*) node->function_block); // set reference to astBLOCK instance corresponding to the function block
-
-    curr_symbolTable->insert(func); // insert funcSymbol instance into the symbol table
-}
+// function calls are bound to the function definition during semantic analysis, hence there is nothing to be done at run-time
+void interpreter::visit(astFUNC_DECL* node){}
 
 void interpreter::visit(astMEMBER_ACCESS* node){
-    string tls_ident = ((astIDENTIFIER*) node->tls_name)->lexeme; // hold reference of tlstruct instance name
-    symbol* ret_symbol = lookup_symbolTable->lookup(tls_ident); // and lookup instance with matching identifier in lookup symbol table
+    symbol* ret_symbol = resolve((astIDENTIFIER*) node->tls_name()); // get symbol bound to the tlstruct instance name
 
-    // set lookup symbol table reference to that containing the member symbol of the tlstruct instance
-    lookup_symbolTable = get<symbol_table*>(get<literal_t>(ret_symbol->object));
-    node->member->accept(this);
+    // set lookup instance reference to the tlstruct instance, in which the member is held
+    lookup_record = ret_symbol->object.r;
+    node->member()->accept(this);
 }
 
 void interpreter::visit(astBLOCK* node){
-    // maintain scoping: push new scope for symbols within block
-    curr_symbolTable->push_scope();
-
     // visit each child node corresponding to a statement
-    for(auto &c : *node->children){
+    for(auto &c : node->children){
         c->accept(this);
 
         // if return statement encountered, break
@@ -1061,13 +1184,13 @@ void interpreter::visit(astBLOCK* node){
             break;
         }
     }
-
-    // maintain scoping: pop score and return to upper scope
-    curr_symbolTable->pop_scope();
 }
+
 void interpreter::visit(astPROGRAM* node){
+    curr_frame = push_frame(node->frame_size, nullptr); // frame holding the global variables
+
     // visit each child node corresponding to a statement
-    for(auto &c : *node->children){
+    for(auto &c : node->children){
         c->accept(this);
 
         // if return statement encountered, break
@@ -1075,4 +1198,25 @@ void interpreter::visit(astPROGRAM* node){
             break;
         }
     }
-}
\ No newline at end of file
+}
+
+/* A hoisted expression is evaluated upon its first evaluation since entering the enclosing loop, after which its result
+ * (along with its type and object class) is cached in its slot and reused; a slot holding no value (i.e. NONE, which no
+ * expression evaluates to) has yet to be evaluated.
+ */
+void interpreter::visit(astHOISTED* node){
+    symbol* cache = &(curr_frame->slots[node->slot]);
+
+    if(cache->object.tag == value::NONE){
+        node->expression()->accept(this);
+
+        cache->type = curr_type;
+        cache->object_class = curr_obj_class;
+        cache->object = curr_result;
+    }
+    else{
+        curr_type = cache->type;
+        curr_obj_class = cache->object_class;
+        curr_result = cache->object;
+    }
+}
@@ -8,6 +8,9 @@
 #include "../symbol_table/symbol_table.h"
 #include "../symbol_table/symbol.h"
 #include "../visitor_ast/visitor.h"
+#include "array_expression.h"
+#include "thread_pool.h"
+#include "../output_sink/output_sink.h"
 #include <iostream>
 
 class interpreter: public visitor{
@@ -33,6 +36,7 @@ public:
     void visit(astRETURN* node) override;
     void visit(astIF* node) override;
     void visit(astFOR* node) override;
+    void visit(astPAR_FOR* node) override;
     void visit(astWHILE* node) override;
     void visit(astFPARAMS* node) override;
     void visit(astFPARAM* node) override;
@@ -40,21 +44,92 @@ public:
     void visit(astMEMBER_ACCESS* node) override;
     void visit(astBLOCK* node) override;
     void visit(astPROGRAM* node) override;
+    void visit(astHOISTED* node) override;
+
+    interpreter(size_t max_depth, output_sink* out, int n_threads);
 
 private:
+    /* The interpreter evaluates each call recursively on the native (C++) stack, which is hence bounded in addition to
+     * the maximum call depth: calls are refused once less than STACK_RESERVE bytes of native stack remain (as per the
+     * stack size limit of the process), with a run-time error rather than a segmentation fault. Deeper recursion should
+     * be executed on the virtual machine, which does not recurse on the native stack.
+     */
+    static constexpr size_t STACK_RESERVE = 256 * 1024;
+
+    // native stack size of the threads executing parallel for loops, if that of the process is unlimited
+    static constexpr size_t WORKER_STACK_SIZE = 64 * 1024 * 1024;
+
+    size_t max_depth; // maximum number of active calls (and tlstruct instantiations)
+    output_sink* out; // sink to which the output of print statements is written
+    uintptr_t stack_limit = 0; // lowest address the native stack may reach before a call is refused, 0 if unlimited
+    size_t worker_stack_size = WORKER_STACK_SIZE;
+
+    /* The iterations of parallel for loops are executed by a pool of n_threads threads (created upon executing the first
+     * such loop), each executing iterations on an interpreter of its own, i.e. a worker (see visit(astPAR_FOR)). Workers
+     * execute parallel for loops (nested within the iterations they execute) as for loops.
+     */
+    int n_threads;
+    thread_pool* pool = nullptr;
+    vector<interpreter*> workers; // by participant of the pool
+    bool worker = false;
+    size_t depth_base = 0; // for a worker, the number of frames below its own (those of the loop being executed)
+
+    /* Variables are held in frames, as resolved by the resolver pass: a frame is created for each function call (as well
+     * as for the main program and for each tlstruct instantiation), with a slot per variable and a static link to the
+     * frame of the lexically enclosing function.
+     *
+     * Since frames are created and destroyed in LIFO order, the slots of all frames are allocated from an arena, i.e. a
+     * stack of blocks of slots, and frames themselves are reused by depth (see push_frame and pop_frame). Hence, once the
+     * maximum call depth is reached, calls do not allocate; values held by the slots are released on popping a frame.
+     */
+    struct frame{
+        symbol* slots;
+        int size;
+        frame* parent; // static link
+        size_t block, top; // top of the arena prior to allocating the slots of the frame, restored once popped
+    };
+
+    static constexpr int BLOCK_SLOTS = 1024; // minimum number of slots in each block of the arena
+
+    vector<vector<symbol>> slot_blocks;
+    size_t curr_block = 0, block_top = 0; // top of the arena, i.e. the next free slot
+    vector<frame*> frame_pool; // frames, by depth
+    size_t n_frames = 0; // number of frames in use
+
     stack<pair<funcSymbol*, bool>>* functionStack = new stack<pair<funcSymbol*, bool>>; // 2nd used to check if func returns
-    symbol_table* curr_symbolTable = new symbol_table(nullptr);
-    symbol_table* lookup_symbolTable = curr_symbolTable;
+    frame* curr_frame = nullptr;
+    symbol* curr_aparams = nullptr; // slots of the frame of the function call whose actual parameters are being evaluated
+
+    // the tlstruct instance whose member function (or definition block) is being executed, nullptr if none; the lookup
+    // instance is that in which the next member identifier is looked up (eg. following member access)
+    tl_record* curr_record = nullptr;
+    tl_record* lookup_record = curr_record;
 
     type_t curr_type;
     grammarDFA::Symbol curr_obj_class;
-    obj_t curr_result;
+    value curr_result;
 
-    literal_t multop(string op, int line, literal_t lit1, literal_t lit2);
-    literal_t addop(string op, literal_t lit1, literal_t lit2);
-    literal_t relop(string op, literal_t lit1, literal_t lit2);
-    literal_t unary(string op, literal_t literal);
-    literal_t default_literal(type_t type);
+    value multop(const string& op, int line, const value& lit1, const value& lit2);
+    value addop(const string& op, const value& lit1, const value& lit2);
+    value relop(const string& op, const value& lit1, const value& lit2);
+    value unary(const string& op, const value& literal);
+    int fuse(astNode* node, array_expression& expr);
+    void evaluate_fused(astNode* node);
+    static value::Tag element_tag(grammarDFA::Symbol type);
+    value default_literal(astTYPE* type);
+    bool append_string(symbol* target, astNode* expression);
+    void print_value(const value& v);
+    symbol* resolve(astIDENTIFIER* identifier);
+    symbol* declare(astIDENTIFIER* identifier, type_t type, grammarDFA::Symbol object_class);
+    frame* static_parent(int depth);
+    frame* push_frame(int size, frame* parent);
+    void pop_frame();
+    void check_depth(unsigned int line);
+    [[noreturn]] void report_error(unsigned int line, const string& message);
+    static uintptr_t native_stack_limit(size_t stack_size);
+    void start_workers();
+    void restore_worker(frame* loop_frame, tl_record* loop_record);
+    void reset_hoisted(int first, int n);
 };
 
 #endif //CPS2000_INTERPRETER_H
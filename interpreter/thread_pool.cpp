@@ -0,0 +1,173 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "thread_pool.h"
+
+#include <stdexcept>
+
+// Rounds an iteration down to a multiple of GRAIN (towards negative infinity)
+static int64_t align_down(int64_t i){
+    int64_t offset = i % thread_pool::GRAIN;
+    return offset < 0 ? i - offset - thread_pool::GRAIN : i - offset;
+}
+
+thread_pool::thread_pool(int n_participants, size_t stack_size){
+    this->n_participants = n_participants;
+    ranges = unique_ptr<range[]>(new range[n_participants]);
+
+    // the threads are created with the specified stack size, since (unlike the main thread) their stacks cannot grow
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, stack_size);
+
+    for(int participant = 1; participant < n_participants; participant++){
+        pthread_t thread;
+        auto* arg = new pair<thread_pool*, int>(this, participant);
+
+        if(pthread_create(&thread, &attr, thread_main, arg) != 0){
+            delete arg;
+            throw std::runtime_error("Could not create the threads executing parallel for loops...exiting...");
+        }
+
+        threads.push_back(thread);
+    }
+
+    pthread_attr_destroy(&attr);
+}
+
+thread_pool::~thread_pool(){
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    start.notify_all();
+
+    for(pthread_t thread : threads){
+        pthread_join(thread, nullptr);
+    }
+}
+
+// Executes each loop started (see run) as the participant with which the thread was created, until the pool is destroyed
+void* thread_pool::thread_main(void* arg){
+    thread_pool* pool = ((pair<thread_pool*, int>*) arg)->first;
+    int participant = ((pair<thread_pool*, int>*) arg)->second;
+    delete (pair<thread_pool*, int>*) arg;
+
+    uint64_t n_started = 0;
+
+    while(true){
+        {
+            unique_lock<mutex> guard(pool->lock);
+            pool->start.wait(guard, [&](){ return pool->stopping || pool->n_loops != n_started;});
+
+            if(pool->stopping){
+                return nullptr;
+            }
+
+            n_started = pool->n_loops;
+        }
+
+        pool->work(participant);
+
+        lock_guard<mutex> guard(pool->lock);
+        if(--pool->n_running == 0){
+            pool->done.notify_one();
+        }
+    }
+}
+
+void thread_pool::run(int64_t begin, int64_t end, const loop_body& loop){
+    // split the range evenly between the participants, at multiples of GRAIN
+    int64_t from = begin;
+
+    for(int participant = 0; participant < n_participants; participant++){
+        int64_t to = end;
+
+        if(participant < n_participants - 1){
+            to = min(end, max(from, align_down(begin + (end - begin) * (participant + 1) / n_participants)));
+        }
+
+        ranges[participant].begin = from;
+        ranges[participant].end = to;
+        from = to;
+    }
+
+    // the ranges are published to the threads along with the loop, by the lock
+    {
+        lock_guard<mutex> guard(lock);
+        body = &loop;
+        n_running = n_participants - 1;
+        n_loops++;
+    }
+    start.notify_all();
+
+    work(0);
+
+    unique_lock<mutex> guard(lock);
+    done.wait(guard, [&](){ return n_running == 0;});
+    body = nullptr;
+}
+
+// Executes the iterations of the participant a grain at a time, stealing iterations once its own are exhausted
+void thread_pool::work(int participant){
+    int64_t begin, end;
+
+    while(true){
+        if(take(participant, begin, end)){
+            (*body)(participant, begin, end);
+        }
+        else if(!steal(participant)){
+            return;
+        }
+    }
+}
+
+// Takes the iterations up to the next multiple of GRAIN from the front of the range of the participant, if any
+bool thread_pool::take(int participant, int64_t& begin, int64_t& end){
+    range& own = ranges[participant];
+    lock_guard<mutex> guard(own.lock);
+
+    if(own.begin >= own.end){
+        return false;
+    }
+
+    begin = own.begin;
+    end = min(own.end, align_down(begin) + GRAIN);
+    own.begin = end;
+
+    return true;
+}
+
+/* Steals the latter half of the remaining range of another participant (split at a multiple of GRAIN), trying each other
+ * participant in turn; returns false if no range can be split, in which case the remaining iterations (if any) are
+ * executed by the participants to which they belong.
+ */
+bool thread_pool::steal(int participant){
+    for(int i = 1; i < n_participants; i++){
+        range& victim = ranges[(participant + i) % n_participants];
+        int64_t begin, end;
+
+        {
+            lock_guard<mutex> guard(victim.lock);
+            int64_t split = align_down(victim.begin + (victim.end - victim.begin) / 2);
+
+            if(split <= victim.begin){
+                continue;
+            }
+
+            begin = split;
+            end = victim.end;
+            victim.end = split;
+        }
+
+        range& own = ranges[participant];
+        lock_guard<mutex> guard(own.lock);
+        own.begin = begin;
+        own.end = end;
+
+        return true;
+    }
+
+    return false;
+}
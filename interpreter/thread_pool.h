@@ -0,0 +1,67 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_THREAD_POOL_H
+#define CPS2000_THREAD_POOL_H
+
+#include <pthread.h>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+/* A fixed set of threads executing the iterations of a loop (i.e. a range of integers) along with the calling thread,
+ * balancing the load by work stealing: the range is initially split evenly between the participants (the threads of the
+ * pool and the calling thread), each of which executes its own range a grain at a time, from the front. Once its range
+ * is exhausted, a participant steals the latter half of the remaining range of another participant, such that those
+ * delayed (or with more costly iterations) are relieved of iterations, until no range can be split any further.
+ *
+ * Ranges are only ever split at multiples of GRAIN, hence each (aligned) block of GRAIN iterations is executed by a
+ * single participant; in particular, the elements of a boolean array (held as bits of 64 bit words, see tl_array)
+ * assigned by distinct participants at the index of the iteration are held by distinct words.
+ */
+class thread_pool{
+public:
+    static constexpr int64_t GRAIN = 64;
+
+    // the body of a loop, executing the iterations [begin, end) as the specified participant (0 being the caller)
+    typedef function<void(int participant, int64_t begin, int64_t end)> loop_body;
+
+    thread_pool(int n_participants, size_t stack_size);
+    ~thread_pool();
+
+    int size() const{ return n_participants;}
+
+    // executes the iterations [begin, end) of the body, returning once all are executed; the body must not throw
+    void run(int64_t begin, int64_t end, const loop_body& body);
+
+private:
+    struct alignas(64) range{ // a cache line each, since each is updated by its participant upon taking each grain
+        mutex lock;
+        int64_t begin = 0, end = 0;
+    };
+
+    int n_participants;
+    unique_ptr<range[]> ranges; // the iterations yet to be taken by each participant
+    vector<pthread_t> threads;
+
+    // the following are protected by the lock, and used to start the threads on a loop and await their completion
+    mutex lock;
+    condition_variable start, done;
+    const loop_body* body = nullptr;
+    uint64_t n_loops = 0; // number of loops started, such that each thread starts each loop once
+    int n_running = 0; // number of threads yet to complete the current loop
+    bool stopping = false;
+
+    static void* thread_main(void* arg);
+    void work(int participant);
+    bool take(int participant, int64_t& begin, int64_t& end);
+    bool steal(int participant);
+};
+
+#endif //CPS2000_THREAD_POOL_H
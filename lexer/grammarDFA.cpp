@@ -4,73 +4,79 @@
 
 #include "grammarDFA.h"
 
+/* Reserved words are recognised using a perfect hash over the lexeme, computed from its length and its first and last
+ * characters; the hash was chosen such that each reserved word maps to a distinct entry of a 32 entry table (which is
+ * verified at compile-time below). Hence classifying an identifier requires a single table lookup and at most one
+ * string comparison, rather than comparing the lexeme against each reserved word in turn.
+ */
+struct keyword{
+    string_view lexeme;
+    grammarDFA::Symbol symbol;
+};
+
+static constexpr keyword keywords[] = {
+        {"and", grammarDFA::T_AND}, {"or", grammarDFA::T_OR}, {"not", grammarDFA::T_NOT},
+        {"true", grammarDFA::T_BOOL}, {"false", grammarDFA::T_BOOL},
+        {"int", grammarDFA::T_TYPE}, {"float", grammarDFA::T_TYPE}, {"bool", grammarDFA::T_TYPE},
+        {"string", grammarDFA::T_TYPE}, {"char", grammarDFA::T_TYPE}, {"auto", grammarDFA::T_TYPE},
+        {"let", grammarDFA::T_LET}, {"print", grammarDFA::T_PRINT}, {"return", grammarDFA::T_RETURN},
+        {"if", grammarDFA::T_IF}, {"else", grammarDFA::T_ELSE}, {"for", grammarDFA::T_FOR},
+        {"while", grammarDFA::T_WHILE}, {"tlstruct", grammarDFA::T_TLSTRUCT}, {"parallel", grammarDFA::T_PARALLEL}
+};
+
+static constexpr int keyword_table_size = 32; // a power of 2, such that the hash is reduced by masking
+
+// hash of a non-empty lexeme
+static constexpr unsigned keyword_hash(string_view lexeme){
+    return (lexeme.size() * 11 + (unsigned char) lexeme.front() + (unsigned char) lexeme.back() * 19)
+           & (keyword_table_size - 1);
+}
+
+struct keyword_table_t{
+    keyword entries[keyword_table_size];
+    bool perfect; // true if no two reserved words share an entry
+};
+
+// Builds the table at compile-time, with unused entries holding an empty lexeme (which never matches an identifier)
+static constexpr keyword_table_t build_keyword_table(){
+    keyword_table_t table{};
+    table.perfect = true;
+
+    for(const keyword& kw : keywords){
+        keyword& entry = table.entries[keyword_hash(kw.lexeme)];
+
+        if(!entry.lexeme.empty()){ table.perfect = false;}
+        entry = kw;
+    }
+
+    return table;
+}
+
+static constexpr keyword_table_t keyword_table = build_keyword_table();
+static_assert(keyword_table.perfect, "keyword_hash must map each reserved word to a distinct entry");
+
 /* Simple function which returns the corresponding Symbol based on the current state of the DFA. If the current state
  * yields a Symbol instance other than T_IDENTIFIER, then a call to state_tok is equivalent to an access of final_state_tokens.
  *
  * Reserved words are treated by the DFA as an identifier, i.e. they are attributed a T_IDENTIFIER Symbol. Further
- * distinction is made using this function, by checking the lexeme attributed with the token.
+ * distinction is made using this function, by looking up the lexeme attributed with the token in the keyword table.
  */
-grammarDFA::Symbol grammarDFA::state_tok(State state, string* lexeme){
+grammarDFA::Symbol grammarDFA::state_tok(State state, string_view lexeme){
     Symbol symbol = final_state_tokens[state];
 
     if(symbol == T_IDENTIFIER){ // check if reserved word
-        if(*lexeme == "and"){
-            return T_AND;
-        }
-        else if(*lexeme == "or"){
-            return T_OR;
-        }
-        else if(*lexeme == "not"){
-            return T_NOT;
-        }
-        else if(*lexeme == "true" || *lexeme == "false"){
-            return T_BOOL;
-        }
-        else if(*lexeme == "int" || *lexeme == "float" || *lexeme == "bool" || *lexeme == "string" || *lexeme == "char"
-                || *lexeme == "auto"){
-            return T_TYPE;
-        }
-        else if(*lexeme == "let"){
-            return T_LET;
-        }
-        else if(*lexeme == "print"){
-            return T_PRINT;
-        }
-        else if(*lexeme == "return"){
-            return T_RETURN;
-        }
-        else if(*lexeme == "if"){
-            return T_IF;
-        }
-        else if(*lexeme == "else"){
-            return T_ELSE;
-        }
-        else if(*lexeme == "for"){
-            return T_FOR;
-        }
-        else if(*lexeme == "while"){
-            return T_WHILE;
-        }
-        else if(*lexeme == "tlstruct"){
-            return T_TLSTRUCT;
-        }
-        else{ // otherwise if lexeme of T_IDENTIFIER is not a reserved word
-            return symbol;
+        const keyword& entry = keyword_table.entries[keyword_hash(lexeme)];
+
+        if(entry.lexeme == lexeme){
+            return entry.symbol;
         }
     }
-    else{ // otherwise, equivalent to call to final_state_tokens
-        return symbol;
-    }
-}
 
-// Simple wrapper to access the transition table using a state and a character, binding the character to the corresponding
-// transition type class
-grammarDFA::State grammarDFA::transition(State state, char c){
-    return transition_table[state][get_transition_type(c)];
+    return symbol; // otherwise, equivalent to call to final_state_tokens
 }
 
 // Utility function that retrieves the transition type class of a character
-grammarDFA::TransitionType grammarDFA::get_transition_type(char c){
+constexpr grammarDFA::TransitionType grammarDFA::get_transition_type(char c){
     if(c == 'n' || c == 't' || c == 'r' || c == 'b' || c == 'f' || c == 'v'){
         return ESC;
     }
@@ -155,4 +161,31 @@ grammarDFA::TransitionType grammarDFA::get_transition_type(char c){
     else {
         return PRINTABLE;
     }
-}
\ No newline at end of file
+}
+
+// Binds each byte to its transition type class, at compile-time
+constexpr grammarDFA::byte_class_table grammarDFA::build_byte_classes(){
+    byte_class_table table{};
+
+    for(int b = 0; b < 256; b++){
+        table.classes[b] = get_transition_type((char) b);
+    }
+
+    return table;
+}
+
+// Fuses the byte classes with transition_table, such that the transition on a byte b from a state s is next[s][b]
+constexpr grammarDFA::delta_table grammarDFA::build_delta(){
+    constexpr byte_class_table byte_classes = build_byte_classes();
+    delta_table table{};
+
+    for(int s = 0; s < n_states; s++){
+        for(int b = 0; b < 256; b++){
+            table.next[s][b] = (uint8_t) transition_table[s][byte_classes.classes[b]];
+        }
+    }
+
+    return table;
+}
+
+const grammarDFA::delta_table grammarDFA::delta = build_delta(); // constant initialised, i.e. no run-time cost
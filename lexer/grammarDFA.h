@@ -5,7 +5,8 @@
 #ifndef CPS2000_GRAMMARDFA_H
 #define CPS2000_GRAMMARDFA_H
 
-#include <string>
+#include <cstdint>
+#include <string_view>
 using namespace std;
 
 class grammarDFA{
@@ -36,19 +37,31 @@ public:
         FPARAMS_ext, APARAMS, APARAMS_ext, SUBEXPR, LITERAL, UNARY, FUNC_CALL, FUNC_CALL_APARAMS, IF, ELSE, FUNC_DECL,
         FUNC_DECL_FPARAMS, FOR, FOR_DECL, FOR_EXPRESSION, FOR_ASSIGNMENT, FACTOR, TERM, TERM_ext, S_EXPR, S_EXPR_ext,
         EXPRESSION_ext, TYPE_VAR, TYPE_ARR, IDENTIFIER, DECL, VAR_DECL_ASSIGNMENT, ARR_DECL_ASSIGNMENT,
-        ARR_DECL_ASSIGNMENT_ext, ELEMENT, FPARAM_TYPE, TLS_DECL, MEMBER, MEMBER_ACCESS, SINGLETON, ARRAY, FUNCTION, // Non--Terminal Symbols, n_NTS = 48
+        ARR_DECL_ASSIGNMENT_ext, ELEMENT, FPARAM_TYPE, TLS_DECL, MEMBER, MEMBER_ACCESS, SINGLETON, ARRAY, FUNCTION, PAR_FOR, // Non--Terminal Symbols, n_NTS = 49
 
-        T_INT, T_FLOAT, T_STRING, T_CHAR, T_AUTO, T_MUL, T_DIV, T_PLUS, T_MINUS, T_EQUALS, T_RELOP, // Terminal Symbols, n_token_types = 38
+        T_INT, T_FLOAT, T_STRING, T_CHAR, T_AUTO, T_MUL, T_DIV, T_PLUS, T_MINUS, T_EQUALS, T_RELOP, // Terminal Symbols, n_token_types = 39
         T_LBRACKET, T_RBRACKET, T_LBRACE, T_RBRACE, T_PERIOD, T_COLON, T_SEMICOLON, T_COMMENT, T_INVALID, T_COMMA, T_EOF,
         T_IDENTIFIER, T_AND, T_OR, T_NOT, T_BOOL, T_TYPE, T_LET, T_PRINT, T_RETURN, T_IF, T_ELSE, T_FOR, T_WHILE,
-        T_LSQUARE, T_RSQUARE, T_TLSTRUCT
+        T_LSQUARE, T_RSQUARE, T_TLSTRUCT, T_PARALLEL
     };
 
     // maintain counts for array size declaration and indexing purposes
-    const static int n_NTS = 48, n_token_types = 38;
+    const static int n_NTS = 49, n_token_types = 39;
 
-    Symbol state_tok(State, string*);
-    State transition(State, char);
+    /* The DFA is stateless, and hence its tables are static constexpr members shared by all users (rather than being
+     * initialised per instance), with the functions below being static.
+     */
+    static Symbol state_tok(State, string_view);
+
+    // Accesses the transition table using a state and a character (see delta below)
+    static State transition(State state, char c){
+        return (State) delta.next[state][(unsigned char) c];
+    }
+
+    // returns true if the state is a final state of the DFA, i.e. it is attributed a symbol other than T_INVALID
+    static bool is_final(State state){
+        return final_state_tokens[state] != T_INVALID;
+    }
 private:
     // maintain counts for array size declaration and indexing purposes
     const static int n_states = 37, n_delta_types = 28;
@@ -61,7 +74,7 @@ private:
      *
      * S_E is the error state, used so that we have a total transition function.
      */
-    const State transition_table[n_states][n_delta_types] = {
+    static constexpr State transition_table[n_states][n_delta_types] = {
    // LETTER| ESC|ZERO| DIGIT| PRINT.| '_'| '.'| ':'| ';'| '"'| '*'| '/'| '\'| '('| ')'| '{'| '}'| '='|'<''>'| '!'| '+'| '-'|'\n'| ','|'\0'| '''| '['| ']'|
      {    S1,  S1,  S2,    S2,    S_E,  S1, S24, S25, S26,  S5, S17, S12, S_E, S20, S21, S22, S23, S10,    S8,  S9, S18, S19, S_E, S27, S28, S29, S33, S34}, // S0  -> T_INVALID
      {    S1,  S1,  S1,    S1,    S_E,  S1, S_E, S_E, S_E, S_E, S_E, S_E, S_E, S_E, S_E, S_E, S_E, S_E,   S_E, S_E, S_E, S_E, S_E, S_E, S_E, S_E, S_E, S_E}, // S1  -> T_IDENTIFIER
@@ -104,14 +117,31 @@ private:
     /* Utility function which binds a state of the DFA to a terminal Symbol instance. In particular, if the state is not
      * a final state, then the state is bound to the T_INVALID symbol.
      */
-    const Symbol final_state_tokens[n_states] = {T_INVALID, T_IDENTIFIER, T_INT, T_INVALID, T_FLOAT, T_INVALID, T_INVALID,
+    static constexpr Symbol final_state_tokens[n_states] = {T_INVALID, T_IDENTIFIER, T_INT, T_INVALID, T_FLOAT, T_INVALID, T_INVALID,
                                                  T_STRING, T_RELOP, T_INVALID, T_EQUALS, T_RELOP, T_DIV, T_INVALID,
                                                  T_INVALID, T_INVALID, T_COMMENT, T_MUL, T_PLUS, T_MINUS, T_LBRACKET,
                                                  T_RBRACKET, T_LBRACE, T_RBRACE, T_PERIOD, T_COLON, T_SEMICOLON, T_COMMA,
                                                  T_EOF, T_INVALID, T_INVALID, T_INVALID, T_CHAR, T_LSQUARE, T_RSQUARE,
                                                  T_INVALID};
 
-    static TransitionType get_transition_type(char);
+    static constexpr TransitionType get_transition_type(char);
+
+    /* The transition table above is indexed by transition type class, such that each transition would first require
+     * binding the character to its class. Instead, the two are fused at compile-time into a single flat table indexed
+     * directly by the state and the (unsigned) character, using a 256 entry table binding each byte to its class (see
+     * grammarDFA.cpp). States are held in a single byte, such that the entire table occupies under 10KB.
+     */
+    struct byte_class_table{
+        TransitionType classes[256];
+    };
+
+    struct delta_table{
+        uint8_t next[n_states][256];
+    };
+
+    static constexpr byte_class_table build_byte_classes();
+    static constexpr delta_table build_delta();
+    static const delta_table delta;
 };
 
 #endif //CPS2000_GRAMMARDFA_H
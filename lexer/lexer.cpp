@@ -4,83 +4,169 @@
 
 #include "lexer.h"
 
+#include <cctype>
+#include <stdexcept>
 #include <utility>
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define TL_LEXER_SSE2
+#include <emmintrin.h>
+#endif
+
+/* Identifiers, and the integer and fractional parts of numbers, are runs of characters on which the DFA loops on the same
+ * state (S1, S2 and S4 respectively). Rather than taking a DFA step per character, such runs are consumed in bulk by the
+ * following functions, which return the index following the run starting at the specified index. Using SSE2, 16
+ * characters are classified at a time, which is why the source is padded (see the constructor).
+ */
+#ifdef TL_LEXER_SSE2
+// Sets each byte of the result for which lo <= v < lo + n (as unsigned characters)
+static inline __m128i in_range(__m128i v, char lo, char n){
+    const __m128i bias = _mm_set1_epi8((char) 0x80);
+    return _mm_cmplt_epi8(_mm_xor_si128(_mm_sub_epi8(v, _mm_set1_epi8(lo)), bias), _mm_xor_si128(_mm_set1_epi8(n), bias));
+}
+
+static unsigned long int skip_identifier(const char* src, unsigned long int index){
+    while(true){
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + index));
+        __m128i letter = in_range(_mm_or_si128(v, _mm_set1_epi8(0x20)), 'a', 26); // setting bit 5 maps 'A'-'Z' to 'a'-'z'
+        __m128i digit = in_range(v, '0', 10);
+        __m128i underscore = _mm_cmpeq_epi8(v, _mm_set1_epi8('_'));
+
+        unsigned mask = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(letter, digit), underscore));
+        if(mask != 0xFFFF){
+            return index + __builtin_ctz(~mask);
+        }
+        index += 16;
+    }
+}
+
+static unsigned long int skip_digits(const char* src, unsigned long int index){
+    while(true){
+        unsigned mask = _mm_movemask_epi8(in_range(_mm_loadu_si128((const __m128i*) (src + index)), '0', 10));
+        if(mask != 0xFFFF){
+            return index + __builtin_ctz(~mask);
+        }
+        index += 16;
+    }
+}
+#else
+static unsigned long int skip_identifier(const char* src, unsigned long int index){
+    while(isalnum((unsigned char) src[index]) || src[index] == '_'){ index++;}
+    return index;
+}
+
+static unsigned long int skip_digits(const char* src, unsigned long int index){
+    while(isdigit((unsigned char) src[index])){ index++;}
+    return index;
+}
+#endif
+
 /* Constructor initialising a lexer instance, by initialising the index (i.e. # of characters
  * read in the source file) to 0 and the current line number to 1.
+ *
+ * The source is terminated by a '\0' character (read as the T_EOF token), which is padded by further '\0' characters
+ * such that the DFA may always read one character past the end of the source before reaching the error state, and such
+ * that runs may be scanned 16 characters at a time up to the end of the source.
  */
  lexer::lexer(string input_source){
     source = std::move(input_source);
+    source.append(16, '\0');
     index = 0;
     line = 1;
 }
 
-/* A simple function which fetches the next token, by maintaining a stack of states as traversed
- * on the DFA defined in grammarDFA. Returns true on success, false otherwise.
+/* Fetches the next token, i.e. the first token held in the lookahead ring buffer if any tokens have been peeked, or
+ * otherwise the next token scanned from the source. Returns true on success, false otherwise.
  */
 bool lexer::getNextToken(Token* token_ptr){
-    // initialisation
-    Token token;
-    token.line = 0;
-    grammarDFA::State state = grammarDFA::S0; // initial state is the starting state S0
-    auto* dfa = new grammarDFA();
+    if(ring_count > 0){
+        Lookahead& next = ring[ring_head];
+        ring_head = (ring_head + 1) % LOOKAHEAD;
+        ring_count--;
+
+        *token_ptr = next.token;
+        return next.success;
+    }
+
+    return scanNextToken(token_ptr);
+}
 
-    states_stack_clear(); // simple convenience function to clear the state stack
+/* A simple function which scans the next token by traversing the DFA defined in grammarDFA, following the maximal
+ * munch rule. Returns true on success, false otherwise.
+ *
+ * Rather than maintaining a stack of the states traversed (which are popped off to roll back to the last final state),
+ * only the last final state encountered and the corresponding position in the source are maintained, since this is all
+ * that rolling back requires. Hence no memory is allocated per token.
+ */
+bool lexer::scanNextToken(Token* token_ptr){
+    const char* src = source.data();
 
     // before traversing the DFA, we explicitly clear any initial sequence of whitespaces
-    while(isspace(source[index])){
+    while(isspace((unsigned char) src[index])){
         // in particular we ensure that is a newline character is encountered, we increment the line counter
         // otherwise this would yield incorrect syntax and semantic error line numbers later on
-        if(source[index] == '\n'){
+        if(src[index] == '\n'){
             line++;
         }
         index++;
     }
 
-    /* Fetch characters one by one from the input source, constructing the lexeme and traversing the
-     * DFA, until the resulting state is the error state S_E i.e. an invalid transition occured.
-     *
-     * While doing so, we append the characters to the token.lexeme string, constructing the lexeme.
+    unsigned long int start = index;
+    grammarDFA::State state = grammarDFA::S0; // initial state is the starting state S0
+
+    // rollback buffer: the last final state encountered, and the index following the corresponding lexeme
+    grammarDFA::State final_state = grammarDFA::S0;
+    unsigned long int final_index = start;
+
+    /* Fetch characters one by one from the input source, traversing the DFA until the resulting state is the error state
+     * S_E i.e. an invalid transition occured, recording each final state encountered along the way.
      */
     while(state != grammarDFA::S_E){
-        token.lexeme += source[index]; // construct lexeme
-
-        // we maintain a cleared state stack unless the current lexeme has no attributed meaning (T_INVALID)
-        // i.e. if not at some final state of the DFA
-        if(dfa->state_tok(state, &token.lexeme) != grammarDFA::T_INVALID){
-            states_stack_clear();
+        if(grammarDFA::is_final(state)){
+            final_state = state;
+            final_index = index;
         }
 
-        states_stack.push(state);
-        state = dfa->transition(state, source[index]);
-
+        state = grammarDFA::transition(state, src[index]);
         index++;
+
+        // consume any run of characters on which the state loops in bulk (see above)
+        if(state == grammarDFA::S1){
+            index = skip_identifier(src, index);
+        }
+        else if(state == grammarDFA::S2 || state == grammarDFA::S4){
+            index = skip_digits(src, index);
+        }
     }
 
-    // Call the rollback loop, which restores the lexer to the last encountered valid final state
-    while(rollback(&token, &state));
+    // Roll back to the last encountered final state (if any; otherwise, final_state is S0 and tokenisation fails)
+    index = final_index;
+    string_view lexeme(src + start, final_index - start);
+    grammarDFA::Symbol symbol = grammarDFA::state_tok(final_state, lexeme);
 
-    // If rollback was successful, then the current state should not be attributed to a T_INVALID token
-    if(dfa->state_tok(state, &token.lexeme) != grammarDFA::T_INVALID){
+    // If rollback was successful, then the state should not be attributed to a T_INVALID token
+    if(symbol != grammarDFA::T_INVALID){
         // populate token with the final attributed meaning of the lexeme and line number
-        token.symbol = dfa->state_tok(state, &token.lexeme);
-        token.line = line;
+        token_ptr->symbol = symbol;
+        token_ptr->line = line;
 
         // comment may terminate with \n or \0; these must be truncated from lexeme
-        if(token.symbol == grammarDFA::T_COMMENT && (token.lexeme.back() == '\n' || token.lexeme.back() == '\0')){
-            token.lexeme = token.lexeme.substr(0,token.lexeme.length()-1);
+        if(symbol == grammarDFA::T_COMMENT && (lexeme.back() == '\n' || lexeme.back() == '\0')){
+            lexeme.remove_suffix(1);
             index--;
         }
-        else if(token.symbol == grammarDFA::T_STRING || token.symbol == grammarDFA::T_COMMENT){
-            for(char c : token.lexeme){
+        else if(symbol == grammarDFA::T_STRING || symbol == grammarDFA::T_COMMENT){
+            for(char c : lexeme){
                 if(c == '\n'){
                     line++;
                 }
             }
         }
+        else if(symbol == grammarDFA::T_EOF){
+            index--; // remain at the end of the source, such that any further calls also fetch T_EOF
+        }
 
-        // lastly we set the passed Token pointer to the resulting Token instance
-        *token_ptr = token;
+        token_ptr->lexeme = lexeme;
         return true; // and return true on successful fetching of the token
     }
     else{ // otherwise rollback failed and we return false
@@ -88,63 +174,43 @@ bool lexer::getNextToken(Token* token_ptr){
     }
 }
 
-/* Fetches the next k tokens, and then restores the internal state of the lexer to that
- * before the call to peekTokens. Note that we inherently ignore comment tokens here, i.e.
- * we fetch k non-comment tokens.
+/* Fetches the next k tokens, without consuming them, i.e. any subsequent calls to getNextToken fetch the same tokens.
+ * Note that we inherently ignore comment tokens here, i.e. we fetch k non-comment tokens; comment tokens scanned while
+ * peeking are discarded (since they are ignored by the parser).
+ *
+ * Tokens are scanned only if not already held in the lookahead ring buffer, and are added to it; hence, repeatedly
+ * peeking the same tokens does not re-scan the source.
  *
- * Returns true on success, false otherwise (when tokenisation fails, incl. if the EOF is
- * reached before the requested k tokens are fetched).
+ * Returns true on success, false otherwise (when tokenisation fails, incl. if the EOF is reached before the requested k
+ * tokens are fetched).
  */
  bool lexer::peekTokens(Token* token_array, int k){
-     // maintain internal state of lexer before call to peekTokens
-    unsigned long int curr_index = index;
-    unsigned int curr_line = line;
-    bool ret = true;
+    if(k > LOOKAHEAD){
+        throw std::runtime_error("Lexer cannot peek more than " + std::to_string(LOOKAHEAD) + " tokens...exiting...");
+    }
 
-    // Repeatedly call getNextToken until k non-comment tokens are fetched or tokensiation fails
-    for(int i = 0; i < k; i++){
-        if(!getNextToken(token_array + i)){ // this call changes the internal state of the lexer
-            ret = false;
-            break;
+    // scan tokens into the ring buffer until it holds k tokens, or until tokenisation fails
+    while(ring_count < k){
+        if(ring_count > 0 && !ring[(ring_head + ring_count - 1) % LOOKAHEAD].success){
+            return false;
         }
 
-        if((token_array + i)->symbol == grammarDFA::T_COMMENT){
-            i--; // ignore comment
+        Lookahead& next = ring[(ring_head + ring_count) % LOOKAHEAD];
+        next.success = scanNextToken(&next.token);
+
+        if(!next.success || next.token.symbol != grammarDFA::T_COMMENT){
+            ring_count++; // otherwise ignore comment
         }
     }
 
-    // restore the internal state of the lexer
-    index = curr_index;
-    line = curr_line;
-    return ret;
-}
+    for(int i = 0; i < k; i++){
+        Lookahead& peeked = ring[(ring_head + i) % LOOKAHEAD];
+        if(!peeked.success){
+            return false;
+        }
 
-// Simple function that 'clears' the state stack
-void lexer::states_stack_clear(){
-    while(!states_stack.empty()){
-        states_stack.pop();
+        token_array[i] = peeked.token;
     }
-}
-
-/* The rollback function, which pops off the top state from the state stack, decrements the char
- * pointer in the soource file by 1 and truncates the lexeme by 1 character.
- *
- * Returns true if internal state of the lexer has not been restored to the last occurring final
- * state of the DFA, otherwise it returns false.
- */
-bool lexer::rollback(Token* token_ptr, grammarDFA::State* state_ptr){
-    if(!states_stack.empty()){ // if not restored to last occurring final state
-        *state_ptr = states_stack.top(); // maintain reference to state
 
-        states_stack.pop(); // pop off state
-        // truncate the lexeme by 1 character to restore it to a valid lexeme
-        token_ptr->lexeme = token_ptr->lexeme.substr(0,token_ptr->lexeme.length()-1);
-
-        index--; // and decrement char reference in source file
-
-        return true;
-    }
-    else{
-        return false;
-    }
-}
\ No newline at end of file
+    return true;
+}
@@ -6,7 +6,7 @@
 #define CPS2000_LEXER_H
 
 #include <string>
-#include <stack>
+#include <string_view>
 #include <vector>
 #include "grammarDFA.h"
 
@@ -14,25 +14,39 @@ using namespace std;
 
 class lexer{
 public:
+    /* Lexemes are slices of the source buffer held by the lexer (rather than strings built character by character), and
+     * hence are only valid for the lifetime of the lexer instance; the parser copies lexemes into the AST as need be.
+     */
     struct Token{
         grammarDFA::Symbol symbol;
-        string lexeme;
+        string_view lexeme;
         unsigned int line;
     };
 
+    // maximum number of tokens which may be peeked (the parser requires at most 3)
+    static constexpr int LOOKAHEAD = 4;
+
     bool getNextToken(Token*);
     bool peekTokens(Token*, int);
     explicit lexer(string);
 
 private:
-    stack<grammarDFA::State> states_stack;
+    /* Tokens which have been peeked are held in a ring buffer (of the LOOKAHEAD tokens following the last token fetched),
+     * from which they are subsequently fetched, such that each character of the source is scanned exactly once.
+     */
+    struct Lookahead{
+        Token token;
+        bool success; // false if scanning failed, in which case fetching the token also fails
+    };
+
+    Lookahead ring[LOOKAHEAD];
+    int ring_head = 0, ring_count = 0;
+
+    bool scanNextToken(Token*);
 
     unsigned long int index;
     unsigned int line;
     string source;
-
-    bool rollback(Token*, grammarDFA::State*);
-    void states_stack_clear();
 };
 
 #endif //CPS2000_LEXER_H
@@ -0,0 +1,536 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "loop_hoister.h"
+
+// ----- FUNCTION SUMMARIES -----
+
+// Summarises the body of each function declared in the subtree (including nested and member functions)
+void loop_hoister::summarise_functions(astNode* node){
+    if(node == nullptr || node->kind == astNode::T_TYPE || node->kind == astNode::LITERAL ||
+       node->kind == astNode::T_IDENTIFIER){
+        return;
+    }
+
+    if(node->kind == astNode::FUNC_DECL){
+        auto* function_block = (astBLOCK*) ((astFUNC_DECL*) node)->children.at(3);
+        summarise(function_block, functions[function_block]);
+    }
+
+    for(auto &c : ((astInnerNode*) node)->children){
+        summarise_functions(c);
+    }
+}
+
+/* Records the effects of the statements and expressions in the subtree within the body of a function, along with the
+ * functions called (the effects of which are propagated once all functions are summarised). Nested function and tlstruct
+ * definitions are not executed by the function itself, and are hence skipped.
+ */
+void loop_hoister::summarise(astNode* node, function_summary& summary){
+    if(node == nullptr){
+        return;
+    }
+
+    switch(node->kind){
+        case astNode::T_TYPE:
+        case astNode::LITERAL:
+        case astNode::FUNC_DECL:
+        case astNode::TLS_DECL:
+            return;
+        case astNode::T_IDENTIFIER:{
+            int depth = ((astIDENTIFIER*) node)->depth;
+
+            if(depth == -1){ summary.reads_heap = true;}
+            else if(depth > 0){ summary.closed = false;}
+            return;
+        }
+        case astNode::PRINT:
+            summary.pure = false;
+            break;
+        case astNode::ASSIGNMENT:{
+            // only assignments to variables in the frame of the function itself are free of side effects
+            auto* assignment = dynamic_cast<astASSIGNMENT_IDENTIFIER*>(node);
+            if(assignment == nullptr || ((astIDENTIFIER*) assignment->children.at(0))->depth != 0){
+                summary.pure = false;
+            }
+            break;
+        }
+        case astNode::VAR_DECL:
+        case astNode::ARR_DECL:{
+            // tlstruct instances are initialised by executing the definition block, which may have side effects
+            auto* type = (astTYPE*) ((astInnerNode*) node)->children.at(node->kind == astNode::VAR_DECL ? 1 : 2);
+            if(type != nullptr && type->type == grammarDFA::T_TLSTRUCT){
+                summary.pure = false;
+            }
+            break;
+        }
+        case astNode::ELEMENT:
+        case astNode::MEMBER_ACCESS:
+            summary.reads_heap = true;
+            break;
+        case astNode::FUNC_CALL:{
+            auto* call = (astFUNC_CALL*) node;
+            summary.callees.push_back(call->callee->func_ref);
+            summarise(call->children.at(1), summary); // i.e. the actual parameters, rather than the identifier
+            return;
+        }
+        default:
+            break;
+    }
+
+    for(auto &c : ((astInnerNode*) node)->children){
+        summarise(c, summary);
+    }
+}
+
+// Returns the summary of the function called, or nullptr if the function is not known (and hence assumed impure)
+const loop_hoister::function_summary* loop_hoister::summary_of(funcSymbol* func){
+    auto it = functions.find(func->func_ref);
+    return it != functions.end() ? &it->second : nullptr;
+}
+
+// ----- LOOP WRITE SETS -----
+
+void loop_hoister::write(astIDENTIFIER* identifier, loop_info& loop){
+    if(identifier->depth == -1){ // i.e. a member of a tlstruct instance
+        loop.heap_written = true;
+    }
+    else{
+        loop.writes.insert(frame_address(identifier->depth, identifier->slot));
+    }
+}
+
+// Records the variables (or heap) written by the statements and expressions in the subtree within a loop
+void loop_hoister::collect_writes(astNode* node, loop_info& loop){
+    if(node == nullptr){
+        return;
+    }
+
+    switch(node->kind){
+        case astNode::T_TYPE:
+        case astNode::LITERAL:
+        case astNode::T_IDENTIFIER:
+        case astNode::FUNC_DECL:
+        case astNode::TLS_DECL:
+            return;
+        case astNode::ASSIGNMENT:
+            if(auto* assignment = dynamic_cast<astASSIGNMENT_IDENTIFIER*>(node)){
+                write((astIDENTIFIER*) assignment->children.at(0), loop);
+            }
+            else{ // i.e. an array element or a member of a tlstruct instance
+                loop.heap_written = true;
+            }
+            break;
+        case astNode::VAR_DECL:
+        case astNode::ARR_DECL:{
+            auto* decl = (astInnerNode*) node;
+            auto* type = (astTYPE*) decl->children.at(node->kind == astNode::VAR_DECL ? 1 : 2);
+
+            write((astIDENTIFIER*) decl->children.at(0), loop);
+            if(type != nullptr && type->type == grammarDFA::T_TLSTRUCT){
+                loop.opaque = true;
+            }
+            break;
+        }
+        case astNode::FUNC_CALL:{
+            const function_summary* summary = summary_of(((astFUNC_CALL*) node)->callee);
+            if(summary == nullptr || !summary->pure){
+                loop.opaque = true;
+            }
+
+            collect_writes(((astFUNC_CALL*) node)->children.at(1), loop);
+            return;
+        }
+        default:
+            break;
+    }
+
+    for(auto &c : ((astInnerNode*) node)->children){
+        collect_writes(c, loop);
+    }
+}
+
+// Enters a loop, the body of which (i.e. everything executed on each iteration) consists of the children from first_child
+void loop_hoister::push_loop(astInnerNode* node, size_t first_child, int* hoisted_first, int* n_hoisted){
+    loop_info loop;
+    loop.hoisted_first = hoisted_first;
+    loop.n_hoisted = n_hoisted;
+
+    for(size_t i = first_child; i < node->children.size(); i++){
+        collect_writes(node->children.at(i), loop);
+    }
+
+    frames.back().loops.push_back(std::move(loop));
+}
+
+// Exits a loop, allocating the slots caching the expressions hoisted out of it at the end of the frame
+void loop_hoister::pop_loop(){
+    frame_context& frame = frames.back();
+    loop_info& loop = frame.loops.back();
+
+    *loop.hoisted_first = *frame.frame_size;
+    *loop.n_hoisted = (int) loop.hoisted.size();
+
+    for(astHOISTED* hoisted : loop.hoisted){
+        hoisted->slot = (*frame.frame_size)++;
+    }
+
+    frame.loops.pop_back();
+}
+
+// ----- INVARIANT EXPRESSIONS -----
+
+/* Records the variables read by an expression, returning false if the expression cannot be hoisted (i.e. it assigns, or
+ * calls a function which is impure or reads variables outside its frame).
+ */
+bool loop_hoister::analyse(astNode* node, expr_info& info){
+    switch(node->kind){
+        case astNode::LITERAL:
+            return true;
+        case astNode::T_IDENTIFIER:{
+            auto* identifier = (astIDENTIFIER*) node;
+
+            if(identifier->depth == -1){ info.reads_heap = true;}
+            else{ info.reads.emplace_back(identifier->depth, identifier->slot);}
+            return true;
+        }
+        case astNode::ELEMENT:{
+            auto* element = (astELEMENT*) node;
+
+            info.reads_heap = true;
+            info.cost += 2;
+            return analyse(element->children.at(0), info) && analyse(element->children.at(1), info);
+        }
+        case astNode::MULTOP:
+        case astNode::ADDOP:
+        case astNode::RELOP:{
+            auto* binop = (astBinaryOp*) node;
+
+            info.cost += 1;
+            return binop->object_class == grammarDFA::SINGLETON && analyse(binop->children.at(0), info) &&
+                   analyse(binop->children.at(1), info);
+        }
+        case astNode::UNARY:
+            info.cost += 1;
+            return ((astUNARY*) node)->object_class == grammarDFA::SINGLETON &&
+                   analyse(((astUNARY*) node)->children.at(0), info);
+        case astNode::SUBEXPR:
+            return analyse(((astSUBEXPR*) node)->children.at(0), info);
+        case astNode::FUNC_CALL:
+            return analyse_call((astFUNC_CALL*) node, info);
+        case astNode::MEMBER_ACCESS:{
+            auto* member_access = (astMEMBER_ACCESS*) node;
+            astNode* member = member_access->children.at(1);
+
+            info.reads_heap = true;
+            info.cost += 2;
+            analyse(member_access->children.at(0), info); // i.e. the tlstruct instance
+
+            if(member->kind == astNode::ELEMENT){
+                return analyse(((astELEMENT*) member)->children.at(1), info);
+            }
+            else if(member->kind == astNode::FUNC_CALL){
+                return analyse_call((astFUNC_CALL*) member, info);
+            }
+
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+bool loop_hoister::analyse_call(astFUNC_CALL* node, expr_info& info){
+    const function_summary* summary = summary_of(node->callee);
+    if(summary == nullptr || !summary->pure || !summary->closed){
+        return false;
+    }
+
+    info.reads_heap = info.reads_heap || summary->reads_heap;
+    info.cost += 10;
+
+    auto* aparams = (astInnerNode*) node->children.at(1);
+    if(aparams != nullptr){
+        for(auto &c : aparams->children){
+            if(!analyse(c, info)){
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Returns true if the expression yields a singular value of a primitive type, i.e. one which can be cached as is
+bool loop_hoister::scalar(astNode* node){
+    grammarDFA::Symbol type;
+
+    switch(node->kind){
+        case astNode::ELEMENT:
+            type = ((astELEMENT*) node)->type;
+            break;
+        case astNode::MEMBER_ACCESS:
+            if(((astMEMBER_ACCESS*) node)->object_class != grammarDFA::SINGLETON){ return false;}
+            type = ((astMEMBER_ACCESS*) node)->type;
+            break;
+        case astNode::FUNC_CALL:
+            if(((astFUNC_CALL*) node)->callee->ret_obj_class != grammarDFA::SINGLETON){ return false;}
+            type = ((astFUNC_CALL*) node)->callee->type.first;
+            break;
+        case astNode::MULTOP:
+        case astNode::ADDOP:
+        case astNode::RELOP:
+            return ((astBinaryOp*) node)->object_class == grammarDFA::SINGLETON;
+        case astNode::UNARY:
+            return ((astUNARY*) node)->object_class == grammarDFA::SINGLETON;
+        case astNode::SUBEXPR:
+            return scalar(((astSUBEXPR*) node)->children.at(0));
+        default: // variables and literals are not worth caching
+            return false;
+    }
+
+    return type == grammarDFA::T_BOOL || type == grammarDFA::T_INT || type == grammarDFA::T_FLOAT ||
+           type == grammarDFA::T_CHAR || type == grammarDFA::T_STRING;
+}
+
+bool loop_hoister::invariant(const expr_info& info, const loop_info& loop){
+    if(loop.opaque || (info.reads_heap && loop.heap_written)){
+        return false;
+    }
+
+    for(const frame_address& address : info.reads){
+        if(loop.writes.count(address) != 0){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ----- HOISTING UTILITY FUNCTIONS -----
+
+/* Hoists the expression at position i of an internal node out of the outermost enclosing loop (of the same frame) in
+ * which it is invariant; if it is not invariant in any enclosing loop, its sub-expressions are considered instead.
+ */
+void loop_hoister::hoist_child(astInnerNode* node, size_t i){
+    astNode* child = node->children.at(i);
+    if(child == nullptr){
+        return;
+    }
+
+    vector<loop_info>& loops = frames.back().loops;
+
+    expr_info info;
+    if(!loops.empty() && scalar(child) && analyse(child, info) && info.cost >= MIN_COST){
+        for(loop_info& loop : loops){ // outermost first, since an expression invariant in a loop is so in nested loops
+            if(invariant(info, loop)){
+                auto* hoisted = arena->make<astHOISTED>(child, -1, child->line);
+                loop.hoisted.push_back(hoisted);
+                node->children.at(i) = hoisted;
+                n_hoisted++;
+
+                return;
+            }
+        }
+    }
+
+    hoist_children(child);
+}
+
+// Considers each sub-expression of an expression for hoisting
+void loop_hoister::hoist_children(astNode* node){
+    switch(node->kind){
+        case astNode::MULTOP:
+        case astNode::ADDOP:
+        case astNode::RELOP:
+            hoist_child((astInnerNode*) node, 0);
+            hoist_child((astInnerNode*) node, 1);
+            break;
+        case astNode::UNARY:
+        case astNode::SUBEXPR:
+            hoist_child((astInnerNode*) node, 0);
+            break;
+        case astNode::ELEMENT:
+            hoist_child((astInnerNode*) node, 1); // i.e. the index
+            break;
+        case astNode::FUNC_CALL:
+            hoist_args((astFUNC_CALL*) node);
+            break;
+        case astNode::MEMBER_ACCESS:{
+            // the member itself is looked up in the tlstruct instance, hence only the index or parameters are considered
+            astNode* member = ((astMEMBER_ACCESS*) node)->children.at(1);
+
+            if(member->kind == astNode::ELEMENT){ hoist_child((astInnerNode*) member, 1);}
+            else if(member->kind == astNode::FUNC_CALL){ hoist_args((astFUNC_CALL*) member);}
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void loop_hoister::hoist_args(astFUNC_CALL* node){
+    auto* aparams = (astInnerNode*) node->children.at(1);
+
+    if(aparams != nullptr){
+        for(size_t i = 0; i < aparams->children.size(); i++){
+            hoist_child(aparams, i);
+        }
+    }
+}
+
+// Traverses the statements of a block executed in a frame of its own, i.e. a function or tlstruct definition block
+void loop_hoister::traverse_frame(astBLOCK* block, int* frame_size){
+    frames.push_back(frame_context{frame_size, {}});
+
+    for(auto &c : block->children){
+        c->accept(this);
+    }
+
+    frames.pop_back();
+}
+
+// ----- LOOP HOISTER VISITOR RULES -----
+
+// expressions are only visited as statements (i.e. function calls), and are otherwise considered through hoist_child
+void loop_hoister::visit(astTYPE* node){}
+void loop_hoister::visit(astLITERAL* node){}
+void loop_hoister::visit(astIDENTIFIER* node){}
+void loop_hoister::visit(astELEMENT* node){}
+void loop_hoister::visit(astMULTOP* node){}
+void loop_hoister::visit(astADDOP* node){}
+void loop_hoister::visit(astRELOP* node){}
+void loop_hoister::visit(astAPARAMS* node){}
+
+void loop_hoister::visit(astFUNC_CALL* node){
+    hoist_args(node);
+}
+
+void loop_hoister::visit(astSUBEXPR* node){}
+void loop_hoister::visit(astUNARY* node){}
+
+void loop_hoister::visit(astASSIGNMENT_IDENTIFIER* node){
+    hoist_child(node, 1);
+}
+
+void loop_hoister::visit(astASSIGNMENT_ELEMENT* node){
+    hoist_child((astInnerNode*) node->children.at(0), 1); // i.e. the index of the element assigned
+    hoist_child(node, 1);
+}
+
+// the expressions assigned to members are evaluated with the members of the tlstruct instance in scope, hence are skipped
+void loop_hoister::visit(astASSIGNMENT_MEMBER* node){}
+
+void loop_hoister::visit(astVAR_DECL* node){
+    hoist_child(node, 2);
+}
+
+void loop_hoister::visit(astARR_DECL* node){
+    for(size_t i = 1; i < node->children.size(); i++){ // i.e. the size and the elements being assigned (skipping the type)
+        if(i != 2){ hoist_child(node, i);}
+    }
+}
+
+void loop_hoister::visit(astTLS_DECL* node){
+    auto* tls_block = (astBLOCK*) node->children.at(1);
+    traverse_frame(tls_block, &tls_block->frame_size);
+}
+
+void loop_hoister::visit(astPRINT* node){
+    hoist_child(node, 0);
+}
+
+void loop_hoister::visit(astRETURN* node){
+    hoist_child(node, 0);
+}
+
+void loop_hoister::visit(astIF* node){
+    hoist_child(node, 0);
+    node->children.at(1)->accept(this);
+    if(node->children.at(2) != nullptr){ node->children.at(2)->accept(this);}
+}
+
+// The declaration is executed once, before entering the loop, and hence is considered in the enclosing loops (if any)
+void loop_hoister::visit(astFOR* node){
+    if(node->children.at(0) != nullptr){ node->children.at(0)->accept(this);}
+
+    push_loop(node, 1, &node->hoisted_first, &node->n_hoisted);
+
+    hoist_child(node, 1);
+    if(node->children.at(2) != nullptr){ node->children.at(2)->accept(this);}
+    node->children.at(3)->accept(this);
+
+    pop_loop();
+}
+
+void loop_hoister::visit(astPAR_FOR* node){
+    visit((astFOR*) node);
+}
+
+void loop_hoister::visit(astWHILE* node){
+    push_loop(node, 0, &node->hoisted_first, &node->n_hoisted);
+
+    hoist_child(node, 0);
+    if(node->children.at(1) != nullptr){ node->children.at(1)->accept(this);}
+
+    pop_loop();
+}
+
+void loop_hoister::visit(astFPARAMS* node){}
+void loop_hoister::visit(astFPARAM* node){}
+
+void loop_hoister::visit(astFUNC_DECL* node){
+    auto* function_block = (astBLOCK*) node->children.at(3);
+    traverse_frame(function_block, &function_block->frame_size);
+}
+
+void loop_hoister::visit(astMEMBER_ACCESS* node){
+    hoist_children(node);
+}
+
+void loop_hoister::visit(astBLOCK* node){
+    for(auto &c : node->children){
+        c->accept(this);
+    }
+}
+
+/* Prior to traversing the program, every function is summarised, after which the effects of the functions called by each
+ * function are propagated until a fixed point is reached (since functions may be recursive).
+ */
+void loop_hoister::visit(astPROGRAM* node){
+    summarise_functions(node);
+
+    bool changed = true;
+    while(changed){
+        changed = false;
+
+        for(auto &func : functions){
+            function_summary& summary = func.second;
+
+            for(astBLOCK* callee : summary.callees){
+                auto it = functions.find(callee);
+                bool pure = summary.pure && it != functions.end() && it->second.pure;
+                bool closed = summary.closed && it != functions.end() && it->second.closed;
+                bool reads_heap = summary.reads_heap || (it != functions.end() && it->second.reads_heap);
+
+                if(pure != summary.pure || closed != summary.closed || reads_heap != summary.reads_heap){
+                    summary.pure = pure;
+                    summary.closed = closed;
+                    summary.reads_heap = reads_heap;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    frames.push_back(frame_context{&node->frame_size, {}});
+
+    for(auto &c : node->children){
+        c->accept(this);
+    }
+
+    frames.pop_back();
+}
+
+void loop_hoister::visit(astHOISTED* node){}
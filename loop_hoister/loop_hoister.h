@@ -0,0 +1,137 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_LOOP_HOISTER_H
+#define CPS2000_LOOP_HOISTER_H
+
+#include <set>
+#include <unordered_map>
+#include "../symbol_table/symbol.h"
+#include "../visitor_ast/astNode.h"
+#include "../visitor_ast/ast_arena.h"
+#include "../visitor_ast/visitor.h"
+
+/* Carries out loop-invariant code motion on a (semantically checked and resolved) abstract syntax tree, such that pure
+ * expressions whose operands do not change within a for or while loop are evaluated once per entry into the loop, rather
+ * than upon every iteration.
+ *
+ * An expression within a loop (i.e. in the condition, the for-assignment or the body) is invariant in the loop if:
+ * (i)   it is built only from literals, variables, array elements, members, operators and calls to pure functions, and
+ *       yields a singular int, float, bool, char or string (arrays and tlstruct instances are never hoisted);
+ * (ii)  none of the variables it reads (by frame address, see resolver.h) are assigned or declared within the loop;
+ * (iii) if it reads arrays or tlstruct members, no array element or member is assigned within the loop;
+ * (iv)  the loop does not call an impure function, nor instantiate a tlstruct (whose definition block may have effects).
+ * A function is pure if it (and every function it calls) neither prints, nor assigns variables outside its own frame,
+ * array elements or members, nor instantiates a tlstruct; moreover only functions which do not read variables outside
+ * their own frame (other than through their parameters) are hoisted, since the variables they read are not known.
+ *
+ * Each maximal invariant expression (of sufficient cost) is wrapped in an astHOISTED node, attached to the outermost loop
+ * in which it is invariant. The node is evaluated lazily, i.e. upon its first evaluation since entering the loop, with
+ * its result cached in a slot appended to the frame of the enclosing function (or tlstruct definition, or main program).
+ * Hence no expression is evaluated which would not otherwise have been evaluated, and side effects and run-time errors
+ * occur exactly as they would without hoisting.
+ */
+class loop_hoister: public visitor{
+public:
+    void visit(astTYPE* node) override;
+    void visit(astLITERAL* node) override;
+    void visit(astIDENTIFIER* node) override;
+    void visit(astELEMENT* node) override;
+    void visit(astMULTOP* node) override;
+    void visit(astADDOP* node) override;
+    void visit(astRELOP* node) override;
+    void visit(astAPARAMS* node) override;
+    void visit(astFUNC_CALL* node) override;
+    void visit(astSUBEXPR* node) override;
+    void visit(astUNARY* node) override;
+    void visit(astASSIGNMENT_IDENTIFIER* node) override;
+    void visit(astASSIGNMENT_ELEMENT* node) override;
+    void visit(astASSIGNMENT_MEMBER* node) override;
+    void visit(astVAR_DECL* node) override;
+    void visit(astARR_DECL* node) override;
+    void visit(astTLS_DECL* node) override;
+    void visit(astPRINT* node) override;
+    void visit(astRETURN* node) override;
+    void visit(astIF* node) override;
+    void visit(astFOR* node) override;
+    void visit(astPAR_FOR* node) override;
+    void visit(astWHILE* node) override;
+    void visit(astFPARAMS* node) override;
+    void visit(astFPARAM* node) override;
+    void visit(astFUNC_DECL* node) override;
+    void visit(astMEMBER_ACCESS* node) override;
+    void visit(astBLOCK* node) override;
+    void visit(astPROGRAM* node) override;
+    void visit(astHOISTED* node) override;
+
+    explicit loop_hoister(ast_arena* arena){
+        this->arena = arena;
+    }
+
+    int n_hoisted = 0; // number of expressions hoisted
+
+private:
+    /* The minimum cost of an expression worth hoisting, where operators cost 1, array elements and members cost 2, and
+     * function calls cost 10; eg. a*b is not worth caching, whereas a*b+c, arr[0] or v.x are.
+     */
+    static constexpr int MIN_COST = 2;
+
+    typedef pair<int, int> frame_address; // (depth, slot), as set by the resolver
+
+    // summary of the effects of a function (including those of the functions it calls)
+    struct function_summary{
+        bool pure = true; // no output, and no writes outside its frame (nor tlstruct instantiations)
+        bool closed = true; // reads no variables outside its frame
+        bool reads_heap = false; // reads array elements or tlstruct members
+        vector<astBLOCK*> callees;
+    };
+
+    // the variables (and heap) written by a loop being traversed, and the expressions hoisted out of it
+    struct loop_info{
+        set<frame_address> writes;
+        bool heap_written = false;
+        bool opaque = false; // calls an impure function, hence nothing is invariant
+        int* hoisted_first;
+        int* n_hoisted;
+        vector<astHOISTED*> hoisted;
+    };
+
+    // the frame of the function (or tlstruct definition, or main program) being traversed, and its enclosing loops
+    struct frame_context{
+        int* frame_size;
+        vector<loop_info> loops;
+    };
+
+    // what an expression reads, and whether it can be hoisted at all
+    struct expr_info{
+        vector<frame_address> reads;
+        bool reads_heap = false;
+        int cost = 0;
+    };
+
+    ast_arena* arena;
+    unordered_map<astBLOCK*, function_summary> functions;
+    vector<frame_context> frames;
+
+    void summarise_functions(astNode* node);
+    void summarise(astNode* node, function_summary& summary);
+    const function_summary* summary_of(funcSymbol* func);
+
+    void push_loop(astInnerNode* node, size_t first_child, int* hoisted_first, int* n_hoisted);
+    void pop_loop();
+    void collect_writes(astNode* node, loop_info& loop);
+    static void write(astIDENTIFIER* identifier, loop_info& loop);
+
+    bool analyse(astNode* node, expr_info& info);
+    bool analyse_call(astFUNC_CALL* node, expr_info& info);
+    static bool scalar(astNode* node);
+    static bool invariant(const expr_info& info, const loop_info& loop);
+
+    void hoist_child(astInnerNode* node, size_t i);
+    void hoist_children(astNode* node);
+    void hoist_args(astFUNC_CALL* node);
+    void traverse_frame(astBLOCK* block, int* frame_size);
+};
+
+#endif //CPS2000_LOOP_HOISTER_H
@@ -1,29 +1,164 @@
+#include <chrono>
+#include <cstring>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <unistd.h>
 #include "lexer/lexer.h"
 #include "parser/parser.h"
 #include "semantic_analysis/semantic_analysis.h"
 #include "semantic_analysis/graphviz_example/graphviz_ast_visitor.h"
+#include "constant_folder/constant_folder.h"
+#include "resolver/resolver.h"
+#include "loop_hoister/loop_hoister.h"
 #include "interpreter/interpreter.h"
+#include "vm/bytecode_compiler.h"
+#include "vm/program_image.h"
+#include "vm/virtual_machine.h"
+#include "output_sink/output_sink.h"
+
+/* Tokenises the entire source, reporting the throughput of the lexer (in MB/s) rather than executing the program. The
+ * source is tokenised repeatedly for at least a second, such that small sources are timed reliably.
+ */
+static void benchmark_lexer(const string& source){
+    double elapsed = 0;
+    long n_tokens = 0, n_passes = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    while(elapsed < 1.0){
+        lexer lex(source);
+        lexer::Token token{};
+
+        do{
+            if(!lex.getNextToken(&token)){
+                throw std::runtime_error("Lexer encountered an error while fetching the next token...exiting...");
+            }
+            n_tokens++;
+        }while(token.symbol != grammarDFA::T_EOF);
+
+        n_passes++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double megabytes = (double) source.size() * n_passes / 1e6;
+    std::cout << "lexer: " << n_tokens / n_passes << " tokens, " << (double) source.size() / 1e6 << " MB per pass, "
+    << n_passes << " passes in " << elapsed << " s: " << megabytes / elapsed << " MB/s" << std::endl;
+}
+
+/* Tokenises and parses the entire source, reporting the throughput of the front-end (in MB/s) rather than executing the
+ * program. As for the lexer, the source is parsed repeatedly for at least a second; the abstract syntax tree of each pass
+ * is freed along with its parser (i.e. its arena), such that the memory reported is that of a single tree.
+ */
+static void benchmark_parser(const string& source){
+    double elapsed = 0;
+    long n_passes = 0, n_nodes = 0;
+    size_t arena_bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    while(elapsed < 1.0){
+        lexer lex(source);
+        parser par(&lex);
+
+        if(par.err_count > 0){
+            throw std::runtime_error("Syntax errors encountered, see trace above.");
+        }
+
+        n_nodes = (long) par.arena.n_nodes;
+        arena_bytes = par.arena.reserved();
+        n_passes++;
+        elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    double megabytes = (double) source.size() * n_passes / 1e6;
+    std::cout << "parser: " << n_nodes << " AST nodes (" << (double) arena_bytes / 1e6 << " MB arena), "
+    << (double) source.size() / 1e6 << " MB per pass, " << n_passes << " passes in " << elapsed << " s: " << megabytes / elapsed << " MB/s" << std::endl;
+}
+
+// Maximum number of active calls by default, such that runaway recursion is reported rather than exhausting memory
+static constexpr size_t DEFAULT_MAX_DEPTH = 1 << 20;
+
+// Interval (in milliseconds) at which the output of print statements is flushed by default, if not written to a terminal
+static constexpr long DEFAULT_FLUSH_INTERVAL = 100;
+
+// Maximum number of threads executing parallel for loops
+static constexpr long MAX_THREADS = 1024;
 
 /* Main class running the entire compilation pipeline. Execute as:
- * ./main <source> [-v=1]
+ * ./main <source> [-v=1] [-vm=1] [-cache=1] [-depth=N] [-flush=MS] [-threads=N] [-bench=lex|parse]
  * where <source> is an absolute file path to a .txt file with TeaLang source and -v=1 is an optional flag which if set,
- * a .dot file is outputted with graphviz code representing the abstract syntax tree.
+ * a .dot file is outputted with graphviz code representing the abstract syntax tree. If the optional flag -vm=1 is set,
+ * the program is compiled to bytecode and executed on the virtual machine rather than by the (tree-walking) interpreter.
+ * If the optional flag -cache=1 is set, the program is likewise executed on the virtual machine, however the compiled
+ * program is cached on disk (see program_image), such that later runs of the unchanged source skip compilation.
+ * The optional flag -depth=N sets the maximum call depth (by default 2^20); on the virtual machine, call frames are held
+ * on the heap, hence recursion is only bounded by this limit (whereas the interpreter is also bounded by the native stack).
+ * Output is buffered (see output_sink) and flushed at least every MS milliseconds as set by the optional flag -flush=MS,
+ * where -flush=0 flushes every line; by default, every line is flushed when writing to a terminal, and every 100ms otherwise.
+ * The optional flag -threads=N sets the number of threads executing the iterations of parallel for loops on the
+ * interpreter (by default, the number of hardware threads), where -threads=1 executes them in sequence; the virtual
+ * machine always executes them in sequence.
+ * If the optional flag -bench=lex (or -bench=parse) is set, the throughput of the lexer (or of the lexer and parser) on
+ * the source is reported instead (see above).
  */
 int main(int argc, char *argv[]){
     bool graphviz_on = false;
+    bool vm_on = false;
+    bool cache_on = false;
+    bool bench_lex = false, bench_parse = false;
+    size_t max_depth = DEFAULT_MAX_DEPTH;
+    long flush_interval = isatty(STDOUT_FILENO) ? 0 : DEFAULT_FLUSH_INTERVAL;
+    long n_threads = max(1u, std::thread::hardware_concurrency());
 
     // option checking...
     if(argc == 1){
         throw std::runtime_error("Source file not specified...exiting...");
     }
-    else if(argc > 3){
-        throw std::runtime_error("Invalid options specified (please only specify source and optionally -v=1)...exiting...");
+    else if(argc > 9){
+        throw std::runtime_error("Invalid options specified (please only specify source and optionally -v=1, -vm=1, -cache=1, -depth=N, -flush=MS, -threads=N and -bench=lex or -bench=parse)...exiting...");
     }
-    else if(argc == 3 && strcmp(argv[2], "-v=1") == 0){
-        graphviz_on = true;
+
+    for(int i = 2; i < argc; i++){
+        if(strcmp(argv[i], "-v=1") == 0){
+            graphviz_on = true;
+        }
+        else if(strcmp(argv[i], "-vm=1") == 0){
+            vm_on = true;
+        }
+        else if(strcmp(argv[i], "-cache=1") == 0){
+            vm_on = true;
+            cache_on = true;
+        }
+        else if(strncmp(argv[i], "-depth=", 7) == 0){
+            char* end;
+            max_depth = strtoull(argv[i] + 7, &end, 10);
+
+            if(*end != '\0' || max_depth == 0){
+                throw std::runtime_error("Invalid maximum call depth specified (please specify a positive integer)...exiting...");
+            }
+        }
+        else if(strncmp(argv[i], "-flush=", 7) == 0){
+            char* end;
+            flush_interval = strtol(argv[i] + 7, &end, 10);
+
+            if(*end != '\0' || end == argv[i] + 7 || flush_interval < 0){
+                throw std::runtime_error("Invalid flush interval specified (please specify a non-negative integer)...exiting...");
+            }
+        }
+        else if(strncmp(argv[i], "-threads=", 9) == 0){
+            char* end;
+            n_threads = strtol(argv[i] + 9, &end, 10);
+
+            if(*end != '\0' || n_threads < 1 || n_threads > MAX_THREADS){
+                throw std::runtime_error("Invalid number of threads specified (please specify an integer between 1 and 1024)...exiting...");
+            }
+        }
+        else if(strcmp(argv[i], "-bench=lex") == 0){
+            bench_lex = true;
+        }
+        else if(strcmp(argv[i], "-bench=parse") == 0){
+            bench_parse = true;
+        }
     }
 
     // open file at path specified and validate
@@ -36,13 +171,13 @@ int main(int argc, char *argv[]){
     string extension;
 
     // extract filename with extentsion from the path
-    int last_slash_idx = filename.find_last_of("\\/");
+    size_t last_slash_idx = filename.find_last_of("\\/");
     if(std::string::npos != last_slash_idx){
         filename.erase(0, last_slash_idx + 1);
     }
 
     // extract extension from the path
-    int period_idx = filename.rfind('.');
+    size_t period_idx = filename.rfind('.');
     if(std::string::npos != period_idx){
         extension = filename.substr(period_idx + 1);
         filename.erase(period_idx);
@@ -53,8 +188,41 @@ int main(int argc, char *argv[]){
         throw std::runtime_error("Source file is not a TeaLang program (does not have a .tlg extension)...exiting...");
     }
 
+    string source = source_buffer.str();
+
+    if(bench_lex){
+        benchmark_lexer(source);
+        return 0;
+    }
+    else if(bench_parse){
+        benchmark_parser(source);
+        return 0;
+    }
+
+    // buffer the output of the program, which is flushed (at the latest) upon returning from main
+    output_sink out(std::cout, std::chrono::milliseconds(flush_interval));
+
+    /* If caching, run the image of a previous compilation of the same source (if any) straight away; the AST is needed
+     * to output the .dot file however, in which case the source is always compiled (and the image refreshed).
+     */
+    uint64_t source_key = 0;
+    string image_path;
+
+    if(cache_on){
+        source_key = program_image::source_key(source);
+        image_path = program_image::cache_path(argv[1]);
+
+        program_image* image = graphviz_on ? nullptr : program_image::load(image_path, source_key, source.size());
+        if(image != nullptr){
+            auto* vm = new virtual_machine(image->executable(), max_depth, &out);
+            vm->run();
+
+            return 0;
+        }
+    }
+
     // create new lexer and parser instance
-    auto* lex = new lexer(source_buffer.str());
+    auto* lex = new lexer(source);
     auto* par = new parser(lex); // carries out syntax analysis
 
     // if using graphviz, draw AST in dot format; output <filename>.dot at the source file path
@@ -69,8 +237,45 @@ int main(int argc, char *argv[]){
 
     // if no syntax or semantic error occured
     if(par->err_count == 0 && sa->err_count == 0){
-        // then interpret by creating a new interpreter instance and traversing AST via visitor design pattern
-        auto* itpr = new interpreter();
+        // decode literals and fold constant expressions by traversing AST via visitor design pattern
+        auto* cf = new constant_folder(&par->arena);
+        par->root->accept(cf);
+
+        if(cf->err_count > 0){
+            return 1;
+        }
+
+        // resolve identifiers to frame slots by traversing AST via visitor design pattern
+        auto* res = new resolver();
+        par->root->accept(res);
+
+        // then hoist loop-invariant expressions out of loops (based on the frame slots resolved)
+        auto* lh = new loop_hoister(&par->arena);
+        par->root->accept(lh);
+
+        if(vm_on){
+            // compile to bytecode by traversing AST via visitor design pattern, and execute on the virtual machine
+            auto* bc = new bytecode_compiler();
+            par->root->accept(bc);
+
+            if(bc->err_count == 0){
+                if(cache_on && !program_image::store(*bc->program, source_key, source.size(), image_path)){
+                    std::cerr << "could not write the compiled program to " << image_path << std::endl;
+                }
+
+                auto* executable = new vm_executable(*bc->program);
+                auto* vm = new virtual_machine(executable, max_depth, &out);
+                vm->run();
+
+                return 0;
+            }
+
+            // the program uses constructs not supported by the bytecode backend; fall back to the interpreter
+            std::cerr << "bytecode compilation failed, falling back to the interpreter" << std::endl;
+        }
+
+        // interpret by creating a new interpreter instance and traversing AST via visitor design pattern
+        auto* itpr = new interpreter(max_depth, &out, (int) n_threads);
         par->root->accept(itpr);
     }
     else{
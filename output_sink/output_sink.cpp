@@ -0,0 +1,105 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "output_sink.h"
+
+#include <charconv>
+#include <cstring>
+
+output_sink::output_sink(ostream& stream, chrono::milliseconds flush_interval) : stream(stream){
+    this->flush_interval = flush_interval;
+    last_flush = chrono::steady_clock::now();
+
+    setp(buffer, buffer + BUFFER_SIZE);
+    target = stream.rdbuf(this);
+}
+
+output_sink::~output_sink(){
+    flush();
+    stream.rdbuf(target);
+}
+
+// Writes the buffered output to the underlying buffer of the stream, and flushes it
+void output_sink::flush(){
+    if(pptr() != pbase()){
+        target->sputn(pbase(), pptr() - pbase());
+        setp(buffer, buffer + BUFFER_SIZE);
+    }
+
+    target->pubsync();
+    last_flush = chrono::steady_clock::now();
+}
+
+void output_sink::put_bool(bool b){
+    if(b){
+        put_string("true", 4);
+    }
+    else{
+        put_string("false", 5);
+    }
+}
+
+void output_sink::put_int(int32_t i){
+    reserve(16);
+    pbump((int) (to_chars(pptr(), epptr(), i).ptr - pptr()));
+}
+
+void output_sink::put_float(float f){
+    reserve(32);
+    pbump((int) (to_chars(pptr(), epptr(), f, chars_format::general, 6).ptr - pptr()));
+}
+
+void output_sink::put_char(char c){
+    reserve(1);
+    *pptr() = c;
+    pbump(1);
+}
+
+void output_sink::put_string(const string& str){
+    put_string(str.data(), str.size());
+}
+
+// Strings which do not fit in the buffer are written through directly (following the output buffered thus far)
+void output_sink::put_string(const char* str, size_t n){
+    if(n > BUFFER_SIZE){
+        flush();
+        target->sputn(str, (streamsize) n);
+        return;
+    }
+
+    reserve(n);
+    memcpy(pptr(), str, n);
+    pbump((int) n);
+}
+
+// Ends a line of output, flushing the buffer if the flush interval has elapsed since the last flush
+void output_sink::end_line(){
+    put_char('\n');
+
+    if(flush_interval.count() == 0 || chrono::steady_clock::now() - last_flush >= flush_interval){
+        flush();
+    }
+}
+
+// ----- STREAM BUFFER OVERRIDES (for output written through the stream) -----
+
+output_sink::int_type output_sink::overflow(int_type c){
+    flush();
+
+    if(!traits_type::eq_int_type(c, traits_type::eof())){
+        put_char(traits_type::to_char_type(c));
+    }
+
+    return traits_type::not_eof(c);
+}
+
+streamsize output_sink::xsputn(const char* s, streamsize n){
+    put_string(s, (size_t) n);
+    return n;
+}
+
+int output_sink::sync(){
+    flush();
+    return 0;
+}
@@ -0,0 +1,66 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_OUTPUT_SINK_H
+#define CPS2000_OUTPUT_SINK_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+using namespace std;
+
+/* A buffered sink for the output of print statements, installed as the buffer of a stream (i.e. std::cout) for as long as
+ * the sink exists. Output is accumulated in a buffer of BUFFER_SIZE bytes, which is written to the underlying buffer of the
+ * stream (and flushed) only once full, when the sink is destroyed, or (upon the end of a line) once the flush interval
+ * has elapsed since the last flush; an interval of 0 flushes every line, as std::endl did.
+ *
+ * Numbers are formatted directly into the buffer with std::to_chars, yielding the same text as the default formatting of
+ * std::ostream (floats are formatted as with %g, i.e. with 6 significant digits). Since std::cerr is tied to std::cout,
+ * the sink is flushed before any error is reported, hence output and errors are interleaved exactly as they were.
+ */
+class output_sink: public streambuf{
+public:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;
+
+    output_sink(ostream& stream, chrono::milliseconds flush_interval);
+    ~output_sink() override;
+
+    output_sink(const output_sink&) = delete;
+    output_sink& operator=(const output_sink&) = delete;
+
+    void put_bool(bool b);
+    void put_int(int32_t i);
+    void put_float(float f);
+    void put_char(char c);
+    void put_string(const string& str);
+    void put_string(const char* str, size_t n);
+    void end_line();
+
+    void flush();
+
+protected:
+    int_type overflow(int_type c) override;
+    streamsize xsputn(const char* s, streamsize n) override;
+    int sync() override;
+
+private:
+    ostream& stream;
+    streambuf* target; // the buffer of the stream prior to installing the sink, to which the output is written
+
+    char buffer[BUFFER_SIZE];
+    chrono::milliseconds flush_interval;
+    chrono::steady_clock::time_point last_flush;
+
+    // ensures that at least n bytes are free in the buffer, flushing it if need be (n is at most BUFFER_SIZE)
+    void reserve(size_t n){
+        if((size_t) (epptr() - pptr()) < n){
+            flush();
+        }
+    }
+};
+
+#endif //CPS2000_OUTPUT_SINK_H
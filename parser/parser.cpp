@@ -20,8 +20,9 @@
 parser::parser(lexer* lexer_ptr){
     // initialise, pushing T_EOF on the stack to terminate when EOF of source reached, initialise token instance and
     // define root of AST (which is always an astPROGRAM instance)
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_EOF});
-    root = new astPROGRAM(nullptr, 1);
+    state_stack.reserve(INITIAL_STACK_DEPTH);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_EOF});
+    root = arena.make<astPROGRAM>(1);
     State curr_state = {.parent = root, .symbol = grammarDFA::PROGRAM};
     lexer::Token curr_token;
 
@@ -48,7 +49,7 @@ parser::parser(lexer* lexer_ptr){
                 }while(curr_token.symbol == grammarDFA::T_COMMENT);
 
                 // maintain astNode* and Symbol pair on top of the stack, and pop
-                curr_state = state_stack.top(); state_stack.pop();
+                curr_state = state_stack.back(); state_stack.pop_back();
             }
         }
         else{ // otherwise symbol on top of the stack is a non-terminal symbol
@@ -61,7 +62,7 @@ parser::parser(lexer* lexer_ptr){
                 (this->*pr)(curr_state.parent, &curr_token); // execute fetched production rule
 
                 // maintain astNode* and Symbol pair on top of the stack, and pop
-                curr_state = state_stack.top(); state_stack.pop();
+                curr_state = state_stack.back(); state_stack.pop_back();
             }
         }
     }
@@ -86,13 +87,13 @@ void parser::panic_mode_recovery(lexer* lexer_ptr, lexer::Token* curr_token, Sta
      * which parsing can continue correctly.
      */
     while(curr_state->symbol != grammarDFA::T_SEMICOLON && curr_state->symbol != grammarDFA::T_EOF){
-        *curr_state = state_stack.top(); state_stack.pop(); // pop off top of stack until synchronisation token reached
+        *curr_state = state_stack.back(); state_stack.pop_back(); // pop off top of stack until synchronisation token reached
     }
 
     if(curr_state->symbol == grammarDFA::T_EOF){ // recovery failed, reached end of stack
         //set curr_token to T_EOF to signal termination of parsing to parser
         curr_token->symbol = grammarDFA::T_EOF;
-        curr_token->lexeme = '\0';
+        curr_token->lexeme = string_view("\0", 1);
         curr_token->line = -1;
     }
     else{
@@ -110,9 +111,7 @@ void parser::panic_mode_recovery(lexer* lexer_ptr, lexer::Token* curr_token, Sta
             //set curr_state.symbol to T_EOF to signal termination of parsing to parser, and empty state_stack
             curr_state->symbol = grammarDFA::T_EOF;
 
-            while(!state_stack.empty()){
-                state_stack.pop();
-            }
+            state_stack.clear();
         }
     }
 }
@@ -124,8 +123,8 @@ void parser::panic_mode_recovery(lexer* lexer_ptr, lexer::Token* curr_token, Sta
  * onto the parsing stack the sequence of Symbol instances for the derivation expansion.
  *
  * The execution of a production_rule instance typically involves:
- * 1. Creates a new astNode and populating it with any syntactic and meta--data, with the parent reference of the new
- *    astNode set to the pointer passed as a parameter to the production_rule.
+ * 1. Creates a new astNode (allocated from the arena) and populating it with any syntactic and meta--data, adding it as
+ *    a child of the astNode passed as a parameter to the production_rule.
  * 2. Occasionally, it may re--structure the abstract syntax tree eg. so that the nodes representing the operands of a
  *    binary operation are always children of the node representing the binary operation.
  * 3. A number of Symbol instances paired with a reference to an astNode (typically either the newly created astNode or
@@ -134,806 +133,723 @@ void parser::panic_mode_recovery(lexer* lexer_ptr, lexer::Token* curr_token, Sta
  */
 
 void parser::rulePROGRAM(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::PROGRAM});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::STATEMENT});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::PROGRAM});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::STATEMENT});
 }
 
 void parser::ruleBLOCK(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_block = new astBLOCK(parent, token_ptr->line); parent->add_child(ast_block);
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RBRACE});
-    state_stack.push({.parent = ast_block, .symbol = grammarDFA::BLOCK_ext});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LBRACE});
+    auto* ast_block = arena.make<astBLOCK>(token_ptr->line); parent->add_child(ast_block, arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACE});
+    state_stack.push_back({.parent = ast_block, .symbol = grammarDFA::BLOCK_ext});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACE});
 }
 
 void parser::ruleBLOCK_ext(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::BLOCK_ext});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::STATEMENT});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::BLOCK_ext});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::STATEMENT});
 }
 
 void parser::ruleVAR_DECL(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_var_decl = new astVAR_DECL(parent, token_ptr->line); parent->add_child(ast_var_decl);
-    state_stack.push({.parent = ast_var_decl, .symbol = grammarDFA::VAR_DECL_ASSIGNMENT});
-    state_stack.push({.parent = ast_var_decl, .symbol = grammarDFA::TYPE_VAR});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_COLON});
-    state_stack.push({.parent = ast_var_decl, .symbol = grammarDFA::IDENTIFIER});
+    auto* ast_var_decl = arena.make<astVAR_DECL>(token_ptr->line); parent->add_child(ast_var_decl, arena);
+    state_stack.push_back({.parent = ast_var_decl, .symbol = grammarDFA::VAR_DECL_ASSIGNMENT});
+    state_stack.push_back({.parent = ast_var_decl, .symbol = grammarDFA::TYPE_VAR});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_COLON});
+    state_stack.push_back({.parent = ast_var_decl, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::ruleVAR_DECL_ASSIGNMENT(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_EQUALS});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_EQUALS});
 }
 
 void parser::ruleARR_DECL(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_arr_decl = new astARR_DECL(parent, token_ptr->line); parent->add_child(ast_arr_decl);
-    state_stack.push({.parent = ast_arr_decl, .symbol = grammarDFA::ARR_DECL_ASSIGNMENT});
-    state_stack.push({.parent = ast_arr_decl, .symbol = grammarDFA::TYPE_ARR});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_COLON});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RSQUARE});
-    state_stack.push({.parent = ast_arr_decl, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LSQUARE});
-    state_stack.push({.parent = ast_arr_decl, .symbol = grammarDFA::IDENTIFIER});
+    auto* ast_arr_decl = arena.make<astARR_DECL>(token_ptr->line); parent->add_child(ast_arr_decl, arena);
+    state_stack.push_back({.parent = ast_arr_decl, .symbol = grammarDFA::ARR_DECL_ASSIGNMENT});
+    state_stack.push_back({.parent = ast_arr_decl, .symbol = grammarDFA::TYPE_ARR});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_COLON});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RSQUARE});
+    state_stack.push_back({.parent = ast_arr_decl, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LSQUARE});
+    state_stack.push_back({.parent = ast_arr_decl, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::ruleARR_DECL_ASSIGNMENT(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RBRACE});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::ARR_DECL_ASSIGNMENT_ext}); // expands for every T_COMMA encountered
-    state_stack.push({.parent = parent, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LBRACE});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_EQUALS});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACE});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::ARR_DECL_ASSIGNMENT_ext}); // expands for every T_COMMA encountered
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACE});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_EQUALS});
 }
 
 void parser::ruleARR_DECL_ASSIGNMENT_ext(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::ARR_DECL_ASSIGNMENT_ext});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_COMMA});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::ARR_DECL_ASSIGNMENT_ext});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_COMMA});
 }
 
 void parser::ruleASSIGNMENT_IDENTIFIER(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_assignment = new astASSIGNMENT_IDENTIFIER(parent, token_ptr->line); parent->add_child(ast_assignment);
-    state_stack.push({.parent = ast_assignment, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_EQUALS});
-    state_stack.push({.parent = ast_assignment, .symbol = grammarDFA::IDENTIFIER});
+    auto* ast_assignment = arena.make<astASSIGNMENT_IDENTIFIER>(token_ptr->line); parent->add_child(ast_assignment, arena);
+    state_stack.push_back({.parent = ast_assignment, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_EQUALS});
+    state_stack.push_back({.parent = ast_assignment, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::ruleASSIGNMENT_ELEMENT(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_assignment = new astASSIGNMENT_ELEMENT(parent, token_ptr->line); parent->add_child(ast_assignment);
-    state_stack.push({.parent = ast_assignment, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_EQUALS});
-    state_stack.push({.parent = ast_assignment, .symbol = grammarDFA::ELEMENT});
+    auto* ast_assignment = arena.make<astASSIGNMENT_ELEMENT>(token_ptr->line); parent->add_child(ast_assignment, arena);
+    state_stack.push_back({.parent = ast_assignment, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_EQUALS});
+    state_stack.push_back({.parent = ast_assignment, .symbol = grammarDFA::ELEMENT});
 }
 
 void parser::ruleASSIGNMENT_MEMBER(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_assignment = new astASSIGNMENT_MEMBER(parent, token_ptr->line); parent->add_child(ast_assignment);
-    state_stack.push({.parent = ast_assignment, .symbol = grammarDFA::ASSIGNMENT});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_PERIOD});
-    state_stack.push({.parent = ast_assignment, .symbol = grammarDFA::IDENTIFIER});
+    auto* ast_assignment = arena.make<astASSIGNMENT_MEMBER>(token_ptr->line); parent->add_child(ast_assignment, arena);
+    state_stack.push_back({.parent = ast_assignment, .symbol = grammarDFA::ASSIGNMENT});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_PERIOD});
+    state_stack.push_back({.parent = ast_assignment, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::rulePRINT(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_print = new astPRINT(parent, token_ptr->line);  parent->add_child(ast_print);
-    state_stack.push({.parent = ast_print, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_PRINT});
+    auto* ast_print = arena.make<astPRINT>(token_ptr->line);  parent->add_child(ast_print, arena);
+    state_stack.push_back({.parent = ast_print, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_PRINT});
 }
 
 void parser::ruleRETURN(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_return = new astRETURN(parent, token_ptr->line); parent->add_child(ast_return);
-    state_stack.push({.parent = ast_return, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RETURN});
+    auto* ast_return = arena.make<astRETURN>(token_ptr->line); parent->add_child(ast_return, arena);
+    state_stack.push_back({.parent = ast_return, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RETURN});
 }
 
 void parser::ruleWHILE(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_while = new astWHILE(parent, token_ptr->line); parent->add_child(ast_while);
-    state_stack.push({.parent = ast_while, .symbol = grammarDFA::BLOCK});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
-    state_stack.push({.parent = ast_while, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_WHILE});
+    auto* ast_while = arena.make<astWHILE>(token_ptr->line); parent->add_child(ast_while, arena);
+    state_stack.push_back({.parent = ast_while, .symbol = grammarDFA::BLOCK});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
+    state_stack.push_back({.parent = ast_while, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_WHILE});
 }
 
 void parser::ruleFPARAM(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_fparam = new astFPARAM(parent, token_ptr->line); parent->add_child(ast_fparam);
-    state_stack.push({.parent = ast_fparam, .symbol = grammarDFA::FPARAM_TYPE});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_COLON});
-    state_stack.push({.parent = ast_fparam, .symbol = grammarDFA::IDENTIFIER});
+    auto* ast_fparam = arena.make<astFPARAM>(token_ptr->line); parent->add_child(ast_fparam, arena);
+    state_stack.push_back({.parent = ast_fparam, .symbol = grammarDFA::FPARAM_TYPE});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_COLON});
+    state_stack.push_back({.parent = ast_fparam, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::ruleFPARAM_TYPE_ARR(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RSQUARE});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LSQUARE});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::TYPE_ARR});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RSQUARE});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LSQUARE});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::TYPE_ARR});
 }
 
 void parser::ruleFPARAM_TYPE_VAR(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::TYPE_VAR});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::TYPE_VAR});
 }
 
 void parser::ruleFPARAMS(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_fparams = new astFPARAMS(parent, token_ptr->line); parent->add_child(ast_fparams);
-    state_stack.push({.parent = ast_fparams, .symbol = grammarDFA::FPARAMS_ext});
-    state_stack.push({.parent = ast_fparams, .symbol = grammarDFA::FPARAM});
+    auto* ast_fparams = arena.make<astFPARAMS>(token_ptr->line); parent->add_child(ast_fparams, arena);
+    state_stack.push_back({.parent = ast_fparams, .symbol = grammarDFA::FPARAMS_ext});
+    state_stack.push_back({.parent = ast_fparams, .symbol = grammarDFA::FPARAM});
 }
 
 void parser::ruleFPARAMS_ext_T_COMMA(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FPARAMS_ext});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FPARAM});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_COMMA});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FPARAMS_ext});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FPARAM});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_COMMA});
 }
 
 void parser::ruleAPARAMS(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_aparams = new astAPARAMS(parent, token_ptr->line); parent->add_child(ast_aparams);
-    state_stack.push({.parent = ast_aparams, .symbol = grammarDFA::APARAMS_ext});
-    state_stack.push({.parent = ast_aparams, .symbol = grammarDFA::EXPRESSION});
+    auto* ast_aparams = arena.make<astAPARAMS>(token_ptr->line); parent->add_child(ast_aparams, arena);
+    state_stack.push_back({.parent = ast_aparams, .symbol = grammarDFA::APARAMS_ext});
+    state_stack.push_back({.parent = ast_aparams, .symbol = grammarDFA::EXPRESSION});
 }
 
 void parser::ruleAPARAMS_ext_T_COMMA(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::APARAMS_ext});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_COMMA});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::APARAMS_ext});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_COMMA});
 }
 
 void parser::ruleSUBEXPR(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_subexpr = new astSUBEXPR(parent, token_ptr->line); parent->add_child(ast_subexpr);
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
-    state_stack.push({.parent = ast_subexpr, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
+    auto* ast_subexpr = arena.make<astSUBEXPR>(token_ptr->line); parent->add_child(ast_subexpr, arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
+    state_stack.push_back({.parent = ast_subexpr, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
 }
 
 void parser::ruleLITERAL_T_BOOL(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astLITERAL(parent, token_ptr->lexeme, grammarDFA::T_BOOL, "bool", token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_BOOL});
+    parent->add_child(arena.make<astLITERAL>(string(token_ptr->lexeme), grammarDFA::T_BOOL, "bool", token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_BOOL});
 }
 
 void parser::ruleLITERAL_T_INT(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astLITERAL(parent, token_ptr->lexeme, grammarDFA::T_INT, "int", token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_INT});
+    parent->add_child(arena.make<astLITERAL>(string(token_ptr->lexeme), grammarDFA::T_INT, "int", token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_INT});
 }
 
 void parser::ruleLITERAL_T_FLOAT(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astLITERAL(parent, token_ptr->lexeme, grammarDFA::T_FLOAT, "float", token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_FLOAT});
+    parent->add_child(arena.make<astLITERAL>(string(token_ptr->lexeme), grammarDFA::T_FLOAT, "float", token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_FLOAT});
 }
 
 void parser::ruleLITERAL_T_STRING(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astLITERAL(parent, token_ptr->lexeme, grammarDFA::T_STRING, "string", token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_STRING});
+    parent->add_child(arena.make<astLITERAL>(string(token_ptr->lexeme), grammarDFA::T_STRING, "string", token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_STRING});
 }
 
 void parser::ruleLITERAL_T_CHAR(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astLITERAL(parent, token_ptr->lexeme, grammarDFA::T_CHAR, "char", token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_CHAR});
+    parent->add_child(arena.make<astLITERAL>(string(token_ptr->lexeme), grammarDFA::T_CHAR, "char", token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_CHAR});
 }
 
 void parser::ruleUNARY_T_MINUS(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_unary = new astUNARY(parent, "-", token_ptr->line); parent->add_child(ast_unary);
-    state_stack.push({.parent = ast_unary, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_MINUS});
+    auto* ast_unary = arena.make<astUNARY>("-", token_ptr->line); parent->add_child(ast_unary, arena);
+    state_stack.push_back({.parent = ast_unary, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_MINUS});
 }
 
 void parser::ruleUNARY_T_NOT(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_unary = new astUNARY(parent, "not", token_ptr->line); parent->add_child(ast_unary);
-    state_stack.push({.parent = ast_unary, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_NOT});
+    auto* ast_unary = arena.make<astUNARY>("not", token_ptr->line); parent->add_child(ast_unary, arena);
+    state_stack.push_back({.parent = ast_unary, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_NOT});
 }
 
 void parser::ruleFUNC_CALL(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_func_call = new astFUNC_CALL(parent, token_ptr->line); parent->add_child(ast_func_call);
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
-    state_stack.push({.parent = ast_func_call, .symbol = grammarDFA::FUNC_CALL_APARAMS});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
-    state_stack.push({.parent = ast_func_call, .symbol = grammarDFA::IDENTIFIER});
+    auto* ast_func_call = arena.make<astFUNC_CALL>(token_ptr->line); parent->add_child(ast_func_call, arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
+    state_stack.push_back({.parent = ast_func_call, .symbol = grammarDFA::FUNC_CALL_APARAMS});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
+    state_stack.push_back({.parent = ast_func_call, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::ruleFUNC_CALL_APARAMS(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::APARAMS});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::APARAMS});
 }
 
 void parser::ruleIF(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_if = new astIF(parent, token_ptr->line); parent->add_child(ast_if);
-    state_stack.push({.parent = ast_if, .symbol = grammarDFA::ELSE});
-    state_stack.push({.parent = ast_if, .symbol = grammarDFA::BLOCK});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
-    state_stack.push({.parent = ast_if, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_IF});
+    auto* ast_if = arena.make<astIF>(token_ptr->line); parent->add_child(ast_if, arena);
+    state_stack.push_back({.parent = ast_if, .symbol = grammarDFA::ELSE});
+    state_stack.push_back({.parent = ast_if, .symbol = grammarDFA::BLOCK});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
+    state_stack.push_back({.parent = ast_if, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_IF});
 }
 
 void parser::ruleELSE_T_ELSE(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::BLOCK});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_ELSE});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::BLOCK});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_ELSE});
 }
 
 void parser::ruleFUNC_DECL(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_func_decl = new astFUNC_DECL(parent, token_ptr->line); parent->add_child(ast_func_decl);
-    state_stack.push({.parent = ast_func_decl, .symbol = grammarDFA::BLOCK});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
-    state_stack.push({.parent = ast_func_decl, .symbol = grammarDFA::FUNC_DECL_FPARAMS});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
-    state_stack.push({.parent = ast_func_decl, .symbol = grammarDFA::IDENTIFIER});
-    state_stack.push({.parent = ast_func_decl, .symbol = grammarDFA::TYPE_VAR});
+    auto* ast_func_decl = arena.make<astFUNC_DECL>(token_ptr->line); parent->add_child(ast_func_decl, arena);
+    state_stack.push_back({.parent = ast_func_decl, .symbol = grammarDFA::BLOCK});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
+    state_stack.push_back({.parent = ast_func_decl, .symbol = grammarDFA::FUNC_DECL_FPARAMS});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
+    state_stack.push_back({.parent = ast_func_decl, .symbol = grammarDFA::IDENTIFIER});
+    state_stack.push_back({.parent = ast_func_decl, .symbol = grammarDFA::TYPE_VAR});
 }
 
 void parser::ruleFUNC_DECL_ARR(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_func_decl = new astFUNC_DECL(parent, token_ptr->line); parent->add_child(ast_func_decl);
-    state_stack.push({.parent = ast_func_decl, .symbol = grammarDFA::BLOCK});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
-    state_stack.push({.parent = ast_func_decl, .symbol = grammarDFA::FUNC_DECL_FPARAMS});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
-    state_stack.push({.parent = ast_func_decl, .symbol = grammarDFA::IDENTIFIER});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RSQUARE});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LSQUARE});
-    state_stack.push({.parent = ast_func_decl, .symbol = grammarDFA::TYPE_ARR});
+    auto* ast_func_decl = arena.make<astFUNC_DECL>(token_ptr->line); parent->add_child(ast_func_decl, arena);
+    state_stack.push_back({.parent = ast_func_decl, .symbol = grammarDFA::BLOCK});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
+    state_stack.push_back({.parent = ast_func_decl, .symbol = grammarDFA::FUNC_DECL_FPARAMS});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
+    state_stack.push_back({.parent = ast_func_decl, .symbol = grammarDFA::IDENTIFIER});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RSQUARE});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LSQUARE});
+    state_stack.push_back({.parent = ast_func_decl, .symbol = grammarDFA::TYPE_ARR});
 }
 
 void parser::ruleFUNC_DECL_FPARAMS(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FPARAMS});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FPARAMS});
 }
 
 void parser::ruleFOR(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_for = new astFOR(parent, token_ptr->line); parent->add_child(ast_for);
-    state_stack.push({.parent = ast_for, .symbol = grammarDFA::BLOCK});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
-    state_stack.push({.parent = ast_for, .symbol = grammarDFA::FOR_ASSIGNMENT});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
-    state_stack.push({.parent = ast_for, .symbol = grammarDFA::FOR_EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
-    state_stack.push({.parent = ast_for, .symbol = grammarDFA::FOR_DECL});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_FOR});
+    auto* ast_for = arena.make<astFOR>(token_ptr->line); parent->add_child(ast_for, arena);
+    state_stack.push_back({.parent = ast_for, .symbol = grammarDFA::BLOCK});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
+    state_stack.push_back({.parent = ast_for, .symbol = grammarDFA::FOR_ASSIGNMENT});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = ast_for, .symbol = grammarDFA::FOR_EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = ast_for, .symbol = grammarDFA::FOR_DECL});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_FOR});
+}
+
+// A parallel for loop shares the header of a for loop, but is preceded by the parallel keyword
+void parser::rulePAR_FOR(astInnerNode* parent, lexer::Token* token_ptr){
+    auto* ast_par_for = arena.make<astPAR_FOR>(token_ptr->line); parent->add_child(ast_par_for, arena);
+    state_stack.push_back({.parent = ast_par_for, .symbol = grammarDFA::BLOCK});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RBRACKET});
+    state_stack.push_back({.parent = ast_par_for, .symbol = grammarDFA::FOR_ASSIGNMENT});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = ast_par_for, .symbol = grammarDFA::FOR_EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = ast_par_for, .symbol = grammarDFA::FOR_DECL});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LBRACKET});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_FOR});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_PARALLEL});
 }
 
 void parser::ruleFOR_ASSIGNMENT(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::ASSIGNMENT});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::ASSIGNMENT});
 }
 
 void parser::ruleFOR_EXPRESSION(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::EXPRESSION});
 }
 
 void parser::ruleFOR_DECL(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::DECL});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LET});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::DECL});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LET});
 }
 
 void parser::ruleSTATEMENT_T_LET_DECL(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::DECL});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LET});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::DECL});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LET});
 }
 
 void parser::ruleSTATEMENT_T_IDENTIFIER_ASSIGNMENT(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::ASSIGNMENT});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::ASSIGNMENT});
 }
 
 void parser::ruleSTATEMENT_T_IDENTIFIER_FUNC_CALL(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FUNC_CALL});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FUNC_CALL});
 }
 
 void parser::ruleSTATEMENT_T_IDENTIFIER_AS_TYPE(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FUNC_DECL});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FUNC_DECL});
 }
 
 void parser::ruleSTATEMENT_T_IDENTIFIER_MEMBER_ACC(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::MEMBER_ACCESS});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::MEMBER_ACCESS});
 }
 
 void parser::ruleSTATEMENT_T_PRINT(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::PRINT});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::PRINT});
 }
 
 void parser::ruleSTATEMENT_T_IF(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::IF});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::IF});
 }
 
 void parser::ruleSTATEMENT_T_FOR(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FOR});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FOR});
+}
+
+void parser::ruleSTATEMENT_T_PARALLEL(astInnerNode* parent, lexer::Token* token_ptr){
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::PAR_FOR});
 }
 
 void parser::ruleSTATEMENT_T_WHILE(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::WHILE});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::WHILE});
 }
 
 void parser::ruleSTATEMENT_T_RETURN(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::RETURN});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_SEMICOLON});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::RETURN});
 }
 
 void parser::ruleSTATEMENT_T_TYPE(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FUNC_DECL});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FUNC_DECL});
 }
 
 void parser::ruleSTATEMENT_T_LBRACE(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::BLOCK});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::BLOCK});
 }
 
 void parser::ruleSTATEMENT_T_TLSTRUCT(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::TLS_DECL});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::TLS_DECL});
 }
 
 void parser::ruleFACTOR_LITERAL(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::LITERAL});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::LITERAL});
 }
 
 void parser::ruleFACTOR_ELEMENT(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::ELEMENT});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::ELEMENT});
 }
 
 void parser::ruleFACTOR_IDENTIFIER(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::IDENTIFIER});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::ruleFACTOR_FUNC_CALL(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FUNC_CALL});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FUNC_CALL});
 }
 
 void parser::ruleFACTOR_MEMBER_ACCESS(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::MEMBER_ACCESS});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::MEMBER_ACCESS});
 }
 
 void parser::ruleFACTOR_SUBEXPR(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::SUBEXPR});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::SUBEXPR});
 }
 
 void parser::ruleFACTOR_UNARY(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::UNARY});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::UNARY});
 }
 
 void parser::ruleTERM(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::TERM_ext});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FACTOR});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::TERM_ext});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FACTOR});
 }
 
 void parser::ruleTERM_ext(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_multop = new astMULTOP(parent, token_ptr->lexeme, token_ptr->line);
-    ast_multop->add_child(parent->children->at(parent->n_children - 1));
-    ast_multop->children->at(ast_multop->n_children - 1)->parent = ast_multop;
+    auto* ast_multop = arena.make<astMULTOP>(string(token_ptr->lexeme), token_ptr->line);
+    ast_multop->add_child(parent->children.at(parent->n_children - 1), arena);
     parent->n_children--;
-    parent->add_child(ast_multop);
+    parent->add_child(ast_multop, arena);
 
-    state_stack.push({.parent = ast_multop, .symbol = grammarDFA::TERM_ext});
-    state_stack.push({.parent = ast_multop, .symbol = grammarDFA::FACTOR});
-    state_stack.push({.parent = nullptr, .symbol = token_ptr->symbol});
+    state_stack.push_back({.parent = ast_multop, .symbol = grammarDFA::TERM_ext});
+    state_stack.push_back({.parent = ast_multop, .symbol = grammarDFA::FACTOR});
+    state_stack.push_back({.parent = nullptr, .symbol = token_ptr->symbol});
 }
 
 void parser::ruleS_EXPR(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::S_EXPR_ext});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::TERM});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::S_EXPR_ext});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::TERM});
 }
 
 void parser::ruleS_EXPR_ext(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_addop = new astADDOP(parent, token_ptr->lexeme, token_ptr->line);
-    ast_addop->add_child(parent->children->at(parent->n_children - 1));
-    ast_addop->children->at(ast_addop->n_children - 1)->parent = ast_addop;
+    auto* ast_addop = arena.make<astADDOP>(string(token_ptr->lexeme), token_ptr->line);
+    ast_addop->add_child(parent->children.at(parent->n_children - 1), arena);
     parent->n_children--;
-    parent->add_child(ast_addop);
+    parent->add_child(ast_addop, arena);
 
-    state_stack.push({.parent = ast_addop, .symbol = grammarDFA::S_EXPR_ext});
-    state_stack.push({.parent = ast_addop, .symbol = grammarDFA::TERM});
-    state_stack.push({.parent = nullptr, .symbol = token_ptr->symbol});
+    state_stack.push_back({.parent = ast_addop, .symbol = grammarDFA::S_EXPR_ext});
+    state_stack.push_back({.parent = ast_addop, .symbol = grammarDFA::TERM});
+    state_stack.push_back({.parent = nullptr, .symbol = token_ptr->symbol});
 }
 
 void parser::ruleEXPRESSION(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::EXPRESSION_ext});
-    state_stack.push({.parent = parent, .symbol = grammarDFA::S_EXPR});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::EXPRESSION_ext});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::S_EXPR});
 }
 
 void parser::ruleEXPRESSION_ext(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_relop = new astRELOP(parent, token_ptr->lexeme, token_ptr->line);
-    ast_relop->add_child(parent->children->at(parent->n_children - 1));
-    ast_relop->children->at(ast_relop->n_children - 1)->parent = ast_relop;
+    auto* ast_relop = arena.make<astRELOP>(string(token_ptr->lexeme), token_ptr->line);
+    ast_relop->add_child(parent->children.at(parent->n_children - 1), arena);
     parent->n_children--;
-    parent->add_child(ast_relop);
+    parent->add_child(ast_relop, arena);
 
-    state_stack.push({.parent = ast_relop, .symbol = grammarDFA::EXPRESSION_ext});
-    state_stack.push({.parent = ast_relop, .symbol = grammarDFA::S_EXPR});
-    state_stack.push({.parent = nullptr, .symbol = token_ptr->symbol});
+    state_stack.push_back({.parent = ast_relop, .symbol = grammarDFA::EXPRESSION_ext});
+    state_stack.push_back({.parent = ast_relop, .symbol = grammarDFA::S_EXPR});
+    state_stack.push_back({.parent = nullptr, .symbol = token_ptr->symbol});
 }
 
 void parser::ruleTYPE_VAR_T_TYPE(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astTYPE(parent, token_ptr->lexeme, type_string2symbol(token_ptr->lexeme),
-                                  grammarDFA::SINGLETON, token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_TYPE});
+    parent->add_child(arena.make<astTYPE>(string(token_ptr->lexeme), type_string2symbol(token_ptr->lexeme),
+                                  grammarDFA::SINGLETON, token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_TYPE});
 }
 
 void parser::ruleTYPE_ARR_T_TYPE(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astTYPE(parent, token_ptr->lexeme, type_string2symbol(token_ptr->lexeme),
-                                  grammarDFA::ARRAY, token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_TYPE});
+    parent->add_child(arena.make<astTYPE>(string(token_ptr->lexeme), type_string2symbol(token_ptr->lexeme),
+                                  grammarDFA::ARRAY, token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_TYPE});
 }
 
 void parser::ruleTYPE_VAR_T_IDENTIFIER(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astTYPE(parent, token_ptr->lexeme, grammarDFA::T_TLSTRUCT,
-                                  grammarDFA::SINGLETON, token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_IDENTIFIER});
+    parent->add_child(arena.make<astTYPE>(string(token_ptr->lexeme), grammarDFA::T_TLSTRUCT,
+                                  grammarDFA::SINGLETON, token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_IDENTIFIER});
 }
 
 void parser::ruleTYPE_ARR_T_IDENTIFIER(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astTYPE(parent, token_ptr->lexeme, grammarDFA::T_TLSTRUCT,
-                                  grammarDFA::ARRAY, token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_IDENTIFIER});
+    parent->add_child(arena.make<astTYPE>(string(token_ptr->lexeme), grammarDFA::T_TLSTRUCT,
+                                  grammarDFA::ARRAY, token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_IDENTIFIER});
 }
 
 void parser::ruleIDENTIFIER(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(new astIDENTIFIER(parent, token_ptr->lexeme, token_ptr->line));
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_IDENTIFIER});
+    parent->add_child(arena.make<astIDENTIFIER>(string(token_ptr->lexeme), token_ptr->line), arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_IDENTIFIER});
 }
 
 void parser::ruleELEMENT(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_element = new astELEMENT(parent, token_ptr->line); parent->add_child(ast_element);
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_RSQUARE});
-    state_stack.push({.parent = ast_element, .symbol = grammarDFA::EXPRESSION});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_LSQUARE});
-    state_stack.push({.parent = ast_element, .symbol = grammarDFA::IDENTIFIER});
+    auto* ast_element = arena.make<astELEMENT>(token_ptr->line); parent->add_child(ast_element, arena);
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_RSQUARE});
+    state_stack.push_back({.parent = ast_element, .symbol = grammarDFA::EXPRESSION});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_LSQUARE});
+    state_stack.push_back({.parent = ast_element, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::ruleMEMBER_ELEMENT(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::ELEMENT});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::ELEMENT});
 }
 
 void parser::ruleMEMBER_IDENTIFIER(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::IDENTIFIER});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::ruleMEMBER_FUNC_CALL(astInnerNode* parent, lexer::Token* token_ptr){
-    state_stack.push({.parent = parent, .symbol = grammarDFA::FUNC_CALL});
+    state_stack.push_back({.parent = parent, .symbol = grammarDFA::FUNC_CALL});
 }
 
 void parser::ruleMEMBER_ACCESS(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_member_acc = new astMEMBER_ACCESS(parent, token_ptr->line); parent->add_child(ast_member_acc);
-    state_stack.push({.parent = ast_member_acc, .symbol = grammarDFA::MEMBER});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_PERIOD});
-    state_stack.push({.parent = ast_member_acc, .symbol = grammarDFA::IDENTIFIER});
+    auto* ast_member_acc = arena.make<astMEMBER_ACCESS>(token_ptr->line); parent->add_child(ast_member_acc, arena);
+    state_stack.push_back({.parent = ast_member_acc, .symbol = grammarDFA::MEMBER});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_PERIOD});
+    state_stack.push_back({.parent = ast_member_acc, .symbol = grammarDFA::IDENTIFIER});
 }
 
 void parser::ruleTLS_DECL(astInnerNode* parent, lexer::Token* token_ptr){
-    auto* ast_tls_decl = new astTLS_DECL(parent, token_ptr->line); parent->add_child(ast_tls_decl);
-    state_stack.push({.parent = ast_tls_decl, .symbol = grammarDFA::BLOCK});
-    state_stack.push({.parent = ast_tls_decl, .symbol = grammarDFA::IDENTIFIER});
-    state_stack.push({.parent = nullptr, .symbol = grammarDFA::T_TLSTRUCT});
+    auto* ast_tls_decl = arena.make<astTLS_DECL>(token_ptr->line); parent->add_child(ast_tls_decl, arena);
+    state_stack.push_back({.parent = ast_tls_decl, .symbol = grammarDFA::BLOCK});
+    state_stack.push_back({.parent = ast_tls_decl, .symbol = grammarDFA::IDENTIFIER});
+    state_stack.push_back({.parent = nullptr, .symbol = grammarDFA::T_TLSTRUCT});
 }
 
 void parser::null_rule(astInnerNode* parent, lexer::Token* token_ptr){}
 
 void parser::optional_pass_rule(astInnerNode* parent, lexer::Token* token_ptr){
-    parent->add_child(nullptr); // preserves ordering of positional optional symbols
+    parent->add_child(nullptr, arena); // preserves ordering of positional optional symbols
 }
 
-/* The parse_table function mimics the production table, returning a pointer to a production_rule type function which
- * can be subsequently called. Rather than represent as a table with lookahead symbols, we use a series of switch
- * statements. In the case that no production rule is found for a given Symbol and Token pair, a nullptr is returned,
- * indicating an error.
+/* Builds the production table (see parser.h) at compile-time, from the FIRST and FOLLOW sets of the expansions of each
+ * non-terminal. For each non-terminal, every entry is first set to the default expansion (if any, i.e. the expansion
+ * applied on any token not in the FIRST set of another expansion, which is checked subsequently), and then the entries
+ * of the tokens selecting a different expansion are set.
+ */
+constexpr parser::production_table parser::build_production_table(){
+    production_table t{}; // all rules are initially nullptr, i.e. a syntax error
+
+    // sets the expansion of the non-terminal on every token
+    auto fill = [&t](grammarDFA::Symbol nt, production_rule pr, int peek = 0){
+        for(production& p : t.rules[nt]){ p = {pr, peek};}
+    };
+
+    // sets the expansion of the non-terminal on the specified token
+    auto on = [&t](grammarDFA::Symbol nt, grammarDFA::Symbol token, production_rule pr, int peek = 0){
+        t.rules[nt][token - grammarDFA::n_NTS] = {pr, peek};
+    };
+
+    // sets the expansion of the non-terminal on every peeked token, and on the specified peeked token, respectively
+    auto fill_peek = [&t](grammarDFA::Symbol nt, production_rule pr){
+        for(production_rule& p : t.lookahead[nt]){ p = pr;}
+    };
+
+    auto on_peek = [&t](grammarDFA::Symbol nt, grammarDFA::Symbol token, production_rule pr){
+        t.lookahead[nt][token - grammarDFA::n_NTS] = pr;
+    };
+
+    fill(grammarDFA::PROGRAM, &parser::rulePROGRAM);
+    on(grammarDFA::PROGRAM, grammarDFA::T_EOF, &parser::null_rule);
+
+    fill(grammarDFA::BLOCK, &parser::ruleBLOCK);
+    fill(grammarDFA::BLOCK_ext, &parser::ruleBLOCK_ext);
+    on(grammarDFA::BLOCK_ext, grammarDFA::T_RBRACE, &parser::null_rule);
+
+    fill(grammarDFA::DECL, nullptr, 1);
+    fill_peek(grammarDFA::DECL, &parser::ruleVAR_DECL);
+    on_peek(grammarDFA::DECL, grammarDFA::T_LSQUARE, &parser::ruleARR_DECL);
+
+    fill(grammarDFA::VAR_DECL_ASSIGNMENT, &parser::null_rule);
+    on(grammarDFA::VAR_DECL_ASSIGNMENT, grammarDFA::T_EQUALS, &parser::ruleVAR_DECL_ASSIGNMENT);
+    fill(grammarDFA::ARR_DECL_ASSIGNMENT, &parser::null_rule);
+    on(grammarDFA::ARR_DECL_ASSIGNMENT, grammarDFA::T_EQUALS, &parser::ruleARR_DECL_ASSIGNMENT);
+    fill(grammarDFA::ARR_DECL_ASSIGNMENT_ext, &parser::null_rule);
+    on(grammarDFA::ARR_DECL_ASSIGNMENT_ext, grammarDFA::T_COMMA, &parser::ruleARR_DECL_ASSIGNMENT_ext);
+
+    fill(grammarDFA::ASSIGNMENT, nullptr, 1);
+    fill_peek(grammarDFA::ASSIGNMENT, &parser::ruleASSIGNMENT_IDENTIFIER);
+    on_peek(grammarDFA::ASSIGNMENT, grammarDFA::T_LSQUARE, &parser::ruleASSIGNMENT_ELEMENT);
+    on_peek(grammarDFA::ASSIGNMENT, grammarDFA::T_PERIOD, &parser::ruleASSIGNMENT_MEMBER);
+
+    fill(grammarDFA::PRINT, &parser::rulePRINT);
+    fill(grammarDFA::RETURN, &parser::ruleRETURN);
+    fill(grammarDFA::WHILE, &parser::ruleWHILE);
+    fill(grammarDFA::FPARAM, &parser::ruleFPARAM);
+
+    fill(grammarDFA::FPARAM_TYPE, nullptr, 1);
+    fill_peek(grammarDFA::FPARAM_TYPE, &parser::ruleFPARAM_TYPE_VAR);
+    on_peek(grammarDFA::FPARAM_TYPE, grammarDFA::T_LSQUARE, &parser::ruleFPARAM_TYPE_ARR);
+
+    fill(grammarDFA::FPARAMS, &parser::ruleFPARAMS);
+    fill(grammarDFA::FPARAMS_ext, &parser::null_rule);
+    on(grammarDFA::FPARAMS_ext, grammarDFA::T_COMMA, &parser::ruleFPARAMS_ext_T_COMMA);
+    fill(grammarDFA::APARAMS, &parser::ruleAPARAMS);
+    fill(grammarDFA::APARAMS_ext, &parser::null_rule);
+    on(grammarDFA::APARAMS_ext, grammarDFA::T_COMMA, &parser::ruleAPARAMS_ext_T_COMMA);
+    fill(grammarDFA::SUBEXPR, &parser::ruleSUBEXPR);
+
+    on(grammarDFA::LITERAL, grammarDFA::T_INT, &parser::ruleLITERAL_T_INT);
+    on(grammarDFA::LITERAL, grammarDFA::T_BOOL, &parser::ruleLITERAL_T_BOOL);
+    on(grammarDFA::LITERAL, grammarDFA::T_STRING, &parser::ruleLITERAL_T_STRING);
+    on(grammarDFA::LITERAL, grammarDFA::T_FLOAT, &parser::ruleLITERAL_T_FLOAT);
+    on(grammarDFA::LITERAL, grammarDFA::T_CHAR, &parser::ruleLITERAL_T_CHAR);
+
+    on(grammarDFA::UNARY, grammarDFA::T_MINUS, &parser::ruleUNARY_T_MINUS);
+    on(grammarDFA::UNARY, grammarDFA::T_NOT, &parser::ruleUNARY_T_NOT);
+
+    fill(grammarDFA::FUNC_CALL, &parser::ruleFUNC_CALL);
+    fill(grammarDFA::FUNC_CALL_APARAMS, &parser::ruleFUNC_CALL_APARAMS);
+    on(grammarDFA::FUNC_CALL_APARAMS, grammarDFA::T_RBRACKET, &parser::optional_pass_rule);
+
+    fill(grammarDFA::IF, &parser::ruleIF);
+    fill(grammarDFA::ELSE, &parser::optional_pass_rule);
+    on(grammarDFA::ELSE, grammarDFA::T_ELSE, &parser::ruleELSE_T_ELSE);
+
+    fill(grammarDFA::FUNC_DECL, nullptr, 1);
+    fill_peek(grammarDFA::FUNC_DECL, &parser::ruleFUNC_DECL);
+    on_peek(grammarDFA::FUNC_DECL, grammarDFA::T_LSQUARE, &parser::ruleFUNC_DECL_ARR);
+
+    fill(grammarDFA::FUNC_DECL_FPARAMS, &parser::ruleFUNC_DECL_FPARAMS);
+    on(grammarDFA::FUNC_DECL_FPARAMS, grammarDFA::T_RBRACKET, &parser::optional_pass_rule);
+
+    fill(grammarDFA::FOR, &parser::ruleFOR);
+    fill(grammarDFA::PAR_FOR, &parser::rulePAR_FOR);
+    fill(grammarDFA::FOR_DECL, &parser::ruleFOR_DECL);
+    on(grammarDFA::FOR_DECL, grammarDFA::T_SEMICOLON, &parser::optional_pass_rule);
+    fill(grammarDFA::FOR_EXPRESSION, &parser::ruleFOR_EXPRESSION);
+    on(grammarDFA::FOR_EXPRESSION, grammarDFA::T_SEMICOLON, nullptr);
+    fill(grammarDFA::FOR_ASSIGNMENT, &parser::ruleFOR_ASSIGNMENT);
+    on(grammarDFA::FOR_ASSIGNMENT, grammarDFA::T_RBRACKET, &parser::optional_pass_rule);
+
+    on(grammarDFA::STATEMENT, grammarDFA::T_LET, &parser::ruleSTATEMENT_T_LET_DECL);
+    on(grammarDFA::STATEMENT, grammarDFA::T_IDENTIFIER, nullptr, 3);
+    on(grammarDFA::STATEMENT, grammarDFA::T_PRINT, &parser::ruleSTATEMENT_T_PRINT);
+    on(grammarDFA::STATEMENT, grammarDFA::T_IF, &parser::ruleSTATEMENT_T_IF);
+    on(grammarDFA::STATEMENT, grammarDFA::T_FOR, &parser::ruleSTATEMENT_T_FOR);
+    on(grammarDFA::STATEMENT, grammarDFA::T_PARALLEL, &parser::ruleSTATEMENT_T_PARALLEL);
+    on(grammarDFA::STATEMENT, grammarDFA::T_WHILE, &parser::ruleSTATEMENT_T_WHILE);
+    on(grammarDFA::STATEMENT, grammarDFA::T_RETURN, &parser::ruleSTATEMENT_T_RETURN);
+    on(grammarDFA::STATEMENT, grammarDFA::T_TYPE, &parser::ruleSTATEMENT_T_TYPE);
+    on(grammarDFA::STATEMENT, grammarDFA::T_LBRACE, &parser::ruleSTATEMENT_T_LBRACE);
+    on(grammarDFA::STATEMENT, grammarDFA::T_TLSTRUCT, &parser::ruleSTATEMENT_T_TLSTRUCT);
+
+    for(grammarDFA::Symbol literal : {grammarDFA::T_BOOL, grammarDFA::T_INT, grammarDFA::T_FLOAT, grammarDFA::T_STRING,
+                                      grammarDFA::T_CHAR}){
+        on(grammarDFA::FACTOR, literal, &parser::ruleFACTOR_LITERAL);
+    }
+    on(grammarDFA::FACTOR, grammarDFA::T_LBRACKET, &parser::ruleFACTOR_SUBEXPR);
+    on(grammarDFA::FACTOR, grammarDFA::T_MINUS, &parser::ruleFACTOR_UNARY);
+    on(grammarDFA::FACTOR, grammarDFA::T_NOT, &parser::ruleFACTOR_UNARY);
+    on(grammarDFA::FACTOR, grammarDFA::T_IDENTIFIER, nullptr, 1);
+    fill_peek(grammarDFA::FACTOR, &parser::ruleFACTOR_IDENTIFIER);
+    on_peek(grammarDFA::FACTOR, grammarDFA::T_LBRACKET, &parser::ruleFACTOR_FUNC_CALL);
+    on_peek(grammarDFA::FACTOR, grammarDFA::T_LSQUARE, &parser::ruleFACTOR_ELEMENT);
+    on_peek(grammarDFA::FACTOR, grammarDFA::T_PERIOD, &parser::ruleFACTOR_MEMBER_ACCESS);
+
+    fill(grammarDFA::TERM, &parser::ruleTERM);
+    fill(grammarDFA::TERM_ext, &parser::null_rule);
+    on(grammarDFA::TERM_ext, grammarDFA::T_MUL, &parser::ruleTERM_ext);
+    on(grammarDFA::TERM_ext, grammarDFA::T_DIV, &parser::ruleTERM_ext);
+    on(grammarDFA::TERM_ext, grammarDFA::T_AND, &parser::ruleTERM_ext);
+
+    fill(grammarDFA::S_EXPR, &parser::ruleS_EXPR);
+    fill(grammarDFA::S_EXPR_ext, &parser::null_rule);
+    on(grammarDFA::S_EXPR_ext, grammarDFA::T_PLUS, &parser::ruleS_EXPR_ext);
+    on(grammarDFA::S_EXPR_ext, grammarDFA::T_MINUS, &parser::ruleS_EXPR_ext);
+    on(grammarDFA::S_EXPR_ext, grammarDFA::T_OR, &parser::ruleS_EXPR_ext);
+
+    fill(grammarDFA::EXPRESSION, &parser::ruleEXPRESSION);
+    fill(grammarDFA::EXPRESSION_ext, &parser::null_rule);
+    on(grammarDFA::EXPRESSION_ext, grammarDFA::T_RELOP, &parser::ruleEXPRESSION_ext);
+
+    fill(grammarDFA::TYPE_VAR, &parser::ruleTYPE_VAR_T_IDENTIFIER);
+    on(grammarDFA::TYPE_VAR, grammarDFA::T_TYPE, &parser::ruleTYPE_VAR_T_TYPE);
+    fill(grammarDFA::TYPE_ARR, &parser::ruleTYPE_ARR_T_IDENTIFIER);
+    on(grammarDFA::TYPE_ARR, grammarDFA::T_TYPE, &parser::ruleTYPE_ARR_T_TYPE);
+
+    fill(grammarDFA::IDENTIFIER, &parser::ruleIDENTIFIER);
+    fill(grammarDFA::ELEMENT, &parser::ruleELEMENT);
+
+    fill(grammarDFA::MEMBER, nullptr, 1);
+    fill_peek(grammarDFA::MEMBER, &parser::ruleMEMBER_IDENTIFIER);
+    on_peek(grammarDFA::MEMBER, grammarDFA::T_LBRACKET, &parser::ruleMEMBER_FUNC_CALL);
+    on_peek(grammarDFA::MEMBER, grammarDFA::T_LSQUARE, &parser::ruleMEMBER_ELEMENT);
+
+    fill(grammarDFA::MEMBER_ACCESS, &parser::ruleMEMBER_ACCESS);
+    fill(grammarDFA::TLS_DECL, &parser::ruleTLS_DECL);
+
+    return t;
+}
+
+const parser::production_table parser::table = build_production_table(); // constant initialised, i.e. no run-time cost
+
+/* The parse_table function returns a pointer to a production_rule type function which can be subsequently called, by
+ * looking up the production table with the current non-terminal Symbol and Token (and any peeked tokens). In the case
+ * that no production rule is found for a given Symbol and Token pair, a nullptr is returned, indicating an error.
  */
 parser::production_rule parser::parse_table(grammarDFA::Symbol curr_symbol, lexer::Token* curr_token, lexer* lexer_ptr){
-    production_rule pr;
-
-    switch(curr_symbol){
-        case grammarDFA::PROGRAM:{
-            if(curr_token->symbol == grammarDFA::T_EOF){
-                                                pr = &parser::null_rule;
-            }else{
-                                                pr = &parser::rulePROGRAM;
-            }
-        }                                                                                       break;
-        case grammarDFA::BLOCK:                 pr = &parser::ruleBLOCK;                        break;
-        case grammarDFA::BLOCK_ext:{
-            if(curr_token->symbol == grammarDFA::T_RBRACE){
-                                                pr = &parser::null_rule;
-            }else{
-                                                pr = &parser::ruleBLOCK_ext;
-            }
-        }                                                                                       break;
-        case grammarDFA::DECL: {
-            lexer::Token peek_token;
-            // peek 1 token (if available) and return corresponding production rule
-            if(!(*lexer_ptr).peekTokens(&peek_token, 1)){
-                throw std::runtime_error("Lexer encountered an error while peeking tokens...exiting...");
-            }
-
-            if(peek_token.symbol == grammarDFA::T_LSQUARE){
-                                                pr = &parser::ruleARR_DECL;
-            }else{
-                                                pr = &parser::ruleVAR_DECL;
-            }
-        }                                                                                      break;
-        case grammarDFA::VAR_DECL_ASSIGNMENT: {
-            if(curr_token->symbol == grammarDFA::T_EQUALS){
-                                                pr = &parser::ruleVAR_DECL_ASSIGNMENT;
-            }else{
-                                                pr = &parser::null_rule;
-            }
-        }                                                                                       break;
-        case grammarDFA::ARR_DECL_ASSIGNMENT: {
-            if(curr_token->symbol == grammarDFA::T_EQUALS){
-                                                pr = &parser::ruleARR_DECL_ASSIGNMENT;
-            }else{
-                                                pr = &parser::null_rule;
-            }
-        }                                                                                       break;
-        case grammarDFA::ARR_DECL_ASSIGNMENT_ext: {
-            if(curr_token->symbol == grammarDFA::T_COMMA){
-                                                pr = &parser::ruleARR_DECL_ASSIGNMENT_ext;
-            }else{
-                                                pr = &parser::null_rule;
-            }
-        }                                                                                       break;
-        case grammarDFA::ASSIGNMENT: {
-            lexer::Token peek_token;
-            // peek 1 token (if available) and return corresponding production rule
-            if(!(*lexer_ptr).peekTokens(&peek_token, 1)){
-                throw std::runtime_error("Lexer encountered an error while peeking tokens...exiting...");
-            }
-
-            if(peek_token.symbol == grammarDFA::T_LSQUARE) {
-                                                pr = &parser::ruleASSIGNMENT_ELEMENT;
-            }
-            else if(peek_token.symbol == grammarDFA::T_PERIOD){
-                                                pr = &parser::ruleASSIGNMENT_MEMBER;
-            }else{
-                                                pr = &parser::ruleASSIGNMENT_IDENTIFIER;
-            }
-        }                                                                                       break;
-        case grammarDFA::PRINT:                 pr = &parser::rulePRINT;                        break;
-        case grammarDFA::RETURN:                pr = &parser::ruleRETURN;                       break;
-        case grammarDFA::WHILE:                 pr = &parser::ruleWHILE;                        break;
-        case grammarDFA::FPARAM:                pr = &parser::ruleFPARAM;                       break;
-        case grammarDFA::FPARAM_TYPE: {
-            // peek 1 token (if available) and return corresponding production rule
-            lexer::Token peek_token;
-            if(!(*lexer_ptr).peekTokens(&peek_token, 1)){
-                throw std::runtime_error("Lexer encountered an error while peeking tokens...exiting...");
-            }
+    const production& entry = table.rules[curr_symbol][curr_token->symbol - grammarDFA::n_NTS];
+    production_rule pr = entry.rule;
+
+    if(entry.peek == 1){
+        // peek 1 token (if available) and return corresponding production rule
+        lexer::Token peek_token;
+        if(!(*lexer_ptr).peekTokens(&peek_token, 1)){
+            throw std::runtime_error("Lexer encountered an error while peeking tokens...exiting...");
+        }
 
-            if(peek_token.symbol == grammarDFA::T_LSQUARE){
-                                                pr = &parser::ruleFPARAM_TYPE_ARR;
-            }else{
-                                                pr = &parser::ruleFPARAM_TYPE_VAR;
-            }
-        }                                                                                       break;
-        case grammarDFA::FPARAMS:               pr = &parser::ruleFPARAMS;                      break;
-        case grammarDFA::FPARAMS_ext: {
-            if(curr_token->symbol == grammarDFA::T_COMMA){
-                                                pr = &parser::ruleFPARAMS_ext_T_COMMA;
-            }else{
-                                                pr = &parser::null_rule;
-            }
-        }                                                                                       break;
-        case grammarDFA::APARAMS:               pr = &parser::ruleAPARAMS;                      break;
-        case grammarDFA::APARAMS_ext: {
-            if(curr_token->symbol == grammarDFA::T_COMMA){
-                                                pr = &parser::ruleAPARAMS_ext_T_COMMA;
-            }else{
-                                                pr = &parser::null_rule;
-            }
-        }                                                                                       break;
-        case grammarDFA::SUBEXPR:               pr = &parser::ruleSUBEXPR;                      break;
-        case grammarDFA::LITERAL: {
-            switch(curr_token->symbol){
-                case grammarDFA::T_INT:         pr = &parser::ruleLITERAL_T_INT;                break;
-                case grammarDFA::T_BOOL:        pr = &parser::ruleLITERAL_T_BOOL;               break;
-                case grammarDFA::T_STRING:      pr = &parser::ruleLITERAL_T_STRING;             break;
-                case grammarDFA::T_FLOAT:       pr = &parser::ruleLITERAL_T_FLOAT;              break;
-                case grammarDFA::T_CHAR:        pr = &parser::ruleLITERAL_T_CHAR;               break;
-                default: {                      pr = nullptr;
-                    std::cerr << "ln " << curr_token->line << ": expected bool, int, float, char, or string literal, read \""
-                    << curr_token->lexeme << "\" instead" << std::endl;
-                }
-            }
-        }                                                                                       break;
-        case grammarDFA::UNARY: {
-            switch(curr_token->symbol){
-                case grammarDFA::T_MINUS:       pr = &parser::ruleUNARY_T_MINUS;                break;
-                case grammarDFA::T_NOT:         pr = &parser::ruleUNARY_T_NOT;                  break;
-                default: {                      pr = nullptr;
-                    std::cerr << "ln " << curr_token->line << ": expected + or not operator, read \""
-                    << curr_token->lexeme << "\" instead" << std::endl;
-                }
-            }
-        }                                                                                       break;
-        case grammarDFA::FUNC_CALL:             pr = &parser::ruleFUNC_CALL;                    break;
-        case grammarDFA::FUNC_CALL_APARAMS: {
-            if(curr_token->symbol == grammarDFA::T_RBRACKET){
-                                                pr = &parser::optional_pass_rule;
-            }else{
-                                                pr = &parser::ruleFUNC_CALL_APARAMS;
-            }
-        }                                                                                       break;
-        case grammarDFA::IF:                    pr = &parser::ruleIF;                           break;
-        case grammarDFA::ELSE: {
-            if(curr_token->symbol == grammarDFA::T_ELSE){
-                                                pr = &parser::ruleELSE_T_ELSE;
-            }else{
-                                                pr = &parser::optional_pass_rule;
-            }
-        }                                                                                       break;
-        case grammarDFA::FUNC_DECL: {
-            lexer::Token peek_token;
-            // peek 1 token (if available) and return corresponding production rule
-            if(!(*lexer_ptr).peekTokens(&peek_token, 1)){
-                throw std::runtime_error("Lexer encountered an error while peeking tokens...exiting...");
-            }
+        pr = table.lookahead[curr_symbol][peek_token.symbol - grammarDFA::n_NTS];
+    }
+    else if(entry.peek == 3){ // i.e. STATEMENT on T_IDENTIFIER
+        // peek 3 tokens (if available) and return corresponding production rule
+        // this is the production expansion which we mentioned in the documentation that we believe could
+        // be reduced to k = 2
+        lexer::Token peek_tokens[3];
+        if(!(*lexer_ptr).peekTokens(peek_tokens, 3)){
+            throw std::runtime_error("Lexer encountered an error while peeking tokens...exiting...");
+        }
 
-            if(peek_token.symbol == grammarDFA::T_LSQUARE){
-                                                pr = &parser::ruleFUNC_DECL_ARR;
-            }else{
-                                                pr = &parser::ruleFUNC_DECL;
-            }
-        }                                                                                       break;
-        case grammarDFA::FUNC_DECL_FPARAMS: {
-            if(curr_token->symbol == grammarDFA::T_RBRACKET){
-                                                pr = &parser::optional_pass_rule;
-            }else{
-                                                pr = &parser::ruleFUNC_DECL_FPARAMS;
-            }
-        }                                                                                       break;
-        case grammarDFA::FOR:                   pr = &parser::ruleFOR;                          break;
-        case grammarDFA::FOR_DECL: {
-            if(curr_token->symbol == grammarDFA::T_SEMICOLON){
-                                                pr = &parser::optional_pass_rule;
-            }else{
-                                                pr = &parser::ruleFOR_DECL;
-            }
-        }                                                                                       break;
-        case grammarDFA::FOR_EXPRESSION: {
-            if(curr_token->symbol == grammarDFA::T_SEMICOLON){
-                                                pr = nullptr;
-
-                std::cerr << "ln " << curr_token->line << ": expected expression in for-loop (2nd argument)" << std::endl;
-            }else{
-                                                pr = &parser::ruleFOR_EXPRESSION;
-            }
-        }                                                                                       break;
-        case grammarDFA::FOR_ASSIGNMENT: {
-            if(curr_token->symbol == grammarDFA::T_RBRACKET){
-                                                pr = &parser::optional_pass_rule;
-            }else{
-                                                pr = &parser::ruleFOR_ASSIGNMENT;
-            }
-        }                                                                                       break;
-        case grammarDFA::STATEMENT: {
-            switch(curr_token->symbol){
-                case grammarDFA::T_LET:         pr = &parser::ruleSTATEMENT_T_LET_DECL;         break;
-                case grammarDFA::T_IDENTIFIER:  {
-                    // peek 3 tokens (if available) and return corresponding production rule
-                    // this is the production expansion which we mentioned in the documentation that we believe could
-                    // be reduced to k = 2
-                    lexer::Token peek_tokens[3];
-                    if(!(*lexer_ptr).peekTokens(peek_tokens, 3)){
-                        throw std::runtime_error("Lexer encountered an error while peeking tokens...exiting...");
-                    }
+        if(peek_tokens[0].symbol == grammarDFA::T_IDENTIFIER || peek_tokens[1].symbol == grammarDFA::T_RSQUARE){
+            pr = &parser::ruleSTATEMENT_T_IDENTIFIER_AS_TYPE;
+        }
+        else if(peek_tokens[0].symbol == grammarDFA::T_LBRACKET){
+            pr = &parser::ruleSTATEMENT_T_IDENTIFIER_FUNC_CALL;
+        }
+        else if(peek_tokens[0].symbol == grammarDFA::T_PERIOD && peek_tokens[2].symbol == grammarDFA::T_LBRACKET){
+            pr = &parser::ruleSTATEMENT_T_IDENTIFIER_MEMBER_ACC;
+        }else{
+            pr = &parser::ruleSTATEMENT_T_IDENTIFIER_ASSIGNMENT;
+        }
+    }
 
-                    if(peek_tokens[0].symbol == grammarDFA::T_IDENTIFIER ||
-                       peek_tokens[1].symbol == grammarDFA::T_RSQUARE){
-                                                pr = &parser::ruleSTATEMENT_T_IDENTIFIER_AS_TYPE;
-                    }
-                    else if(peek_tokens[0].symbol == grammarDFA::T_LBRACKET){
-                                                pr = &parser::ruleSTATEMENT_T_IDENTIFIER_FUNC_CALL;
-                    }
-                    else if(peek_tokens[0].symbol == grammarDFA::T_PERIOD &&
-                            peek_tokens[2].symbol == grammarDFA::T_LBRACKET){
-                                                pr = &parser::ruleSTATEMENT_T_IDENTIFIER_MEMBER_ACC;
-                    }else{
-                                                pr = &parser::ruleSTATEMENT_T_IDENTIFIER_ASSIGNMENT;
-                    }
-                }                                                                               break;
-                case grammarDFA::T_PRINT:       pr = &parser::ruleSTATEMENT_T_PRINT;            break;
-                case grammarDFA::T_IF:          pr = &parser::ruleSTATEMENT_T_IF;               break;
-                case grammarDFA::T_FOR:         pr = &parser::ruleSTATEMENT_T_FOR;              break;
-                case grammarDFA::T_WHILE:       pr = &parser::ruleSTATEMENT_T_WHILE;            break;
-                case grammarDFA::T_RETURN:      pr = &parser::ruleSTATEMENT_T_RETURN;           break;
-                case grammarDFA::T_TYPE:        pr = &parser::ruleSTATEMENT_T_TYPE;             break;
-                case grammarDFA::T_LBRACE:      pr = &parser::ruleSTATEMENT_T_LBRACE;           break;
-                case grammarDFA::T_TLSTRUCT:    pr = &parser::ruleSTATEMENT_T_TLSTRUCT;         break;
-                default: {                      pr = nullptr;
-                    std::cerr << "ln " << curr_token->line << ": expected statement (eg. variable declaration, return,"
-                    " for-loop, etc...), read \"" << curr_token->lexeme << "\" instead" << std::endl;
-                }
-            }
-        }                                                                                       break;
-        case grammarDFA::FACTOR: {
-            switch(curr_token->symbol){
-                case grammarDFA::T_BOOL:
-                case grammarDFA::T_INT:
-                case grammarDFA::T_FLOAT:
-                case grammarDFA::T_STRING:
-                case grammarDFA::T_CHAR:        pr = &parser::ruleFACTOR_LITERAL;               break;
-                case grammarDFA::T_LBRACKET:    pr = &parser::ruleFACTOR_SUBEXPR;               break;
-                case grammarDFA::T_MINUS:
-                case grammarDFA::T_NOT:         pr = &parser::ruleFACTOR_UNARY;                 break;
-                case grammarDFA::T_IDENTIFIER: {
-                    // peek 1 token (if available) and return corresponding production rule
-                    lexer::Token peek_token;
-                    if(!(*lexer_ptr).peekTokens(&peek_token, 1)){
-                        throw std::runtime_error("Lexer encountered an error while peeking tokens...exiting...");
-                    }
+    if(pr == nullptr){
+        report_no_rule(curr_symbol, curr_token);
+    }
 
-                    if(peek_token.symbol == grammarDFA::T_LBRACKET){
-                                                pr = &parser::ruleFACTOR_FUNC_CALL;
-                    }
-                    else if(peek_token.symbol == grammarDFA::T_LSQUARE){
-                                                pr = &parser::ruleFACTOR_ELEMENT;
-                    }
-                    else if(peek_token.symbol == grammarDFA::T_PERIOD){
-                                                pr = &parser::ruleFACTOR_MEMBER_ACCESS;
-                    }else{
-                                                pr = &parser::ruleFACTOR_IDENTIFIER;
-                    }
-                }                                                                               break;
-                default: {                      pr = nullptr;
-                    std::cerr << "ln " << curr_token->line << ": expected literal or identifier to a variable/function/etc,"
-                    " read \"" << curr_token->lexeme << "\" instead" << std::endl;
-                }
-            }
-        }                                                                                       break;
-        case grammarDFA::TERM:                  pr = &parser::ruleTERM;                         break;
-        case grammarDFA::TERM_ext: {
-            if(curr_token->symbol == grammarDFA::T_MUL || curr_token->symbol == grammarDFA::T_DIV ||
-            curr_token->symbol == grammarDFA::T_AND){
-                                                pr = &parser::ruleTERM_ext;
-            }else{
-                                                pr = &parser::null_rule;
-            }
-        }                                                                                       break;
-        case grammarDFA::S_EXPR:                pr = &parser::ruleS_EXPR;                       break;
-        case grammarDFA::S_EXPR_ext: {
-            if(curr_token->symbol == grammarDFA::T_PLUS || curr_token->symbol == grammarDFA::T_MINUS ||
-               curr_token->symbol == grammarDFA::T_OR){
-                                                pr = &parser::ruleS_EXPR_ext;
-            }else{
-                                                pr = &parser::null_rule;
-            }
-        }                                                                                       break;
-        case grammarDFA::EXPRESSION:            pr = &parser::ruleEXPRESSION;                   break;
-        case grammarDFA::EXPRESSION_ext: {
-            if(curr_token->symbol == grammarDFA::T_RELOP){
-                                                pr = &parser::ruleEXPRESSION_ext;
-            }else{
-                                                pr = &parser::null_rule;
-            }
-        }                                                                                       break;
-        case grammarDFA::TYPE_VAR:  {
-            if(curr_token->symbol == grammarDFA::T_TYPE){
-                pr = &parser::ruleTYPE_VAR_T_TYPE;
-            }else{
-                pr = &parser::ruleTYPE_VAR_T_IDENTIFIER;
-            }
-        }                                                                                       break;
-        case grammarDFA::TYPE_ARR: {
-            if(curr_token->symbol == grammarDFA::T_TYPE){
-                pr = &parser::ruleTYPE_ARR_T_TYPE;
-            }else{
-                pr = &parser::ruleTYPE_ARR_T_IDENTIFIER;
-            }
-        }                                                                                       break;
-        case grammarDFA::IDENTIFIER:            pr = &parser::ruleIDENTIFIER;                   break;
-        case grammarDFA::ELEMENT:               pr = &parser::ruleELEMENT;                      break;
-        case grammarDFA::MEMBER: {
-            // peek 1 token (if available) and return corresponding production rule
-            lexer::Token peek_token;
-            if(!(*lexer_ptr).peekTokens(&peek_token, 1)){
-                throw std::runtime_error("Lexer encountered an error while peeking tokens...exiting...");
-            }
+    return pr;
+}
 
-            if(peek_token.symbol == grammarDFA::T_LBRACKET){
-                                                pr = &parser::ruleMEMBER_FUNC_CALL;
-            }
-            else if(peek_token.symbol == grammarDFA::T_LSQUARE){
-                                                pr = &parser::ruleMEMBER_ELEMENT;
-            }else{
-                                                pr = &parser::ruleMEMBER_IDENTIFIER;
-            }
-        }                                                                                       break;
-        case grammarDFA::MEMBER_ACCESS:         pr = &parser::ruleMEMBER_ACCESS;                break;
-        case grammarDFA::TLS_DECL:              pr = &parser::ruleTLS_DECL;                     break;
-        default: {                              pr = nullptr;
+// Reports the syntax error arising when no production rule is found for the given Symbol and Token pair
+void parser::report_no_rule(grammarDFA::Symbol curr_symbol, lexer::Token* curr_token){
+    switch(curr_symbol){
+        case grammarDFA::LITERAL:
+            std::cerr << "ln " << curr_token->line << ": expected bool, int, float, char, or string literal, read \""
+            << curr_token->lexeme << "\" instead" << std::endl;
+            break;
+        case grammarDFA::UNARY:
+            std::cerr << "ln " << curr_token->line << ": expected + or not operator, read \""
+            << curr_token->lexeme << "\" instead" << std::endl;
+            break;
+        case grammarDFA::FOR_EXPRESSION:
+            std::cerr << "ln " << curr_token->line << ": expected expression in for-loop (2nd argument)" << std::endl;
+            break;
+        case grammarDFA::STATEMENT:
+            std::cerr << "ln " << curr_token->line << ": expected statement (eg. variable declaration, return,"
+            " for-loop, etc...), read \"" << curr_token->lexeme << "\" instead" << std::endl;
+            break;
+        case grammarDFA::FACTOR:
+            std::cerr << "ln " << curr_token->line << ": expected literal or identifier to a variable/function/etc,"
+            " read \"" << curr_token->lexeme << "\" instead" << std::endl;
+            break;
+        default:
             std::cerr << "ln " << curr_token->line << ": syntax error encountered (unexpected: \"" << curr_token->lexeme
             << "\")" << std::endl;
-        }
     }
-
-    return pr;
 }
 
 /* Utility function for generating (primitive but indicative) syntax errors, by reporting the line number, a textual
@@ -978,6 +894,7 @@ void parser::error_table(grammarDFA::Symbol curr_symbol, lexer::Token* curr_toke
         case grammarDFA::T_LSQUARE: curr_symb_str = "\"[\""; break;
         case grammarDFA::T_RSQUARE: curr_symb_str = "\"]\""; break;
         case grammarDFA::T_TLSTRUCT: curr_symb_str = "\"tlstruct\""; break;
+        case grammarDFA::T_PARALLEL: curr_symb_str = "\"parallel\""; break;
         default: ;
     }
 
@@ -986,7 +903,7 @@ void parser::error_table(grammarDFA::Symbol curr_symbol, lexer::Token* curr_toke
 }
 
 // Convenience function for converting a type lexeme to the corresponding Symbol instance.
-grammarDFA::Symbol parser::type_string2symbol(const string& type){
+grammarDFA::Symbol parser::type_string2symbol(string_view type){
     if(type == "bool"){
         return grammarDFA::T_BOOL;
     }
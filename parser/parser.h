@@ -6,8 +6,9 @@
 #define CPS2000_PARSER_H
 
 #include <iostream>
-#include <stack>
+#include <vector>
 #include "../visitor_ast/astNode.h"
+#include "../visitor_ast/ast_arena.h"
 #include "../lexer/lexer.h"
 #include "../lexer/grammarDFA.h"
 
@@ -23,6 +24,7 @@ public:
         grammarDFA::Symbol symbol;
     };
 
+    ast_arena arena; // holds the nodes of the abstract syntax tree, which is hence freed along with the parser
     astPROGRAM* root;
     int err_count = 0;
 
@@ -36,7 +38,11 @@ private:
     typedef void (parser::*production_rule)(astInnerNode*,  lexer::Token*);
     typedef void (parser::*parse_error)(grammarDFA::Symbol, grammarDFA::Symbol, unsigned int);
 
-    stack<State> state_stack;
+    /* The parsing stack is held in a contiguous vector, with its top at the back; capacity for INITIAL_STACK_DEPTH states
+     * is reserved upfront, which typical programs do not exceed (the depth grows with the nesting of blocks/expressions).
+     */
+    static constexpr int INITIAL_STACK_DEPTH = 256;
+    vector<State> state_stack;
 
     void rulePROGRAM(astInnerNode*,  lexer::Token*);
     void ruleBLOCK(astInnerNode*,  lexer::Token*);
@@ -75,6 +81,7 @@ private:
     void ruleFUNC_DECL_ARR(astInnerNode*,  lexer::Token*);
     void ruleFUNC_DECL_FPARAMS(astInnerNode*,  lexer::Token*);
     void ruleFOR(astInnerNode*,  lexer::Token*);
+    void rulePAR_FOR(astInnerNode*,  lexer::Token*);
     void ruleFOR_DECL(astInnerNode*,  lexer::Token*);
     void ruleFOR_EXPRESSION(astInnerNode*,  lexer::Token*);
     void ruleFOR_ASSIGNMENT(astInnerNode*,  lexer::Token*);
@@ -86,6 +93,7 @@ private:
     void ruleSTATEMENT_T_PRINT(astInnerNode*,  lexer::Token*);
     void ruleSTATEMENT_T_IF(astInnerNode*,  lexer::Token*);
     void ruleSTATEMENT_T_FOR(astInnerNode*,  lexer::Token*);
+    void ruleSTATEMENT_T_PARALLEL(astInnerNode*,  lexer::Token*);
     void ruleSTATEMENT_T_WHILE(astInnerNode*,  lexer::Token*);
     void ruleSTATEMENT_T_RETURN(astInnerNode*,  lexer::Token*);
     void ruleSTATEMENT_T_TYPE(astInnerNode*,  lexer::Token*);
@@ -120,7 +128,27 @@ private:
     static void error_table(grammarDFA::Symbol, lexer::Token*);
     void panic_mode_recovery(lexer* lexer_ptr, lexer::Token*, State*);
     static parser::production_rule parse_table(grammarDFA::Symbol, lexer::Token*, lexer*);
-    static grammarDFA::Symbol type_string2symbol(const string &type);
+    static void report_no_rule(grammarDFA::Symbol, lexer::Token*);
+
+    /* The production table, indexed by a non-terminal Symbol and the Symbol of the current token (less n_NTS), with a
+     * nullptr rule signifying a syntax error. Some expansions cannot be decided on the current token alone, in which case
+     * the entry instead specifies the number of tokens to peek: for k = 1, the rule is looked up in the lookahead table,
+     * indexed by the non-terminal and the Symbol of the peeked token, whereas the single k = 3 decision (a statement
+     * starting with an identifier) is resolved explicitly in parse_table.
+     */
+    struct production{
+        production_rule rule;
+        int peek;
+    };
+
+    struct production_table{
+        production rules[grammarDFA::n_NTS][grammarDFA::n_token_types];
+        production_rule lookahead[grammarDFA::n_NTS][grammarDFA::n_token_types];
+    };
+
+    static constexpr production_table build_production_table();
+    static const production_table table;
+    static grammarDFA::Symbol type_string2symbol(string_view type);
 };
 
 #endif //CPS2000_PARSER_H
@@ -0,0 +1,306 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "resolver.h"
+
+// ----- SCOPING UTILITY FUNCTIONS -----
+
+// Finds the binding of the identifier in the innermost scope declaring it, returning nullptr if not found
+resolver::binding* resolver::lookup(const string& identifier){
+    for(auto scope = scopes.rbegin(); scope != scopes.rend(); scope++){
+        auto it = scope->find(identifier);
+
+        if(it != scope->end()){
+            return &it->second;
+        }
+    }
+
+    return nullptr;
+}
+
+// Returns true if declarations in the current scope are members of a tlstruct, i.e. we are in a tlstruct definition block
+bool resolver::declaring_member(){
+    return tls_top_scope != -1 && tls_top_scope == (int) scopes.size() - 1;
+}
+
+// Binds the declared identifier to the next free slot in the current frame (or, in a tlstruct definition, to the offset
+// of the member as laid out during semantic analysis)
+void resolver::declare(astIDENTIFIER* node){
+    frame_context& frame = frames.back();
+
+    if(declaring_member()){
+        node->depth = -1;
+        scopes.back()[node->lexeme] = binding{MEMBER, frame.level, node->slot, nullptr};
+    }
+    else{
+        node->depth = 0;
+        node->slot = frame.next_slot++;
+        frame.max_slot = max(frame.max_slot, frame.next_slot);
+
+        scopes.back()[node->lexeme] = binding{SLOT, frame.level, node->slot, nullptr};
+    }
+}
+
+// Annotates an identifier referring to a variable with its frame address (or, for a member, its offset)
+void resolver::resolve(astIDENTIFIER* node){
+    binding* ret_binding = lookup(node->lexeme);
+
+    if(ret_binding != nullptr && ret_binding->kind == SLOT){
+        node->depth = frames.back().level - ret_binding->level;
+        node->slot = ret_binding->slot;
+    }
+    else if(ret_binding != nullptr && ret_binding->kind == MEMBER){
+        node->depth = -1;
+        node->slot = ret_binding->slot;
+    }
+    else{ // members accessed through an instance (and, assuming a semantically correct AST, nothing else)
+        node->depth = -1;
+    }
+}
+
+// Annotates a tlstruct named type with its definition, and the frame in which it is defined (for instantiation)
+void resolver::resolve_type(astTYPE* node){
+    if(node->type == grammarDFA::T_TLSTRUCT){
+        binding* ret_binding = lookup(node->lexeme);
+
+        if(ret_binding != nullptr && ret_binding->kind == STRUCT){
+            node->tls_ref = ret_binding->tls_ref;
+            node->depth = frames.back().level - ret_binding->level;
+        }
+    }
+}
+
+// ----- RESOLVER VISITOR RULES -----
+
+void resolver::visit(astTYPE* node){}
+void resolver::visit(astLITERAL* node){}
+
+void resolver::visit(astIDENTIFIER* node){
+    resolve(node);
+}
+
+void resolver::visit(astELEMENT* node){
+    resolve((astIDENTIFIER*) node->identifier());
+    node->index()->accept(this);
+}
+
+void resolver::visit(astMULTOP* node){
+    node->operand1()->accept(this);
+    node->operand2()->accept(this);
+}
+
+void resolver::visit(astADDOP* node){
+    node->operand1()->accept(this);
+    node->operand2()->accept(this);
+}
+
+void resolver::visit(astRELOP* node){
+    node->operand1()->accept(this);
+    node->operand2()->accept(this);
+}
+
+void resolver::visit(astAPARAMS* node){
+    for(auto &c : node->children){
+        c->accept(this);
+    }
+}
+
+void resolver::visit(astFUNC_CALL* node){
+    // the static parent of the callee is the frame in which the callee is declared
+    auto ret_level = func_levels.find(node->callee->func_ref);
+    if(ret_level != func_levels.end()){
+        node->depth = frames.back().level - ret_level->second;
+    }
+
+    if(node->aparams() != nullptr){ node->aparams()->accept(this);}
+}
+
+void resolver::visit(astSUBEXPR* node){
+    node->subexpr()->accept(this);
+}
+
+void resolver::visit(astUNARY* node){
+    node->operand()->accept(this);
+}
+
+void resolver::visit(astASSIGNMENT_IDENTIFIER* node){
+    resolve((astIDENTIFIER*) node->identifier());
+    node->expression()->accept(this);
+}
+
+void resolver::visit(astASSIGNMENT_ELEMENT* node){
+    node->element()->accept(this);
+    node->expression()->accept(this);
+}
+
+void resolver::visit(astASSIGNMENT_MEMBER* node){
+    resolve((astIDENTIFIER*) node->tls_name());
+
+    // the member being assigned is annotated with its offset in the instance, hence only the expressions are resolved
+    if(auto* assignment = dynamic_cast<astASSIGNMENT_IDENTIFIER*>(node->assignment())){
+        assignment->expression()->accept(this);
+    }
+    else{
+        auto* element_assignment = (astASSIGNMENT_ELEMENT*) node->assignment();
+
+        ((astELEMENT*) element_assignment->element())->index()->accept(this);
+        element_assignment->expression()->accept(this);
+    }
+}
+
+void resolver::visit(astVAR_DECL* node){
+    // as in semantic analysis, the variable is not in scope in its own initialisation
+    if(node->expression() != nullptr){ node->expression()->accept(this);}
+
+    resolve_type((astTYPE*) node->type());
+    declare((astIDENTIFIER*) node->identifier());
+}
+
+void resolver::visit(astARR_DECL* node){
+    for(uint32_t i = 1; i < node->n_children; i++){ // i.e. the size and the elements being assigned (skipping the type)
+        if(i != 2){ node->children.at(i)->accept(this);}
+    }
+
+    resolve_type((astTYPE*) node->type());
+    declare((astIDENTIFIER*) node->identifier());
+}
+
+/* The statements in a tlstruct definition block are executed on each instantiation, in a frame whose static parent is
+ * the frame in which the tlstruct is defined. Top-level declarations are members, laid out in declaration order, and
+ * top-level functions are member functions, which are declared at the level of the tlstruct definition (rather than of
+ * the instantiation frame).
+ */
+void resolver::visit(astTLS_DECL* node){
+    string tls_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    auto* tls_block = (astBLOCK*) node->tls_block();
+    int level = frames.back().level;
+
+    frames.push_back(frame_context{level + 1, 0, 0});
+    scopes.emplace_back();
+
+    int ref_tls_top_scope = tls_top_scope;
+    tls_top_scope = (int) scopes.size() - 1;
+
+    for(auto &c : tls_block->children){
+        c->accept(this);
+    }
+
+    tls_top_scope = ref_tls_top_scope;
+    scopes.pop_back();
+
+    tls_block->frame_size = frames.back().max_slot;
+    frames.pop_back();
+
+    // as in semantic analysis, the named type is only accessible after the definition
+    scopes.back()[tls_ident] = binding{STRUCT, level, -1, tls_block};
+}
+
+void resolver::visit(astPRINT* node){
+    node->expression()->accept(this);
+}
+
+void resolver::visit(astRETURN* node){
+    node->expression()->accept(this);
+}
+
+void resolver::visit(astIF* node){
+    node->expression()->accept(this);
+    node->if_block()->accept(this);
+    if(node->else_block() != nullptr){ node->else_block()->accept(this);}
+}
+
+void resolver::visit(astFOR* node){
+    int ref_next_slot = frames.back().next_slot;
+
+    // the optional declaration is accessible in the scope of the for-block
+    scopes.emplace_back();
+
+    if(node->decl() != nullptr){ node->decl()->accept(this);}
+    node->expression()->accept(this);
+    if(node->assignment() != nullptr){ node->assignment()->accept(this);}
+    node->for_block()->accept(this);
+
+    scopes.pop_back();
+    frames.back().next_slot = ref_next_slot; // slots are reused by subsequent blocks
+}
+
+void resolver::visit(astPAR_FOR* node){
+    visit((astFOR*) node);
+}
+
+void resolver::visit(astWHILE* node){
+    node->expression()->accept(this);
+    if(node->while_block() != nullptr){ node->while_block()->accept(this);}
+}
+
+void resolver::visit(astFPARAMS* node){
+    for(auto &c : node->children){
+        c->accept(this);
+    }
+}
+
+void resolver::visit(astFPARAM* node){
+    declare((astIDENTIFIER*) node->identifier());
+}
+
+void resolver::visit(astFUNC_DECL* node){
+    auto* function_block = (astBLOCK*) node->function_block();
+
+    // member functions are declared at the level of the tlstruct definition, rather than of the instantiation frame
+    int level = declaring_member() ? frames.back().level - 1 : frames.back().level;
+    func_levels[function_block] = level;
+
+    // the formal parameters occupy the first slots of the frame of the function, in order
+    frames.push_back(frame_context{level + 1, 0, 0});
+    scopes.emplace_back();
+
+    if(node->fparams() != nullptr){ node->fparams()->accept(this);}
+    for(auto &c : function_block->children){
+        c->accept(this);
+    }
+
+    scopes.pop_back();
+
+    function_block->frame_size = frames.back().max_slot;
+    frames.pop_back();
+}
+
+void resolver::visit(astMEMBER_ACCESS* node){
+    resolve((astIDENTIFIER*) node->tls_name());
+
+    // the member is annotated with its offset in the instance, hence only the index or actual parameters are resolved
+    if(auto* element = dynamic_cast<astELEMENT*>(node->member())){
+        element->index()->accept(this);
+    }
+    else if(dynamic_cast<astFUNC_CALL*>(node->member()) != nullptr){
+        node->member()->accept(this);
+    }
+}
+
+void resolver::visit(astBLOCK* node){
+    int ref_next_slot = frames.back().next_slot;
+
+    scopes.emplace_back();
+    for(auto &c : node->children){
+        c->accept(this);
+    }
+    scopes.pop_back();
+
+    frames.back().next_slot = ref_next_slot; // slots are reused by subsequent blocks
+}
+
+void resolver::visit(astPROGRAM* node){
+    frames.push_back(frame_context{0, 0, 0});
+
+    for(auto &c : node->children){
+        c->accept(this);
+    }
+
+    node->frame_size = frames.back().max_slot;
+    frames.pop_back();
+}
+
+void resolver::visit(astHOISTED* node){
+    node->expression()->accept(this);
+}
@@ -0,0 +1,92 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_RESOLVER_H
+#define CPS2000_RESOLVER_H
+
+#include <unordered_map>
+#include "../symbol_table/symbol.h"
+#include "../visitor_ast/visitor.h"
+
+/* Carries out name resolution on a (semantically checked) abstract syntax tree, such that the interpreter need not look
+ * up identifiers in a symbol table at run time.
+ *
+ * Each function call (as well as the main program and each tlstruct instantiation) executes in a frame, i.e. a flat
+ * array of slots holding the variables declared in the function, with variables in disjoint blocks sharing slots. Each
+ * frame maintains a static link to the frame of the lexically enclosing function. Hence every identifier referring to a
+ * variable is annotated with a (depth, slot) address: the number of static links to follow from the current frame, and
+ * the slot in the frame reached. Likewise each function call is annotated with the number of static links to follow to
+ * reach the static parent of the callee, and each block defining a function (or tlstruct) with the size of its frame.
+ *
+ * Members of tlstruct instances are not held in frames, but in the record of the instance (see tl_record), at the offset
+ * assigned during semantic analysis; identifiers referring to members are hence annotated with a depth of -1 (and their
+ * offset). Scoping rules are identical to those in semantic analysis.
+ */
+class resolver: public visitor{
+public:
+    void visit(astTYPE* node) override;
+    void visit(astLITERAL* node) override;
+    void visit(astIDENTIFIER* node) override;
+    void visit(astELEMENT* node) override;
+    void visit(astMULTOP* node) override;
+    void visit(astADDOP* node) override;
+    void visit(astRELOP* node) override;
+    void visit(astAPARAMS* node) override;
+    void visit(astFUNC_CALL* node) override;
+    void visit(astSUBEXPR* node) override;
+    void visit(astUNARY* node) override;
+    void visit(astASSIGNMENT_IDENTIFIER* node) override;
+    void visit(astASSIGNMENT_ELEMENT* node) override;
+    void visit(astASSIGNMENT_MEMBER* node) override;
+    void visit(astVAR_DECL* node) override;
+    void visit(astARR_DECL* node) override;
+    void visit(astTLS_DECL* node) override;
+    void visit(astPRINT* node) override;
+    void visit(astRETURN* node) override;
+    void visit(astIF* node) override;
+    void visit(astFOR* node) override;
+    void visit(astPAR_FOR* node) override;
+    void visit(astWHILE* node) override;
+    void visit(astFPARAMS* node) override;
+    void visit(astFPARAM* node) override;
+    void visit(astFUNC_DECL* node) override;
+    void visit(astMEMBER_ACCESS* node) override;
+    void visit(astBLOCK* node) override;
+    void visit(astPROGRAM* node) override;
+    void visit(astHOISTED* node) override;
+
+private:
+    enum BindingKind{
+        SLOT, MEMBER, STRUCT
+    };
+
+    // what an identifier is bound to: a slot in a frame at the specified (static nesting) level, a tlstruct member (at
+    // the offset held in slot), or a tlstruct definition (defined in the frame at the specified level)
+    struct binding{
+        BindingKind kind;
+        int level;
+        int slot;
+        astBLOCK* tls_ref;
+    };
+
+    // maintains the slot allocation state of a frame being resolved
+    struct frame_context{
+        int level;
+        int next_slot;
+        int max_slot;
+    };
+
+    vector<unordered_map<string, binding>> scopes = vector<unordered_map<string, binding>>(1);
+    vector<frame_context> frames;
+    unordered_map<astBLOCK*, int> func_levels; // level of the frame in which each function is declared
+    int tls_top_scope = -1; // scope index of the members of the tlstruct being declared, -1 if not in a tlstruct body
+
+    binding* lookup(const string& identifier);
+    bool declaring_member();
+    void declare(astIDENTIFIER* node);
+    void resolve(astIDENTIFIER* node);
+    void resolve_type(astTYPE* node);
+};
+
+#endif //CPS2000_RESOLVER_H
@@ -33,6 +33,7 @@ public:
     void visit(astRETURN* node) override;
     void visit(astIF* node) override;
     void visit(astFOR* node) override;
+    void visit(astPAR_FOR* node) override;
     void visit(astWHILE* node) override;
     void visit(astFPARAMS* node) override;
     void visit(astFPARAM* node) override;
@@ -40,6 +41,7 @@ public:
     void visit(astMEMBER_ACCESS* node) override;
     void visit(astBLOCK* node) override;
     void visit(astPROGRAM* node) override;
+    void visit(astHOISTED* node) override;
 
     explicit graphviz_ast_visitor(string filename);
 
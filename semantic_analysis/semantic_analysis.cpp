@@ -45,15 +45,61 @@ string semantic_analysis::typeVect_symbol2string(vector<symbol*>* typeVect){
  *
  * In the case where both operands are of an anonymous type, we also report a semantic error.
  */
+/* If the declaration being checked is a member of a tlstruct, assigns the member the next offset in the layout of the
+ * tlstruct; the offset is maintained by the member symbol, such that identifiers referring to the member (including those
+ * accessing the member of an instance) are annotated with it.
+ */
+void semantic_analysis::declare_member(symbol* member, astIDENTIFIER* identifier){
+    if(member_layout != nullptr){
+        member->offset = member_layout->n_fields++;
+
+        identifier->depth = -1;
+        identifier->slot = member->offset;
+    }
+}
+
+/* Reports a semantic error if the identifier following a member access (or assignment) refers to a variable which is not
+ * a member of the tlstruct type, i.e. a symbol without an offset; since the symbol table of a tlstruct definition is
+ * linked to that in which the tlstruct is defined, such identifiers would otherwise resolve to variables outside of the
+ * instance.
+ */
+void semantic_analysis::check_member(astNode* member, symbol* tls_instance){
+    astNode* identifier = member;
+
+    if(auto* assignment = dynamic_cast<astASSIGNMENT_IDENTIFIER*>(member)){
+        identifier = assignment->identifier();
+    }
+    else if(auto* element_assignment = dynamic_cast<astASSIGNMENT_ELEMENT*>(member)){
+        identifier = ((astELEMENT*) element_assignment->element())->identifier();
+    }
+    else if(auto* element = dynamic_cast<astELEMENT*>(member)){
+        identifier = element->identifier();
+    }
+
+    // member function calls are bound to the function during semantic analysis, and hence are not held by instances
+    if(identifier == nullptr || identifier->kind != astNode::T_IDENTIFIER){
+        return;
+    }
+
+    string member_ident = ((astIDENTIFIER*) identifier)->lexeme;
+    symbol* ret_symbol = tls_instance->object.t->lookup(member_ident);
+
+    if(ret_symbol != nullptr && ret_symbol->offset == -1){
+        err_count++;
+        std::cerr << "ln " << member->line << ": " << member_ident << " is not a member of tlstruct " <<
+        tls_instance->type.second << std::endl;
+    }
+}
+
 void semantic_analysis::binop_type_check(astBinaryOp* binop_node){
     // temporary variables to store state for each operand evaluation
     bool op1_type_err, op2_type_err;
-    grammarDFA::Symbol op1_obj_class, op2_obj_class;
+    grammarDFA::Symbol op1_obj_class = curr_obj_class, op2_obj_class = curr_obj_class;
     type_t op1_type, op2_type;
 
     // evaluate first expression (operand) and store internal state
-    if(binop_node->operand1 != nullptr){
-        binop_node->operand1->accept(this);
+    if(binop_node->operand1() != nullptr){
+        binop_node->operand1()->accept(this);
         op1_type_err = type_deduction_reqd; type_deduction_reqd = false; op1_type = curr_type; op1_obj_class = curr_obj_class;
     }
     else{
@@ -61,8 +107,8 @@ void semantic_analysis::binop_type_check(astBinaryOp* binop_node){
     }
 
     // evaluate second expression (operand) and store internal state
-    if(binop_node->operand2 != nullptr){
-        binop_node->operand2->accept(this);
+    if(binop_node->operand2() != nullptr){
+        binop_node->operand2()->accept(this);
         op2_type_err = type_deduction_reqd; type_deduction_reqd = false; op2_type = curr_type; op2_obj_class = curr_obj_class;
     }
     else{
@@ -107,6 +153,208 @@ void semantic_analysis::binop_type_check(astBinaryOp* binop_node){
 
     curr_type = op1_type;
     curr_obj_class = op1_obj_class;
+    binop_node->object_class = curr_obj_class; // annotate the node for the interpreter
+}
+
+// ----- PARALLEL FOR LOOP UTILITY FUNCTIONS -----
+
+// Returns true if the node is an identifier with the specified lexeme
+static bool is_identifier(astNode* node, const string& lexeme){
+    return node != nullptr && node->kind == astNode::T_IDENTIFIER && ((astIDENTIFIER*) node)->lexeme == lexeme;
+}
+
+/* Checks that the header of a parallel for loop is of the form parallel for(let i:int = a; i < b; i = i + 1) (or with
+ * i <= b), where the bound b is invariant in the loop, reporting a semantic error otherwise. If so, the variable of the
+ * loop is set as the induction variable of the region of its body.
+ */
+bool semantic_analysis::par_for_header(astPAR_FOR* node, par_region* region){
+    auto* decl = dynamic_cast<astVAR_DECL*>(node->decl());
+    auto* condition = dynamic_cast<astRELOP*>(node->expression());
+    auto* step = dynamic_cast<astASSIGNMENT_IDENTIFIER*>(node->assignment());
+
+    if(decl != nullptr && decl->expression() != nullptr && ((astTYPE*) decl->type())->type == grammarDFA::T_INT &&
+       condition != nullptr && (condition->op == "<" || condition->op == "<=") && step != nullptr){
+        string induction = ((astIDENTIFIER*) decl->identifier())->lexeme;
+        auto* increment = dynamic_cast<astADDOP*>(step->expression());
+
+        if(is_identifier(condition->operand1(), induction) && is_identifier(step->identifier(), induction) &&
+           increment != nullptr && increment->op == "+" && is_identifier(increment->operand1(), induction) &&
+           increment->operand2()->kind == astNode::LITERAL && ((astLITERAL*) increment->operand2())->lexeme == "1"){
+            // the bound is evaluated once, prior to executing the iterations
+            if(!par_invariant(condition->operand2(), induction, region)){
+                err_count++;
+                std::cerr << "ln " << node->line << ": the bound of a parallel for loop cannot refer to " << induction
+                << " or call functions" << std::endl;
+
+                return false;
+            }
+
+            region->induction = curr_symbolTable->lookup(induction);
+            return true;
+        }
+    }
+
+    err_count++;
+    std::cerr << "ln " << node->line << ": parallel for loop must be of the form parallel for(let i:int = a; i < b; "
+    "i = i + 1) (or i <= b)" << std::endl;
+
+    return false;
+}
+
+/* Returns true if an expression neither refers to the variable of a loop nor calls a function, and is hence invariant in
+ * the loop, since the loop cannot assign to variables declared outside of it. Elements read by the expression are
+ * recorded as read by the loop (at an index other than that of the loop), since the loop may assign to them.
+ */
+bool semantic_analysis::par_invariant(astNode* node, const string& induction, par_region* region){
+    if(node == nullptr || node->kind == astNode::LITERAL){
+        return true;
+    }
+    else if(node->kind == astNode::T_IDENTIFIER){
+        return ((astIDENTIFIER*) node)->lexeme != induction;
+    }
+    else if(node->kind == astNode::FUNC_CALL){
+        return false;
+    }
+    else if(node->kind == astNode::ELEMENT && region != nullptr){
+        symbol* arr = curr_symbolTable->lookup(((astIDENTIFIER*) ((astELEMENT*) node)->identifier())->lexeme);
+        if(arr != nullptr){ region->indexed_reads.emplace_back(arr, node->line);}
+    }
+    else if(node->kind == astNode::MEMBER_ACCESS){
+        // members are not variables of the loop, and their elements cannot be assigned to by the loop
+        astNode* member = ((astInnerNode*) node)->children.at(1);
+        return member->kind == astNode::T_IDENTIFIER || par_invariant(member, induction, nullptr);
+    }
+
+    for(auto &c : ((astInnerNode*) node)->children){
+        if(!par_invariant(c, induction, region)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Maintains the region in which a variable is declared (if any)
+void semantic_analysis::par_declare(symbol* s){
+    if(curr_region != nullptr){
+        declared_in[s] = curr_region;
+    }
+}
+
+// Returns true if a variable is declared within a region (including the regions of the loops nested within it)
+bool semantic_analysis::par_local(symbol* s, par_region* region){
+    auto it = declared_in.find(s);
+
+    for(par_region* decl_region = it == declared_in.end() ? nullptr : it->second; decl_region != nullptr;
+        decl_region = decl_region->enclosing){
+        if(decl_region == region){
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Reports an access which is not allowed within a region: in the case of a loop, as a semantic error, whereas in the case
+ * of a function, the (first such) access is recorded, and reported if the function is called within a loop.
+ */
+void semantic_analysis::par_violation(par_region* region, unsigned int line, const string& reason){
+    if(region->func == nullptr){
+        err_count++;
+        std::cerr << "ln " << line << ": parallel for loop cannot " << reason << std::endl;
+    }
+    else if(unsafe_funcs.count(region->func) == 0){
+        unsafe_funcs[region->func] = make_pair(reason, line);
+    }
+}
+
+/* Checks an access to a variable (if index is nullptr) or an element of an array (at the specified index) against each
+ * enclosing region within which the variable is not declared, i.e. against which the iterations of the loop (or the
+ * calls of the function) are not independent; see visit(astPAR_FOR).
+ */
+void semantic_analysis::par_access(symbol* s, unsigned int line, bool write, astNode* index){
+    for(par_region* region = curr_region; region != nullptr && !par_local(s, region); region = region->enclosing){
+        if(index == nullptr && write){
+            par_violation(region, line, "assign to variable " + s->identifier + " declared outside of it");
+            return;
+        }
+        else if(index == nullptr){
+            // strings, arrays and tlstruct instances are reference counted, hence cannot be held concurrently
+            if(s->object_class == grammarDFA::ARRAY || s->type.first == grammarDFA::T_STRING ||
+               s->type.first == grammarDFA::T_TLSTRUCT){
+                par_violation(region, line, "read " + type_symbol2string(s->type.second, s->object_class) + " " +
+                s->identifier + " declared outside of it");
+                return;
+            }
+        }
+        else if(region->func != nullptr){
+            par_violation(region, line, string(write ? "assign to" : "read") + " elements of array " + s->identifier +
+            " declared outside of it");
+            return;
+        }
+        else if(s->type.first == grammarDFA::T_STRING || s->type.first == grammarDFA::T_TLSTRUCT){
+            par_violation(region, line, "access elements of " + type_symbol2string(s->type.second, grammarDFA::ARRAY)
+            + " " + s->identifier + " declared outside of it");
+            return;
+        }
+        else if(write){
+            // distinct iterations hence assign to distinct elements, while the type of an auto array is set on assignment
+            if(!is_identifier(index, region->induction->identifier) ||
+               curr_symbolTable->lookup(region->induction->identifier) != region->induction){
+                par_violation(region, line, "assign to elements of array " + s->identifier + " declared outside of it, "
+                "other than at index " + region->induction->identifier);
+                return;
+            }
+            else if(auto_arrays.count(s) > 0){
+                par_violation(region, line, "assign to elements of array " + s->identifier + " declared with type auto "
+                "outside of it");
+                return;
+            }
+
+            region->written.insert(s);
+        }
+        else if(!is_identifier(index, region->induction->identifier) ||
+                curr_symbolTable->lookup(region->induction->identifier) != region->induction){
+            region->indexed_reads.emplace_back(s, line);
+        }
+    }
+}
+
+/* Records a call within a region: calls within a loop are checked once all functions have been declared (and hence
+ * checked), whereas calls within a function are recorded as edges of the call graph.
+ */
+void semantic_analysis::par_call(funcSymbol* func, unsigned int line){
+    bool in_loop = false;
+
+    for(par_region* region = curr_region; region != nullptr; region = region->enclosing){
+        if(region->func != nullptr){
+            callees[region->func].push_back(func);
+        }
+        else if(!in_loop){
+            parallel_calls.emplace_back(func, line);
+            in_loop = true;
+        }
+    }
+}
+
+// Returns a function (if any) which may be called by the specified function and carries out a restricted access
+funcSymbol* semantic_analysis::par_unsafe_callee(funcSymbol* func, unordered_set<funcSymbol*>& visited){
+    if(!visited.insert(func).second){
+        return nullptr;
+    }
+    else if(unsafe_funcs.count(func) > 0){
+        return func;
+    }
+
+    for(funcSymbol* callee : callees[func]){
+        funcSymbol* unsafe = par_unsafe_callee(callee, visited);
+
+        if(unsafe != nullptr){
+            return unsafe;
+        }
+    }
+
+    return nullptr;
 }
 
 // ----- SEMANTIC ANALYSIS VISITOR RULES -----
@@ -121,14 +369,24 @@ void semantic_analysis::visit(astLITERAL* node){
 
 // Only called when the identifier refers to an operand standing for a variable/array/struct, not for eg. a function  call or array element
 void semantic_analysis::visit(astIDENTIFIER* node){
+    bool write = assigning; assigning = false;
+    bool member = lookup_symbolTable != curr_symbolTable;
+
     // find symbol in lookup symbol table
     symbol* ret_symbol = lookup_symbolTable->lookup(node->lexeme);
     lookup_symbolTable = curr_symbolTable; // and point back to current symbol table
 
     if(ret_symbol != nullptr){ // if symbol for identifier was found, then we can determine type and object class
+        if(curr_region != nullptr && !member){ par_access(ret_symbol, node->line, write, nullptr);}
+
         curr_type = ret_symbol->type;
         curr_obj_class = ret_symbol->object_class;
         type_deduction_reqd = false;
+
+        if(ret_symbol->offset != -1){ // annotate members with their offset in tlstruct instances (see tls_layout)
+            node->depth = -1;
+            node->slot = ret_symbol->offset;
+        }
     }
     else{
         // otherwise report semantic error and flag type deduction required (since symbol not found => no associated type)
@@ -144,10 +402,13 @@ void semantic_analysis::visit(astELEMENT* node){
     type_t ret_type = curr_type;
     grammarDFA::Symbol ret_obj_class = curr_obj_class;
 
+    bool write = assigning; assigning = false;
+    bool member = lookup_symbolTable != curr_symbolTable;
+
     // if syntax analysis yielded correct AST with astIDENTIFIER node
-    if(node->identifier != nullptr){
+    if(node->identifier() != nullptr){
         // extract identifier of array instance from astIDENTIFIER node
-        string arr_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
+        string arr_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
 
         // find symbol in lookup symbol table
         symbol* ret_symbol = lookup_symbolTable->lookup(arr_ident);
@@ -165,6 +426,13 @@ void semantic_analysis::visit(astELEMENT* node){
                 ret_type = ret_symbol->type;
                 ret_obj_class = grammarDFA::SINGLETON; // element is always a singular value (since we have 1D arrays only)
                 type_deduction_reqd = false;
+
+                if(curr_region != nullptr && !member){ par_access(ret_symbol, node->line, write, node->index());}
+
+                if(ret_symbol->offset != -1){ // annotate members with their offset in tlstruct instances
+                    ((astIDENTIFIER*) node->identifier())->depth = -1;
+                    ((astIDENTIFIER*) node->identifier())->slot = ret_symbol->offset;
+                }
             }
         }
         else{
@@ -178,8 +446,8 @@ void semantic_analysis::visit(astELEMENT* node){
     }
 
     // if syntax analysis yielded correct AST with astEXPRESSION node for the index
-    if(node->index != nullptr){
-        (node->index)->accept(this); // visit astEXPRESSION node
+    if(node->index() != nullptr){
+        (node->index())->accept(this); // visit astEXPRESSION node
 
         if(type_deduction_reqd){ // if could not determine type, report semantic error
             err_count++;
@@ -194,6 +462,7 @@ void semantic_analysis::visit(astELEMENT* node){
 
     curr_type = ret_type;
     curr_obj_class = ret_obj_class;
+    node->type = ret_type.first; // annotate the element with its type (used by optimisation passes)
 }
 
 void semantic_analysis::visit(astMULTOP* node){
@@ -265,7 +534,7 @@ void semantic_analysis::visit(astAPARAMS* node){
 
     // for each astEXPRESSION child node
     for(size_t i = 0; i < node->n_children; i++){
-        (node->children->at(i))->accept(this); // visit astEXPRESSION node
+        (node->children.at(i))->accept(this); // visit astEXPRESSION node
 
         if(type_deduction_reqd){ // if aparam expression doesn't type check, report semantic error
             final_type_deduction_check = true;
@@ -306,9 +575,9 @@ void semantic_analysis::visit(astAPARAMS* node){
 
 void semantic_analysis::visit(astFUNC_CALL* node){
     // if syntax analysis yielded correct AST with astIDENTIFIER node
-    if(node->identifier != nullptr){
+    if(node->identifier() != nullptr){
         // extract function identifier from astIDENTIFIER node
-        string func_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
+        string func_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
         auto* expected_func = new funcSymbol(&func_ident, type_t(grammarDFA::T_TYPE, ""),
                                              grammarDFA::FUNCTION, new vector<symbol*>(0));
         functionStack->push(make_pair(expected_func, true)); // push on top of function stack
@@ -318,8 +587,8 @@ void semantic_analysis::visit(astFUNC_CALL* node){
         lookup_symbolTable = curr_symbolTable; // set lookup symbol table to current symbol table
 
         type_deduction_reqd = false;
-        if(node->aparams != nullptr){ // if we have at least 1 parameter...
-            node->aparams->accept(this); // visit astAPARAMS node to type check the parameters and build the function type-signature
+        if(node->aparams() != nullptr){ // if we have at least 1 parameter...
+            node->aparams()->accept(this); // visit astAPARAMS node to type check the parameters and build the function type-signature
         }
 
         if(!type_deduction_reqd){
@@ -327,6 +596,8 @@ void semantic_analysis::visit(astFUNC_CALL* node){
             funcSymbol* func = ref_lookup_symbolTable->lookup(func_ident, expected_func->fparams);
 
             if(func != nullptr){ // if matching funcSymbol found
+                node->callee = func; // bind the call to the function, so that later passes need not repeat the lookup
+                if(curr_region != nullptr){ par_call(func, node->line);}
                 curr_type = func->type;
                 curr_obj_class = func->ret_obj_class;
                 // function return should not be anonymous (type should be determined from return statements in astFUNC_DECL)
@@ -353,8 +624,8 @@ void semantic_analysis::visit(astFUNC_CALL* node){
 
 void semantic_analysis::visit(astSUBEXPR* node){
     // if syntax analysis yielded correct AST with astEXPRESSION node
-    if(node->subexpr != nullptr){
-        node->subexpr->accept(this); // visit astEXPRESSION node
+    if(node->subexpr() != nullptr){
+        node->subexpr()->accept(this); // visit astEXPRESSION node
     }
     else{
         type_deduction_reqd = true;
@@ -363,8 +634,9 @@ void semantic_analysis::visit(astSUBEXPR* node){
 
 void semantic_analysis::visit(astUNARY* node){
     // if syntax analysis yielded correct AST with astEXPRESSION node
-    if(node->operand != nullptr){
-        node->operand->accept(this); // visit astEXPRESSION node
+    if(node->operand() != nullptr){
+        node->operand()->accept(this); // visit astEXPRESSION node
+        node->object_class = curr_obj_class; // annotate the node for the interpreter
 
         if(!type_deduction_reqd){ // if expression yielded a valid type
             // - unary operator is only supported on int, float or char types; if not, report semantic error
@@ -391,34 +663,35 @@ void semantic_analysis::visit(astUNARY* node){
 
 void semantic_analysis::visit(astASSIGNMENT_IDENTIFIER* node){
     // if syntax analysis yielded correct AST with astIDENTIFIER node
-    if(node->identifier != nullptr){
-        node->identifier->accept(this); // visit astIDENTIFIER node
+    if(node->identifier() != nullptr){
+        assigning = true;
+        node->identifier()->accept(this); // visit astIDENTIFIER node
         bool found_var = !type_deduction_reqd; // maintain if symbol with identifier was found
 
         type_t obj_type = curr_type;
         grammarDFA::Symbol obj_class = curr_obj_class;
 
         // if syntax analysis yielded correct AST with astEXPRESSION node
-        if(node->expression != nullptr){
-            node->expression->accept(this); // visit astEXPRESSION node to type check
+        if(node->expression() != nullptr){
+            node->expression()->accept(this); // visit astEXPRESSION node to type check
 
             if(found_var){
                 // if expression is of an indeterminate type, report semantic error
                 if(type_deduction_reqd){
                     err_count++;
-                    std::cerr << "ln " << node->line << ": " << ((astIDENTIFIER*) node->identifier)->lexeme
+                    std::cerr << "ln " << node->line << ": " << ((astIDENTIFIER*) node->identifier())->lexeme
                     << " of type " << type_symbol2string(obj_type.second, obj_class) <<
                     " cannot be assigned to an indeterminate type" << std::endl;
                 }
                 // if variable/array/etc has type auto and object class of variable and expression match, set type of variable
                 else if(obj_type.first == grammarDFA::T_AUTO && obj_class == curr_obj_class){
-                    symbol* ret_symbol = lookup_symbolTable->lookup(((astIDENTIFIER*) node->identifier)->lexeme);
+                    symbol* ret_symbol = lookup_symbolTable->lookup(((astIDENTIFIER*) node->identifier())->lexeme);
                     ret_symbol->type = curr_type;
                 }
                 // else if the type or object class does not match between the variable/array/etc and expression, report semantic error
                 else if(curr_type != obj_type || curr_obj_class != obj_class){
                     err_count++;
-                    std::cerr << "ln " << node->line << ": variable " << ((astIDENTIFIER*) node->identifier)->lexeme
+                    std::cerr << "ln " << node->line << ": variable " << ((astIDENTIFIER*) node->identifier())->lexeme
                     << " of type " << type_symbol2string(obj_type.second, obj_class)
                     << " cannot be assigned a value of type " << type_symbol2string(curr_type.second, curr_obj_class) << std::endl;
                 }
@@ -429,19 +702,20 @@ void semantic_analysis::visit(astASSIGNMENT_IDENTIFIER* node){
 
 void semantic_analysis::visit(astASSIGNMENT_ELEMENT* node){
     // if syntax analysis yielded correct AST with astELEMENT node
-    if(node->element != nullptr){
+    if(node->element() != nullptr){
         symbol_table* ref_lookup_symbolTable = lookup_symbolTable;
 
-        node->element->accept(this); // visit astELEMENT node
+        assigning = true;
+        node->element()->accept(this); // visit astELEMENT node
         bool found_elt = !type_deduction_reqd; // flag on whether element was found
         type_t elt_type = curr_type; // maintain type of element
 
-        if(node->expression != nullptr){ // if syntax analysis yielded correct AST with astEXPRESSION node
-            node->expression->accept(this); // visit astEXPRESSION node
+        if(node->expression() != nullptr){ // if syntax analysis yielded correct AST with astEXPRESSION node
+            node->expression()->accept(this); // visit astEXPRESSION node
 
             if(found_elt){ // if element was found
                 // fetch identifier of array for lookup and verbose error reporting
-                string arr_ident = ((astIDENTIFIER*) ((astELEMENT*) node->element)->identifier)->lexeme;
+                string arr_ident = ((astIDENTIFIER*) ((astELEMENT*) node->element())->identifier())->lexeme;
 
                 if(type_deduction_reqd){ // if expression is of an indeterminate type, report syntax error
                     err_count++;
@@ -470,10 +744,12 @@ void semantic_analysis::visit(astASSIGNMENT_ELEMENT* node){
 }
 
 void semantic_analysis::visit(astASSIGNMENT_MEMBER* node){
+    if(curr_region != nullptr){ par_violation(curr_region, node->line, "use tlstruct instances");}
+
     // if syntax analysis yielded correct AST with astIDENTIFIER node
-    if(node->tls_name != nullptr){
+    if(node->tls_name() != nullptr){
         // hold reference of tlstruct instance name
-        string tls_ident = ((astIDENTIFIER*) node->tls_name)->lexeme;
+        string tls_ident = ((astIDENTIFIER*) node->tls_name())->lexeme;
         symbol* ret_symbol = lookup_symbolTable->lookup(tls_ident); // and lookup if symbol exists with this identifier
         lookup_symbolTable = curr_symbolTable;
 
@@ -486,9 +762,11 @@ void semantic_analysis::visit(astASSIGNMENT_MEMBER* node){
             }
             // otherwise, if valid type, then check if syntax analysis yielded a correct AST with an astASSIGNMENT_IDENTIFIER
             // or an astASSIGNMENT_ELEMENT node, corresponding to the assignment of the member identifier or element
-            else if(node->assignment != nullptr){
-                lookup_symbolTable = get<symbol_table*>(get<literal_t>(ret_symbol->object));
-                node->assignment->accept(this); // visit the astASSIGNMENT_IDENTIFIER or astASSIGNMENT_ELEMENT node
+            else if(node->assignment() != nullptr){
+                lookup_symbolTable = ret_symbol->object.t;
+                node->assignment()->accept(this); // visit the astASSIGNMENT_IDENTIFIER or astASSIGNMENT_ELEMENT node
+
+                check_member(node->assignment(), ret_symbol);
             }
         }
         else{ // otherwise if symbol matching the identifier found, report an appropriate semantic error
@@ -500,12 +778,12 @@ void semantic_analysis::visit(astASSIGNMENT_MEMBER* node){
 
 void semantic_analysis::visit(astVAR_DECL* node){
     // maintain reference of the variable identifier and type
-    string var_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
-    type_t var_type = type_t(((astTYPE*) node->type)->type, ((astTYPE*) node->type)->lexeme);
+    string var_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    type_t var_type = type_t(((astTYPE*) node->type())->type, ((astTYPE*) node->type())->lexeme);
 
     // if assigning on declaration with an expression (recall that we changed variable assignment to being optional)
-    if(node->expression != nullptr){
-        node->expression->accept(this); // visit astEXPRESSION node
+    if(node->expression() != nullptr){
+        node->expression()->accept(this); // visit astEXPRESSION node
         // if expression is of an indeterminate type, report appropriate semantic error
         if(type_deduction_reqd){
             err_count++;
@@ -533,6 +811,8 @@ void semantic_analysis::visit(astVAR_DECL* node){
 
     // if variable is an instance of some tlstruct named type
     if(var_type.first == grammarDFA::T_TLSTRUCT){
+        if(curr_region != nullptr){ par_violation(curr_region, node->line, "use tlstruct instances");}
+
         // lookup tlsSymbol corresponding to the definition of the named type
         symbol* ret_symbol = lookup_symbolTable->lookup(var_type.second);
         lookup_symbolTable = curr_symbolTable; // set symbol table references for lookup members
@@ -552,15 +832,21 @@ void semantic_analysis::visit(astVAR_DECL* node){
         err_count++;
         std::cerr << "ln " << node->line << ": identifier " << var_ident << " has already been declared" << std::endl;
     }
+    else if(insert){
+        declare_member(var, (astIDENTIFIER*) node->identifier());
+        par_declare(var);
+    }
 }
 
 void semantic_analysis::visit(astARR_DECL* node){
     // maintain reference of array identifier and type
-    string arr_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
-    type_t arr_type = type_t(((astTYPE*) node->type)->type, ((astTYPE*) node->type)->lexeme);
+    string arr_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    type_t arr_type = type_t(((astTYPE*) node->type())->type, ((astTYPE*) node->type())->lexeme);
 
     // if array is an instance of some tlstruct named type
     if(arr_type.first == grammarDFA::T_TLSTRUCT){
+        if(curr_region != nullptr){ par_violation(curr_region, node->line, "use tlstruct instances");}
+
         // lookup tlsSymbol corresponding to the definition of the named type
         symbol* ret_symbol = lookup_symbolTable->lookup(arr_type.second);
         lookup_symbolTable = curr_symbolTable; // set symbol table references for lookup members
@@ -572,8 +858,8 @@ void semantic_analysis::visit(astARR_DECL* node){
     }
 
     // if syntax analysis yielded a correct AST with an astEXPRESSION node
-    if(node->size != nullptr){
-        node->size->accept(this); // visit the astEXPRESSION node
+    if(node->size() != nullptr){
+        node->size()->accept(this); // visit the astEXPRESSION node
 
         // if expression is of an indeterminate type, report an appropriate semantic error
         if(type_deduction_reqd){
@@ -590,10 +876,10 @@ void semantic_analysis::visit(astARR_DECL* node){
     }
 
     // for each element listed for assignment (possibly none if we don't assign the array)
-    for(int i = 3; i < node->n_children; i++){
+    for(uint32_t i = 3; i < node->n_children; i++){
         // if syntax analysis yielded a correct astEXPRESSION node corresponding to the element
-        if(node->children->at(i) != nullptr){
-            (node->children->at(i))->accept(this); // visit astEXPRESSION node
+        if(node->children.at(i) != nullptr){
+            (node->children.at(i))->accept(this); // visit astEXPRESSION node
 
             // if expression is of an indeterminate type, report an appropriate semantic error
             if(type_deduction_reqd){
@@ -631,10 +917,19 @@ void semantic_analysis::visit(astARR_DECL* node){
         err_count++;
         std::cerr << "ln " << node->line << ": identifier " << arr_ident << " has already been declared" << std::endl;
     }
+    else{
+        declare_member(arr, (astIDENTIFIER*) node->identifier());
+        par_declare(arr);
+
+        // the type of an auto array without initial elements is only set upon assigning to an element
+        if(((astTYPE*) node->type())->type == grammarDFA::T_AUTO && node->n_children <= 3){ auto_arrays.insert(arr);}
+    }
 }
 
 void semantic_analysis::visit(astTLS_DECL* node){
-    string tls_ident = ((astIDENTIFIER*) node->identifier)->lexeme; // maintain reference of tls named type identifier
+    if(curr_region != nullptr){ par_violation(curr_region, node->line, "use tlstruct instances");}
+
+    string tls_ident = ((astIDENTIFIER*) node->identifier())->lexeme; // maintain reference of tls named type identifier
     auto* tls = new tlsSymbol(&tls_ident, &tls_ident); // initialise new tlsSymbol instance to be inserted
 
     // keep references of current and lookup symbol tables at present
@@ -645,10 +940,19 @@ void semantic_analysis::visit(astTLS_DECL* node){
     curr_symbolTable = new symbol_table(ref_curr_symbolTable);
     lookup_symbolTable = curr_symbolTable;
 
+    auto* tls_block = (astBLOCK*) node->tls_block();
+    tls_block->layout = new tls_layout;
+
     // visit all the children in the astBLOCK node which defines the tlstructs internals
     // in doing so, this populates the symbol table
-    for(auto &c : *((astBLOCK*) node->tls_block)->children){
+    for(auto &c : tls_block->children){
+        // top-level declarations are the members of the tlstruct, which are laid out in declaration order
+        if(c->kind == astNode::VAR_DECL || c->kind == astNode::ARR_DECL){
+            member_layout = tls_block->layout;
+        }
+
         c->accept(this);
+        member_layout = nullptr;
     }
 
     // set the right value of the tlsSymbol as the resulting symbol table
@@ -666,9 +970,12 @@ void semantic_analysis::visit(astTLS_DECL* node){
 }
 
 void semantic_analysis::visit(astPRINT* node){
+    // the order in which values are printed depends on the order in which iterations are executed
+    if(curr_region != nullptr){ par_violation(curr_region, node->line, "print");}
+
     // if syntax analysis yielded a correct AST with an astEXPRESSION node
-    if(node->expression != nullptr){
-        node->expression->accept(this); // visit the astEXPRESSION node
+    if(node->expression() != nullptr){
+        node->expression()->accept(this); // visit the astEXPRESSION node
 
         // if expression is of an indeterminate type, report an appropriate semantic error
         if(type_deduction_reqd){
@@ -686,6 +993,11 @@ void semantic_analysis::visit(astPRINT* node){
 }
 
 void semantic_analysis::visit(astRETURN* node){
+    // all iterations of a parallel for loop are executed, hence the loop cannot return from the enclosing function
+    if(curr_region != nullptr && curr_region->func == nullptr){
+        par_violation(curr_region, node->line, "return");
+    }
+
     // if the functionStack is empty, then at present there are no functions being semantically checked
     // i.e. we have a return statement outside of a function
     if(functionStack->empty()){
@@ -693,8 +1005,8 @@ void semantic_analysis::visit(astRETURN* node){
         std::cerr << "ln " << node->line << ": return statement cannot be outside of a function scope"<< std::endl;
     }
     // else if syntax analysis yielded a correct AST with an astEXPRESSION node
-    else if(node->expression != nullptr){
-        node->expression->accept(this); // visit astEXPRESSION node
+    else if(node->expression() != nullptr){
+        node->expression()->accept(this); // visit astEXPRESSION node
         functionStack->top().second = true; // the top most function of the functionStack returns, hence set return flag to true
 
         // if expression is of an indeterminate type and the return type is not anonymous, report appropriate semantic error
@@ -744,8 +1056,8 @@ void semantic_analysis::visit(astRETURN* node){
 
 void semantic_analysis::visit(astIF* node){
     // if syntax analysis yielded a correct AST with an astEXPRESSION node
-    if(node->expression != nullptr){
-        node->expression->accept(this); // visit astEXPRESSION node
+    if(node->expression() != nullptr){
+        node->expression()->accept(this); // visit astEXPRESSION node
 
         // if expression is of an indeterminate type, report appropriate semantic error
         if(type_deduction_reqd){
@@ -762,17 +1074,17 @@ void semantic_analysis::visit(astIF* node){
         }
     }
 
-    bool curr_func_ret, if_ret, else_ret; // flags to maintain whether return statements have been encountered
+    bool curr_func_ret = false, if_ret = false, else_ret = false; // flags to maintain whether return statements have been encountered
     // if functionStack is not empty, set the curr_func_ret flag to the return flag of the top-most function on the stack
     if(!functionStack->empty()){ curr_func_ret = functionStack->top().second;}
 
     // if syntax analysis yielded a correct AST with an astBLOCK node
-    if(node->if_block != nullptr){
+    if(node->if_block() != nullptr){
         // if functionStack is not empty, set the return flag of the top-most function on the stack to false
         // this is so that we check if we return within the if-block
         if(!functionStack->empty()){ functionStack->top().second = false;}
 
-        node->if_block->accept(this); // visit the astBLOCK node corresponding to the if-branch
+        node->if_block()->accept(this); // visit the astBLOCK node corresponding to the if-branch
 
         // if functionStack is not empty, set the if_ret flag to the return flag of the top-most function on the stack
         if(!functionStack->empty()){ if_ret = functionStack->top().second;}
@@ -783,12 +1095,12 @@ void semantic_analysis::visit(astIF* node){
     }
 
     // if the optional else branch is specified i.e. there is another astBLOCK node corresponding to the else branch
-    if(node->else_block != nullptr){
+    if(node->else_block() != nullptr){
         // if functionStack is not empty, set the return flag of the top-most function on the stack to false
         // this is so that we check if we return within the else-block
         if(!functionStack->empty()){ functionStack->top().second = false;}
 
-        node->else_block->accept(this); // visit the astBLOCK node corresponding to the else-branch
+        node->else_block()->accept(this); // visit the astBLOCK node corresponding to the else-branch
 
         // if functionStack is not empty, set the else_ret flag to the return flag of the top-most function on the stack
         if(!functionStack->empty()){ else_ret = functionStack->top().second;}
@@ -807,16 +1119,17 @@ void semantic_analysis::visit(astIF* node){
     }
 }
 
-void semantic_analysis::visit(astFOR* node){
+// Checks the header of a for loop, within a new scope (popped once the for-block is checked)
+void semantic_analysis::for_header(astFOR* node){
     // maintain scoping: push scope for for-block
     curr_symbolTable->push_scope(); // we push new scope since the optional declaration should be accessible in the scope of the for-block
 
     // if optional declaration statement given, visit
-    if(node->decl != nullptr){ node->decl->accept(this);}
+    if(node->decl() != nullptr){ node->decl()->accept(this);}
 
     // if syntax analysis yielded correst AST with astEXPRESSION node
-    if(node->expression != nullptr){
-        node->expression->accept(this); // visit the astEXPRESSION node
+    if(node->expression() != nullptr){
+        node->expression()->accept(this); // visit the astEXPRESSION node
 
         // if expression is of an indeterminate type, report appropriate semantic error
         if(type_deduction_reqd){
@@ -834,10 +1147,14 @@ void semantic_analysis::visit(astFOR* node){
     }
 
     // if optional assignment statement given, visit
-    if(node->assignment != nullptr){ node->assignment->accept(this);}
+    if(node->assignment() != nullptr){ node->assignment()->accept(this);}
+}
+
+void semantic_analysis::visit(astFOR* node){
+    for_header(node);
 
     // then visit each child node of the astBLOCK associated with the for-block
-    for(auto &c : *((astBLOCK*) node->for_block)->children){
+    for(auto &c : ((astBLOCK*) node->for_block())->children){
         c->accept(this);
     }
 
@@ -845,10 +1162,68 @@ void semantic_analysis::visit(astFOR* node){
     curr_symbolTable->pop_scope();
 }
 
+/* The iterations of a parallel for loop may be executed concurrently (see interpreter), and hence must be independent of
+ * each other: the header must be of the form parallel for(let i:int = a; i < b; i = i + 1), with the bound b evaluated
+ * once, while the body is checked as a parallel region, within which it cannot:
+ * (i)   assign to variables declared outside of the loop (including i), nor read strings, arrays or tlstruct instances
+ *       declared outside of it (as a whole), since these are reference counted,
+ * (ii)  assign to elements of arrays declared outside of the loop other than at index i, nor read elements of such an
+ *       array (or of any other such array of the same type, which may refer to the same elements) at another index,
+ *       nor access elements of string (or tlstruct) arrays declared outside of it,
+ * (iii) print, return, use tlstruct instances, nor call functions which may do any of the above (with respect to the
+ *       variables declared outside of the function, each function body being checked as a region of its own).
+ * Hence the result of executing the loop is that of executing its iterations in sequence.
+ */
+void semantic_analysis::visit(astPAR_FOR* node){
+    for_header(node);
+
+    par_region region{curr_region, nullptr, nullptr};
+    if(par_for_header(node, &region)){ // otherwise the body is checked as that of a for loop
+        curr_region = &region;
+    }
+
+    for(auto &c : ((astBLOCK*) node->for_block())->children){
+        c->accept(this);
+    }
+
+    curr_region = region.enclosing;
+
+    for(auto &read : region.indexed_reads){
+        if(region.written.count(read.first) > 0){
+            err_count++;
+            std::cerr << "ln " << read.second << ": parallel for loop cannot read elements of array " <<
+            read.first->identifier << " other than at index " << region.induction->identifier <<
+            ", since it assigns to its elements" << std::endl;
+
+            continue;
+        }
+
+        // arrays are assigned by reference, hence the array read may be one assigned to (if of the same type)
+        symbol* alias = nullptr;
+        for(symbol* written : region.written){
+            if((written->type.first == read.first->type.first || read.first->type.first == grammarDFA::T_AUTO) &&
+               (alias == nullptr || written->identifier < alias->identifier)){
+                alias = written;
+            }
+        }
+
+        if(alias != nullptr){
+            err_count++;
+            std::cerr << "ln " << read.second << ": parallel for loop cannot read elements of array " <<
+            read.first->identifier << " other than at index " << region.induction->identifier <<
+            ", since it assigns to the elements of array " << alias->identifier << ", which " <<
+            read.first->identifier << " may refer to" << std::endl;
+        }
+    }
+
+    // maintain scoping: pop scope for for-block
+    curr_symbolTable->pop_scope();
+}
+
 void semantic_analysis::visit(astWHILE* node){
     // if syntax analysis yielded a correct AST with an astEXPRESSION block
-    if(node->expression != nullptr){
-        node->expression->accept(this); // visit astEXPRESSION block
+    if(node->expression() != nullptr){
+        node->expression()->accept(this); // visit astEXPRESSION block
 
         // if expression is of an indeterminate type, report appropriate semantic error
         if(type_deduction_reqd){
@@ -866,21 +1241,21 @@ void semantic_analysis::visit(astWHILE* node){
     }
 
     // if syntax analysis yielded a correst AST with an astBLOCK node for the while-block, visit
-    if(node->while_block != nullptr){ node->while_block->accept(this);}
+    if(node->while_block() != nullptr){ node->while_block()->accept(this);}
 }
 
 void semantic_analysis::visit(astFPARAMS* node){
     // visit each child node and carry out semantic analysis
-    for(auto &c : *node->children){
+    for(auto &c : node->children){
         c->accept(this);
     }
 }
 
 void semantic_analysis::visit(astFPARAM* node){
     // maintain reference of parameter identifier, type, and object class
-    string fparam_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
-    type_t fparam_type = type_t(((astTYPE*) node->type)->type, ((astTYPE*) node->type)->lexeme);
-    grammarDFA::Symbol fparam_obj_class = ((astTYPE*) node->type)->object_class;
+    string fparam_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    type_t fparam_type = type_t(((astTYPE*) node->type())->type, ((astTYPE*) node->type())->lexeme);
+    grammarDFA::Symbol fparam_obj_class = ((astTYPE*) node->type())->object_class;
 
     symbol* fparam; // declare new symbol instance; can eventually be a varSymbol or arrSymbol instance
     // the symbol instance will be inserted in the symbol table for semantic analysis in the function block
@@ -921,13 +1296,16 @@ void semantic_analysis::visit(astFPARAM* node){
         std::cerr << "ln " << node->line << ": identifier " << fparam_ident
         << " in function signature has already been declared" << std::endl;
     }
+    else{
+        par_declare(fparam);
+    }
 }
 
 void semantic_analysis::visit(astFUNC_DECL* node){
     // maintain reference of function identifier and return type/object class
-    string func_ident = ((astIDENTIFIER*) node->identifier)->lexeme;
-    type_t ret_type = type_t(((astTYPE*) node->type)->type, ((astTYPE*) node->type)->lexeme);
-    grammarDFA::Symbol ret_obj_class = ((astTYPE*) node->type)->object_class;
+    string func_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    type_t ret_type = type_t(((astTYPE*) node->type())->type, ((astTYPE*) node->type())->lexeme);
+    grammarDFA::Symbol ret_obj_class = ((astTYPE*) node->type())->object_class;
 
     // in the case the return type is a tlstruct named type
     if(ret_type.first == grammarDFA::T_TLSTRUCT){
@@ -942,14 +1320,14 @@ void semantic_analysis::visit(astFUNC_DECL* node){
     }
 
     auto* fparams = new vector<symbol*>(0); // will hold the type signature of the function in the form of dummy symbol instances
-    if(node->fparams != nullptr){ // if at least 1 astFPARAM node specified
+    if(node->fparams() != nullptr){ // if at least 1 astFPARAM node specified
         // for each astFPARAM child node
-        for(auto &c : *((astFPARAMS*) node->fparams)->children){
+        for(auto &c : ((astFPARAMS*) node->fparams())->children){
             // maintain reference of the parameters identifier, type, and object class
-            string obj_ident = ((astIDENTIFIER*) ((astFPARAM*) c)->children->at(0))->lexeme;
-            type_t obj_type = type_t(((astTYPE*) ((astFPARAM*) c)->children->at(1))->type,
-                                     ((astTYPE*) ((astFPARAM*) c)->children->at(1))->lexeme);
-            grammarDFA::Symbol obj_class = ((astTYPE*) ((astFPARAM*) c)->children->at(1))->object_class;
+            string obj_ident = ((astIDENTIFIER*) ((astFPARAM*) c)->children.at(0))->lexeme;
+            type_t obj_type = type_t(((astTYPE*) ((astFPARAM*) c)->children.at(1))->type,
+                                     ((astTYPE*) ((astFPARAM*) c)->children.at(1))->lexeme);
+            grammarDFA::Symbol obj_class = ((astTYPE*) ((astFPARAM*) c)->children.at(1))->object_class;
 
             // if parameter is a singular value
             if(obj_class == grammarDFA::SINGLETON){
@@ -981,6 +1359,7 @@ void semantic_analysis::visit(astFUNC_DECL* node){
 
     // create new funcSymbol instance for the function declaration
     auto* func = new funcSymbol(&func_ident, ret_type, ret_obj_class, fparams);
+    func->set_func_ref((astBLOCK*) node->function_block()); // set reference to astBLOCK instance corresponding to the function block
 
     bool inserted = curr_symbolTable->insert(func);// attempt to insert into the symbol table
     // if false returned by insert, then identifier is already in use; report appropriate semantic error
@@ -995,18 +1374,24 @@ void semantic_analysis::visit(astFUNC_DECL* node){
     // initially return flag is set to false
     functionStack->push(make_pair(func, false));
 
+    // the function body is checked as a parallel region, in case the function is called within a parallel for loop
+    par_region* ref_region = curr_region;
+    par_region region{nullptr, func, nullptr};
+    curr_region = &region;
+
     // maintain scoping: push scope for function block
     curr_symbolTable->push_scope();
     // if syntax analysis yielded correct AST with an astFPARAMS node, visit;
     // note that parameters declared will be in the function scope, as required for semantic analysis
-    if(node->fparams != nullptr){ node->fparams->accept(this);}
+    if(node->fparams() != nullptr){ node->fparams()->accept(this);}
 
     // visit each child node of the astBLOCK associated with the function block
-    for(auto &c : *((astBLOCK*) node->function_block)->children){
+    for(auto &c : ((astBLOCK*) node->function_block())->children){
         c->accept(this);
     }
     // maintain scoping: pop scope for function block
     curr_symbolTable->pop_scope();
+    curr_region = ref_region;
 
     // if return flag on top of the function stack is false, then the function does not always return;
     // report an appropriate semantic error in this case
@@ -1030,15 +1415,19 @@ void semantic_analysis::visit(astFUNC_DECL* node){
     }
 
     if(!inserted){
+        unsafe_funcs.erase(func);
+        callees.erase(func);
         delete func;
     }
 }
 
 void semantic_analysis::visit(astMEMBER_ACCESS* node){
+    if(curr_region != nullptr){ par_violation(curr_region, node->line, "use tlstruct instances");}
+
     // if syntax analysis yielded correct AST with astIDENTIFIER node
-    if(node->tls_name != nullptr){
+    if(node->tls_name() != nullptr){
         // hold reference of tlstruct instance name
-        string tls_ident = ((astIDENTIFIER*) node->tls_name)->lexeme;
+        string tls_ident = ((astIDENTIFIER*) node->tls_name())->lexeme;
         symbol* ret_symbol = lookup_symbolTable->lookup(tls_ident); // and lookup if symbol exists with this identifier
         lookup_symbolTable = curr_symbolTable;
 
@@ -1050,9 +1439,15 @@ void semantic_analysis::visit(astMEMBER_ACCESS* node){
                 std::cerr << "ln " << node->line << ": variable " << tls_ident << " is not a tlstruct type" << std::endl;
             }
             // otherwise, if valid type, then check if member specified by identifier is in the symbol table of the tlstruct instance
-            else if(node->member != nullptr){
-                lookup_symbolTable = get<symbol_table*>(get<literal_t>(ret_symbol->object));
-                node->member->accept(this);
+            else if(node->member() != nullptr){
+                lookup_symbolTable = ret_symbol->object.t;
+                node->member()->accept(this);
+
+                check_member(node->member(), ret_symbol);
+
+                // annotate the access with the type of the member (used by optimisation passes)
+                node->type = curr_type.first;
+                node->object_class = curr_obj_class;
             }
         }
         else{
@@ -1067,7 +1462,7 @@ void semantic_analysis::visit(astBLOCK* node){
     curr_symbolTable->push_scope();
 
     // visit each child node and carry out semantic analysis
-    for(auto &c : *node->children){
+    for(auto &c : node->children){
         c->accept(this);
     }
 
@@ -1077,7 +1472,25 @@ void semantic_analysis::visit(astBLOCK* node){
 
 void semantic_analysis::visit(astPROGRAM* node){
     // visit each child node and carry out semantic analysis
-    for(auto &c : *node->children){
+    for(auto &c : node->children){
         c->accept(this);
     }
-}
\ No newline at end of file
+
+    // once all functions are checked, report the functions called within parallel for loops which cannot be (see par_region)
+    for(auto &call : parallel_calls){
+        unordered_set<funcSymbol*> visited;
+        funcSymbol* unsafe = par_unsafe_callee(call.first, visited);
+
+        if(unsafe != nullptr){
+            err_count++;
+            std::cerr << "ln " << call.second << ": parallel for loop cannot call function " << call.first->identifier;
+            if(unsafe != call.first){ std::cerr << ", which calls function " << unsafe->identifier;}
+            std::cerr << ", since it may " << unsafe_funcs[unsafe].first << " (ln " << unsafe_funcs[unsafe].second << ")"
+            << std::endl;
+        }
+    }
+}
+// Hoisted expressions are only introduced after semantic analysis, hence we simply check the expression wrapped
+void semantic_analysis::visit(astHOISTED* node){
+    node->expression()->accept(this);
+}
@@ -9,6 +9,7 @@
 #include "../symbol_table/symbol.h"
 #include "../visitor_ast/visitor.h"
 #include <iostream>
+#include <unordered_set>
 
 class semantic_analysis: public visitor{
 public:
@@ -33,6 +34,7 @@ public:
     void visit(astRETURN* node) override;
     void visit(astIF* node) override;
     void visit(astFOR* node) override;
+    void visit(astPAR_FOR* node) override;
     void visit(astWHILE* node) override;
     void visit(astFPARAMS* node) override;
     void visit(astFPARAM* node) override;
@@ -40,6 +42,7 @@ public:
     void visit(astMEMBER_ACCESS* node) override;
     void visit(astBLOCK* node) override;
     void visit(astPROGRAM* node) override;
+    void visit(astHOISTED* node) override;
 
     int err_count = 0;
 
@@ -48,12 +51,46 @@ private:
     symbol_table* curr_symbolTable = new symbol_table(nullptr);
     symbol_table* lookup_symbolTable = curr_symbolTable;
 
+    tls_layout* member_layout = nullptr; // layout of the tlstruct whose member is being declared, nullptr otherwise
+
     bool type_deduction_reqd = false;
     type_t curr_type;
     grammarDFA::Symbol curr_obj_class;
 
+    /* The body of each parallel for loop, as well as that of each function (which may be called from within a parallel
+     * for loop), is checked as a parallel region: accesses to the variables declared outside of a region are restricted
+     * such that the iterations of a loop may be executed concurrently, with the same result (see visit(astPAR_FOR)).
+     */
+    struct par_region{
+        par_region* enclosing; // the region enclosing a loop, nullptr for a function (the body of which is checked apart)
+        funcSymbol* func; // the function whose body is the region, nullptr for the body of a loop
+        symbol* induction; // the variable of the loop
+        unordered_set<symbol*> written; // arrays declared outside of the loop whose elements are assigned
+        vector<pair<symbol*, unsigned int>> indexed_reads; // elements of arrays declared outside read at another index
+    };
+
+    par_region* curr_region = nullptr;
+    unordered_map<symbol*, par_region*> declared_in; // the region in which a variable is declared, if any
+    unordered_set<symbol*> auto_arrays; // arrays declared auto without initialisation (hence typed on assignment)
+    unordered_map<funcSymbol*, pair<string, unsigned int>> unsafe_funcs; // the first restricted access of a function
+    unordered_map<funcSymbol*, vector<funcSymbol*>> callees;
+    vector<pair<funcSymbol*, unsigned int>> parallel_calls; // calls within loops, checked once all functions are declared
+    bool assigning = false; // true while visiting an identifier or element being assigned to (rather than read)
+
+    void for_header(astFOR* node);
+    bool par_for_header(astPAR_FOR* node, par_region* region);
+    bool par_invariant(astNode* node, const string& induction, par_region* region);
+    void par_declare(symbol* s);
+    bool par_local(symbol* s, par_region* region);
+    void par_access(symbol* s, unsigned int line, bool write, astNode* index);
+    void par_call(funcSymbol* func, unsigned int line);
+    void par_violation(par_region* region, unsigned int line, const string& reason);
+    funcSymbol* par_unsafe_callee(funcSymbol* func, unordered_set<funcSymbol*>& visited);
+
     static string type_symbol2string(string type_str, grammarDFA::Symbol obj_class);
     static string typeVect_symbol2string(vector<symbol*>* typeVect);
+    void declare_member(symbol* member, astIDENTIFIER* identifier);
+    void check_member(astNode* member, symbol* tls_instance);
     void binop_type_check(astBinaryOp* binop_node);
 };
 
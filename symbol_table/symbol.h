@@ -6,10 +6,10 @@
 #define CPS2000_SYMBOL_H
 
 #include <utility>
-#include <variant>
 #include <vector>
 #include <string>
 #include "symbol_table.h"
+#include "value.h"
 #include "../visitor_ast/astNode.h"
 #include "../lexer/grammarDFA.h"
 
@@ -22,18 +22,13 @@ using namespace std;
 typedef pair<grammarDFA::Symbol, string> type_t;
 
 /* We also extend the means by which we maintain right-values in Tea2Lang, since we now must also maintain tlstruct instances
- * as well as arrays. For a tlstruct instance, we maintain a symbol table representing the internal state of all member
- * symbols of the tlstruct. Hence literal_t has been extended to support pointers to symbol_table instances.
+ * as well as arrays. For a tlstruct instance, we maintain a record representing the internal state of all member symbols
+ * of the tlstruct (see tl_record). Hence a value (see value.h) may also hold a pointer to a tl_record instance.
  *
- * To support arrays, literal_arr_t was defined, which is simply syntactic sugar for defining a vector of literal_t pointers.
- *
- * Lastly, since a right-value can either be a singular value (SINGLETON) or a collection of values (ARRAY), we define a
- * new variant, obj_t, which handles literal_t and literal_arr_t. This is the new type used to maintain right-values in
- * symbol instances for Tea2Lang.
+ * To support arrays, literal_arr_t was defined, which is a pointer to a typed buffer of elements (see tl_array). A value
+ * may hold either a singular value (SINGLETON) or a collection of values (ARRAY), and is the type used to maintain
+ * right-values in symbol instances for Tea2Lang.
  */
-typedef variant<bool, int, float, char, string, symbol_table*> literal_t;
-typedef vector<literal_t>* literal_arr_t;
-typedef variant<literal_t, literal_arr_t> obj_t;
 
 /* Defines an instance of a symbol table entry, outlining the minimum amount of meta-data to be held. Derivatives of this
  * class may add further meta-data requirements. At a minimum, on instantiation we must maintain:
@@ -48,8 +43,12 @@ public:
     string identifier;
     type_t type;
     grammarDFA::Symbol object_class; // replaces the id_type variable, an instance of the IdentifierType enum in TeaLang
-    obj_t object;
-    
+    int offset = -1; // for members of a tlstruct, the offset of the member in instances (see tls_layout)
+    value object;
+
+    symbol() = default;
+    virtual ~symbol() = default; // symbols are deleted through base pointers (see symbol_table::~symbol_table)
+
     symbol(string* identifier, type_t type){
         if(identifier != nullptr){
             this->identifier = *identifier;
@@ -57,11 +56,34 @@ public:
         this->type = type;
     }
 
-    void set_object(obj_t value){
-        this->object = std::move(value);
+    void set_object(value object){
+        this->object = std::move(object);
     }
 };
 
+/* A tlstruct instance, i.e. a flat record of the members of the instance, held in a single allocation: a header followed
+ * by a symbol per member, at the offset assigned to the member by the layout of the tlstruct (see tls_layout). As for the
+ * slots of frames, each member maintains its type along with its value, since the type of an anonymously typed member is
+ * only known once the member is initialised (by executing the definition block on the new instance).
+ */
+class alignas(symbol) tl_record{
+public:
+    const tls_layout* layout;
+    int refs = 0; // number of values holding the instance (see value)
+
+    // creates an instance with the specified layout, with each member holding no value (i.e. yet to be initialised)
+    static tl_record* make(const tls_layout* layout);
+    static void destroy(tl_record* record);
+
+    symbol* fields(){
+        return reinterpret_cast<symbol*>(this + 1);
+    }
+
+private:
+    explicit tl_record(const tls_layout* layout) : layout(layout){}
+    ~tl_record() = default;
+};
+
 class varSymbol: public symbol{
 public:
 
@@ -86,8 +108,7 @@ public:
 
 /* The tlsSymbol class maintains further meta--data than the symbol class. In particular we maintain a pointer to an
  * astBLOCK instance, corresponding to the tlstruct definition block, for traversal whenever an instance of a define
- * tlstruct is declared (allowing the construction of a new symbol table representing the internal state of the tlsstruct
- * instance).
+ * tlstruct is declared (initialising the members of the new tlstruct instance).
  */
 class tlsSymbol: public symbol{
 public:
@@ -112,7 +133,7 @@ class funcSymbol: public symbol{
 public:
     grammarDFA::Symbol ret_obj_class;
     vector<symbol*>* fparams;
-    astBLOCK* func_ref;
+    astBLOCK* func_ref = nullptr;
 
     funcSymbol(string* identifier, type_t type, grammarDFA::Symbol ret_obj_class,
                vector<symbol*>* fparams) : symbol(identifier, type){
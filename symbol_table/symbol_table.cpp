@@ -4,6 +4,9 @@
 
 #include "symbol_table.h"
 
+#include <new>
+#include <string_view>
+
 /* Lookup function for funcSymbol instances in a (linked) symbol_table instance, based on a given identifier and vector
  * (possibly empty) of pointers to varSymbol instances whose types (in order) represent the type-signature of the
  * funcSymbol being looked up. In this manner, we support function overloading.
@@ -31,7 +34,7 @@ funcSymbol* symbol_table::lookup(const string& identifier, vector<symbol*>* fpar
                     // same by iterating through the respective fparams vectors; if mismatch is found in type or object
                     // class, same_signature = false and we break.
                     else if(fparams->size() == curr_symbol->fparams->size()){
-                        for(int i = 0; i < fparams->size(); i++){
+                        for(size_t i = 0; i < fparams->size(); i++){
                             if(fparams->at(i)->type != curr_symbol->fparams->at(i)->type ||
                                fparams->at(i)->object_class != curr_symbol->fparams->at(i)->object_class){
                                 same_signature = false;
@@ -127,7 +130,7 @@ bool symbol_table::insert(symbol* s){
                     // check if the sequence of types is the same by iterating through the respective fparams vectors;
                     // if mismatch is found in type or object class, same_signature = false and we break i.e. insert
                     if(func_s->fparams->size() == curr_symbol->fparams->size()){
-                        for(int i = 0; i < func_s->fparams->size(); i++){
+                        for(size_t i = 0; i < func_s->fparams->size(); i++){
                             if(func_s->fparams->at(i)->type != curr_symbol->fparams->at(i)->type ||
                                func_s->fparams->at(i)->object_class != curr_symbol->fparams->at(i)->object_class){
                                 same_signature = false;
@@ -166,7 +169,7 @@ bool symbol_table::insert(symbol* s){
 
 // Convenience function for adding a new scope to the scope table.
 void symbol_table::push_scope(){
-    scopeTable->push_back(*(new scope));
+    scopeTable->emplace_back();
 }
 
 // Convenience function for removing the top--most scope from the scope table, with protection from deletion of the
@@ -176,4 +179,84 @@ void symbol_table::pop_scope(){
         (scopeTable->back()).clear();
         scopeTable->pop_back();
     }
-}
\ No newline at end of file
+}
+// A symbol table owns its symbols, which are hence destroyed along with it
+symbol_table::~symbol_table(){
+    for(auto &curr_scope : *scopeTable){
+        for(auto &entry : curr_scope){
+            delete entry.second;
+        }
+    }
+
+    delete scopeTable;
+}
+
+tl_record* tl_record::make(const tls_layout* layout){
+    void* memory = ::operator new(sizeof(tl_record) + layout->n_fields * sizeof(symbol));
+    auto* record = new (memory) tl_record(layout);
+
+    symbol* fields = record->fields();
+    for(int i = 0; i < layout->n_fields; i++){
+        new (fields + i) symbol();
+    }
+
+    return record;
+}
+
+void tl_record::destroy(tl_record* record){
+    symbol* fields = record->fields();
+    for(int i = 0; i < record->layout->n_fields; i++){
+        fields[i].~symbol();
+    }
+
+    record->~tl_record();
+    ::operator delete(record);
+}
+
+/* The table of interned strings, keyed by views of the strings it holds; each interned string is held by the table, and is
+ * hence never freed.
+ */
+value value::intern(const string& str){
+    static unordered_map<string_view, tl_string*> interned_strings;
+
+    tl_string* interned_str;
+
+    auto it = interned_strings.find(str);
+    if(it != interned_strings.end()){
+        interned_str = it->second;
+    }
+    else{
+        interned_str = new tl_string{str, 1, true}; // the reference held by the table
+        interned_strings.emplace(interned_str->str, interned_str);
+    }
+
+    value result;
+    result.s = interned_str;
+    result.tag = STRING;
+    result.retain();
+
+    return result;
+}
+
+/* Reference counting of tlstruct instances (and of the symbol tables representing instances during semantic analysis)
+ * held by values (see value.h)
+ */
+void value::retain_instance() const{
+    if(tag == TLSTRUCT){
+        r->refs++;
+    }
+    else{
+        t->refs++;
+    }
+}
+
+void value::release_instance(){
+    if(tag == TLSTRUCT){
+        if(--r->refs == 0){
+            tl_record::destroy(r);
+        }
+    }
+    else if(--t->refs == 0){
+        delete t;
+    }
+}
@@ -34,6 +34,10 @@ public:
         this->parent_symbolTable = parent;
     }
 
+    ~symbol_table();
+
+    int refs = 0; // for the members of tlstruct definitions, the number of values holding the symbol table (see value)
+
 private:
     vector<scope>* scopeTable = new vector<scope>(1);
     symbol_table* parent_symbolTable;
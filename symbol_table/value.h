@@ -0,0 +1,268 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_VALUE_H
+#define CPS2000_VALUE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+
+class symbol_table;
+class tl_record;
+class tl_array;
+
+using namespace std;
+
+// Arrays are maintained as a (fixed size) typed buffer of elements, see tl_array
+typedef tl_array* literal_arr_t;
+
+/* Strings are immutable, and hence are shared between values (rather than copied on each assignment, parameter pass or
+ * element access), with a reference count maintained such that a string is freed once no longer held by any value.
+ *
+ * Moreover, the strings known at compile time (i.e. the values of string literals, and the default empty string) are
+ * interned (see value::intern): each distinct string is held once, in a table holding a reference to it for the
+ * lifetime of the program. Hence two interned strings are equal if and only if they are the same string, and are
+ * compared as such. Since interned strings are never freed, holding one does not update its reference count (which is
+ * not atomic); hence string literals may be evaluated concurrently by the threads of a parallel for loop (astPAR_FOR).
+ *
+ * Arrays and tlstruct instances (i.e. the record holding the members of the instance, see tl_record) are similarly
+ * reference counted, since they are held by reference: an array or instance is freed once no longer held by any value,
+ * be it a variable, a member, an element, an actual parameter or an intermediate result. Note that reference cycles
+ * cannot arise, since a tlstruct cannot (directly or indirectly) have members of its own type.
+ */
+struct tl_string{
+    string str;
+    int refs;
+    bool interned = false;
+};
+
+/* Defines a right-value, i.e. a tagged union of the primitive types (held unboxed), a reference counted string, a
+ * pointer to the record holding the members of a tlstruct instance, or an array. During semantic analysis, a tlstruct
+ * instance is instead represented by the symbol table of the members of its definition (MEMBERS), for type checking
+ * purposes. On 64-bit targets a value occupies 16 bytes, i.e. an 8 byte payload and a 1 byte tag (padded).
+ *
+ * Note that the tag is only used for reference counting; the interpreter otherwise relies on the (statically checked)
+ * type maintained alongside each value, and hence accesses the payload members directly.
+ */
+class value{
+public:
+    enum Tag : uint8_t{
+        NONE, BOOL, INT, FLOAT, CHAR, STRING, TLSTRUCT, ARRAY, MEMBERS
+    };
+
+    union{
+        uint64_t raw; // used for copying the payload irrespective of the member held
+        bool b;
+        int32_t i;
+        float f;
+        char c;
+        tl_string* s;
+        tl_record* r;
+        symbol_table* t;
+        literal_arr_t a;
+    };
+
+    Tag tag;
+
+    value() : raw(0), tag(NONE){}
+    value(bool b) : raw(0), tag(BOOL){ this->b = b;}
+    value(int32_t i) : raw(0), tag(INT){ this->i = i;}
+    value(float f) : raw(0), tag(FLOAT){ this->f = f;}
+    value(char c) : raw(0), tag(CHAR){ this->c = c;}
+    value(const char* str) : s(new tl_string{str, 1}), tag(STRING){}
+    value(string str) : s(new tl_string{std::move(str), 1}), tag(STRING){}
+    value(tl_record* r) : r(r), tag(TLSTRUCT){ retain();}
+    value(symbol_table* t) : t(t), tag(MEMBERS){ retain();}
+    value(literal_arr_t a) : a(a), tag(ARRAY){ retain();}
+
+    value(const value& other) : raw(other.raw), tag(other.tag){
+        retain();
+    }
+
+    value(value&& other) noexcept : raw(other.raw), tag(other.tag){
+        other.tag = NONE;
+    }
+
+    value& operator=(const value& other){
+        other.retain(); // incremented first, in case of self-assignment
+        release();
+
+        raw = other.raw;
+        tag = other.tag;
+        return *this;
+    }
+
+    value& operator=(value&& other) noexcept{
+        if(this != &other){
+            release();
+
+            raw = other.raw;
+            tag = other.tag;
+            other.tag = NONE;
+        }
+
+        return *this;
+    }
+
+    ~value(){
+        release();
+    }
+
+    const string& str() const{
+        return s->str;
+    }
+
+    // returns the (shared) interned string with the specified contents, adding it to the table if not yet interned
+    static value intern(const string& str);
+
+    // compares two strings for equality, in constant time if both are the same string or are both interned
+    bool str_equals(const value& other) const{
+        if(s == other.s){
+            return true;
+        }
+        else if(s->interned && other.s->interned){
+            return false;
+        }
+
+        return s->str == other.s->str;
+    }
+
+private:
+    // increments and decrements the reference count of a string, array or tlstruct instance (see below)
+    void retain() const;
+    void release();
+
+    // tlstruct instances (and symbol tables) are only defined with the symbols they hold, and hence are counted
+    // out-of-line (see symbol_table.cpp)
+    void retain_instance() const;
+    void release_instance();
+};
+
+/* Arrays are held in contiguous buffers specialised by the element type: int, float and char elements are held unboxed
+ * in int32_t, float and char buffers respectively, and bool elements in a bitset of 64-bit words (with any unused bits
+ * in the last word kept clear). Only string and tlstruct elements are held as values. Hence, for example, a
+ * float[1000000] occupies 4MB rather than 16MB, and element-wise operations may loop over the buffers directly.
+ */
+class tl_array{
+public:
+    value::Tag elt_tag;
+    int32_t size;
+    int refs = 0; // number of values holding the array
+
+    union{
+        int32_t* ints;
+        float* floats;
+        char* chars;
+        uint64_t* bits;
+        value* values;
+    };
+
+    // creates an array of the specified size with each element set to the default (zero) value of the element type
+    tl_array(value::Tag elt_tag, int32_t size){
+        this->elt_tag = elt_tag;
+        this->size = size;
+
+        switch(elt_tag){
+            case value::INT: ints = new int32_t[size](); break;
+            case value::FLOAT: floats = new float[size](); break;
+            case value::CHAR: chars = new char[size](); break;
+            case value::BOOL: bits = new uint64_t[n_words()](); break;
+            default: values = new value[size];
+        }
+    }
+
+    tl_array(const tl_array&) = delete;
+    tl_array& operator=(const tl_array&) = delete;
+
+    ~tl_array(){
+        switch(elt_tag){
+            case value::INT: delete[] ints; break;
+            case value::FLOAT: delete[] floats; break;
+            case value::CHAR: delete[] chars; break;
+            case value::BOOL: delete[] bits; break;
+            default: delete[] values;
+        }
+    }
+
+    // number of 64-bit words in the bitset of a bool array
+    int32_t n_words() const{
+        return (size + 63) / 64;
+    }
+
+    bool bit(int32_t index) const{
+        return (bits[index >> 6] >> (index & 63)) & 1;
+    }
+
+    void set_bit(int32_t index, bool b){
+        if(b){
+            bits[index >> 6] |= (uint64_t) 1 << (index & 63);
+        }
+        else{
+            bits[index >> 6] &= ~((uint64_t) 1 << (index & 63));
+        }
+    }
+
+    // clears the unused bits in the last word of the bitset of a bool array, following a word-wise operation
+    void clear_tail(){
+        if(size % 64 != 0){
+            bits[n_words() - 1] &= ((uint64_t) 1 << (size % 64)) - 1;
+        }
+    }
+
+    value get(int32_t index) const{
+        switch(elt_tag){
+            case value::INT: return ints[index];
+            case value::FLOAT: return floats[index];
+            case value::CHAR: return chars[index];
+            case value::BOOL: return bit(index);
+            default: return values[index];
+        }
+    }
+
+    void set(int32_t index, const value& elt){
+        switch(elt_tag){
+            case value::INT: ints[index] = elt.i; break;
+            case value::FLOAT: floats[index] = elt.f; break;
+            case value::CHAR: chars[index] = elt.c; break;
+            case value::BOOL: set_bit(index, elt.b); break;
+            default: values[index] = elt;
+        }
+    }
+
+    // sets each element in the range [from, size) to the specified value
+    void fill(int32_t from, const value& elt){
+        switch(elt_tag){
+            case value::INT: std::fill(ints + from, ints + size, elt.i); break;
+            case value::FLOAT: std::fill(floats + from, floats + size, elt.f); break;
+            case value::CHAR: std::fill(chars + from, chars + size, elt.c); break;
+            case value::BOOL:
+                for(int32_t i = from; i < size; i++){ set_bit(i, elt.b);}
+                break;
+            default: std::fill(values + from, values + size, elt);
+        }
+    }
+};
+
+inline void value::retain() const{
+    if(tag == STRING){
+        if(!s->interned){ s->refs++;}
+    }
+    else if(tag == ARRAY){ a->refs++;}
+    else if(tag == TLSTRUCT || tag == MEMBERS){ retain_instance();}
+}
+
+inline void value::release(){
+    if(tag == STRING){
+        if(!s->interned && --s->refs == 0){ delete s;}
+    }
+    else if(tag == ARRAY){
+        if(--a->refs == 0){ delete a;}
+    }
+    else if(tag == TLSTRUCT || tag == MEMBERS){
+        release_instance();
+    }
+}
+
+#endif //CPS2000_VALUE_H
@@ -4,19 +4,40 @@
 
 #include "astNode.h"
 
-int astNode::n_nodes = 0;
+#include "ast_arena.h"
+
+#include <algorithm>
+
+const char* astNode::kind_name(Kind kind){
+    static const char* names[] = {
+        "T_TYPE", "LITERAL", "T_IDENTIFIER", "ELEMENT", "MULTOP", "ADDOP", "RELOP", "APARAMS", "FUNC_CALL", "SUBEXPR",
+        "UNARY", "ASSIGNMENT", "VAR_DECL", "ARR_DECL", "TLS_DECL", "PRINT", "RETURN", "IF", "FOR", "WHILE", "FPARAMS",
+        "FPARAM", "FUNC_DECL", "MEMBER_ACCESS", "BLOCK", "PROGRAM", "HOISTED", "PAR_FOR"
+    };
+
+    return names[kind];
+}
 
 /* Convenience function for adding child nodes. Since we maintain positionality (see the discussion in the 'Concrete
- * Implementations' section of astNode.h as well as the section on the AST in the report), some child arrays have a pre-
- * declared size and we must ensure that we first populate those containers in the vector first. This function ensures
- * that.
+ * Implementations' section of astNode.h as well as the section on the AST in the report), some nodes have a pre-
+ * declared number of children and we must ensure that we first populate those positions first. This function ensures
+ * that. Any further children are appended, re-allocating the references to the children from the arena as need be.
  */
-void astInnerNode::add_child(astNode* child){
-    if(n_children < children->size()){
-        children->at(n_children) = child;
+void astInnerNode::add_child(astNode* child, ast_arena& arena){
+    if(n_children < children.n){
+        children.items[n_children] = child;
     }
     else{
-        children->push_back(child);
+        if(children.n == children.capacity){
+            uint32_t capacity = children.capacity == 0 ? 4 : 2 * children.capacity;
+            auto** items = static_cast<astNode**>(arena.allocate(capacity * sizeof(astNode*), alignof(astNode*)));
+
+            std::copy(children.begin(), children.end(), items);
+            children.items = items;
+            children.capacity = capacity;
+        }
+
+        children.items[children.n++] = child;
     }
 
     n_children++;
@@ -24,7 +45,7 @@ void astInnerNode::add_child(astNode* child){
 
 // Convenience function with returns a unique label for a node, based on its attributed (textual) symbol and unique id.
 string astInnerNode::getLabel(){
-    return to_string(node_id) + "_" + symbol;
+    return to_string(node_id) + "_" + kind_name(kind);
 }
 
 /* Convenience function with returns a unique label for a node, based on its attributed (textual) symbol, unique id, and
@@ -44,7 +65,7 @@ string astLeafNode::getLabel(){
         lexeme_copy.insert(closing_dquotes, 1, '\\');
     }
 
-    return to_string(node_id) + "_" + symbol + "(" + lexeme_copy + ")";
+    return to_string(node_id) + "_" + kind_name(kind) + "(" + lexeme_copy + ")";
 }
 
 // Convenience function with returns a unique label for a node, based on its attributed opcode symbol and unique id.
@@ -57,10 +78,9 @@ string astUNARY::getLabel(){
     return to_string(node_id) + "_" + op;
 }
 
-/* The following are the respective accept definitions for each concrete astNode implementation. Each call to accept:
- * (i) Binds any references (defined for convenience) of child nodes to the respective positional entry in the vector
- * (ii) Calls the visitors visit() function with the instance of the astNode concrete class, resulting in the execution
- *      of the correct overloaded handler.
+/* The following are the respective accept definitions for each concrete astNode implementation. Each call to accept
+ * calls the visitors visit() function with the instance of the astNode concrete class, resulting in the execution of
+ * the correct overloaded handler.
  */
 
 void astTYPE::accept(visitor* v){
@@ -76,26 +96,18 @@ void astIDENTIFIER::accept(visitor* v){
 }
 
 void astELEMENT::accept(visitor* v){
-    identifier = children->at(0);
-    index = children->at(1);
     v->visit(this);
 }
 
 void astMULTOP::accept(visitor* v){
-    operand1 = children->at(0);
-    operand2 = children->at(1);
     v->visit(this);
 }
 
 void astADDOP::accept(visitor* v){
-    operand1 = children->at(0);
-    operand2 = children->at(1);
     v->visit(this);
 }
 
 void astRELOP::accept(visitor* v){
-    operand1 = children->at(0);
-    operand2 = children->at(1);
     v->visit(this);
 }
 
@@ -104,87 +116,62 @@ void astAPARAMS::accept(visitor* v){
 }
 
 void astFUNC_CALL::accept(visitor* v){
-    identifier = children->at(0);
-    aparams = children->at(1);
     v->visit(this);
 }
 
 void astSUBEXPR::accept(visitor* v){
-    subexpr = children->at(0);
     v->visit(this);
 }
 
 void astUNARY::accept(visitor* v){
-    operand = children->at(0);
     v->visit(this);
 }
 
 void astASSIGNMENT_IDENTIFIER::accept(visitor* v){
-    identifier = children->at(0);
-    expression = children->at(1);
     v->visit(this);
 }
 
 void astASSIGNMENT_ELEMENT::accept(visitor* v){
-    element = children->at(0);
-    expression = children->at(1);
     v->visit(this);
 }
 
 void astASSIGNMENT_MEMBER::accept(visitor* v){
-    tls_name = children->at(0);
-    assignment = children->at(1);
     v->visit(this);
 }
 
 void astVAR_DECL::accept(visitor* v){
-    identifier = children->at(0);
-    type = children->at(1);
-    expression = children->at(2);
     v->visit(this);
 }
 
 void astARR_DECL::accept(visitor* v){
-    identifier = children->at(0);
-    size = children->at(1);
-    type = children->at(2);
     v->visit(this);
 }
 
 void astTLS_DECL::accept(visitor* v){
-    identifier = children->at(0);
-    tls_block = children->at(1);
     v->visit(this);
 }
 
 void astPRINT::accept(visitor* v){
-    expression = children->at(0);
     v->visit(this);
 }
 
 void astRETURN::accept(visitor* v){
-    expression = children->at(0);
     v->visit(this);
 }
 
 void astIF::accept(visitor* v){
-    expression = children->at(0);
-    if_block = children->at(1);
-    else_block = children->at(2);
     v->visit(this);
 }
 
 void astFOR::accept(visitor* v){
-    decl = children->at(0);
-    expression = children->at(1);
-    assignment = children->at(2);
-    for_block = children->at(3);
+    v->visit(this);
+}
+
+void astPAR_FOR::accept(visitor* v){
     v->visit(this);
 }
 
 void astWHILE::accept(visitor* v){
-    expression = children->at(0);
-    while_block = children->at(1);
     v->visit(this);
 }
 
@@ -193,22 +180,18 @@ void astFPARAMS::accept(visitor* v){
 }
 
 void astFPARAM::accept(visitor* v){
-    identifier = children->at(0);
-    type = children->at(1);
     v->visit(this);
 }
 
 void astFUNC_DECL::accept(visitor* v){
-    type = children->at(0);
-    identifier = children->at(1);
-    fparams = children->at(2);
-    function_block = children->at(3);
     v->visit(this);
 }
 
 void astMEMBER_ACCESS::accept(visitor* v){
-    tls_name = children->at(0);
-    member = children->at(1);
+    v->visit(this);
+}
+
+void astHOISTED::accept(visitor* v){
     v->visit(this);
 }
 
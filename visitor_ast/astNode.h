@@ -5,26 +5,31 @@
 #ifndef CPS2000_ASTNODE_H
 #define CPS2000_ASTNODE_H
 
-#include <vector>
+#include <cstdint>
 #include <string>
 #include "visitor.h"
 #include "../lexer/grammarDFA.h"
+#include "../symbol_table/value.h"
 
 using namespace std;
 
 class visitor;
+class funcSymbol;
+class astBLOCK;
+class ast_arena;
 
 /* Defines an instance of an abstract syntax tree node (constructed by the parser), outlining the minimum amount of meta
  * -data required to be maintained. Derivatives of this class may add further meta-data requirements. Indeed, we have a
  * concrete implementation for each (more or less) of the definitions in the EBNF.
  *
- * Typical to tree structures, we maintain a reference to the parent astNode instance (unless the node is the root, which
- * is always in fact an astPROGRAM node). We do not however maintain a reference to the child nodes. Instead, we further
- * define abstract internal and leaf node classes.
+ * Nodes are allocated from an ast_arena held by the parser (see ast_arena.h), and are freed all at once with the arena.
+ * Hence nodes are kept compact: the kind of node is maintained as a single byte (rather than as a string), and we do not
+ * maintain a reference to the parent node (which is never required following parsing). Instead, we further define
+ * abstract internal and leaf node classes, with internal nodes maintaining references to their child nodes.
  *
  * We maintain a number of information which, per-se, is not necessary and for purposes outside this assignment, we can
- * do without. This includes textual information, a unique node_id, etc, which allows the ability to generate a detailed
- * and meaningful pictorial representation of the abstract syntax tree.
+ * do without. This includes a unique node_id (assigned by the arena), which along with the kind of node allows the ability
+ * to generate a detailed and meaningful pictorial representation of the abstract syntax tree.
  *
  * We also maintain useful meta-data as well however, such as the line number of the token (or first token in the sequence
  * of tokens) associated with the astNode.
@@ -34,38 +39,71 @@ class visitor;
  */
 class astNode{
 public:
-    astNode* parent;
-    string symbol;
+    enum Kind : uint8_t{
+        T_TYPE, LITERAL, T_IDENTIFIER, ELEMENT, MULTOP, ADDOP, RELOP, APARAMS, FUNC_CALL, SUBEXPR, UNARY, ASSIGNMENT,
+        VAR_DECL, ARR_DECL, TLS_DECL, PRINT, RETURN, IF, FOR, WHILE, FPARAMS, FPARAM, FUNC_DECL, MEMBER_ACCESS, BLOCK,
+        PROGRAM, HOISTED, PAR_FOR
+    };
+
+    Kind kind;
     unsigned int line;
-    static int n_nodes;
-    int node_id;
+    int node_id = 0;
 
     virtual void accept(visitor* v) = 0;
     virtual string getLabel() = 0;
 
-    astNode(astNode* parent, string symbol, unsigned int line){
-        n_nodes++;
-        node_id = n_nodes;
+    // the textual symbol attributed to the kind of node (eg. "MULTOP"), used for labels
+    static const char* kind_name(Kind kind);
 
-        this->parent = parent;
-        this->symbol = symbol;
+    astNode(Kind kind, unsigned int line){
+        this->kind = kind;
         this->line = line;
     }
 };
 
-/* Adds the support of maintaining references to child astNode instances, by maintaining a vector of pointers to astNode
- * instances. A convenience function for adding child nodes is defined.
+/* A view of the references to the child nodes of an internal node, held contiguously. For nodes with a fixed number of
+ * (positional) children, the references are held inline in the node itself (see astFixedNode), whereas for nodes with a
+ * variable number of children (eg. the statements in a block), the references are held in an array allocated from the
+ * arena, which is re-allocated (doubling in capacity) as children are added.
+ */
+class ast_children{
+public:
+    astNode** items = nullptr;
+    uint32_t n = 0; // number of positions, i.e. the fixed number of children, or the number of children added
+    uint32_t capacity = 0;
+
+    astNode** begin() const{ return items;}
+    astNode** end() const{ return items + n;}
+    astNode*& at(size_t i) const{ return items[i];}
+    size_t size() const{ return n;}
+};
+
+/* Adds the support of maintaining references to child astNode instances. A convenience function for adding child nodes
+ * is defined.
  */
 class astInnerNode: public astNode{
 public:
-    vector<astNode*>* children = new vector<astNode*>(0);
-    int n_children = 0;
+    ast_children children;
+    uint32_t n_children = 0;
 
     virtual void accept(visitor* v) = 0;
-    void add_child(astNode*);
+    void add_child(astNode*, ast_arena&);
     string getLabel();
 
-    astInnerNode(astInnerNode* parent, string symbol, unsigned int line) : astNode(parent, symbol, line){};
+    astInnerNode(Kind kind, unsigned int line) : astNode(kind, line){};
+};
+
+// An internal node with N positional children, the references to which are held inline (initially nullptr)
+template<int N>
+class astFixedNode: public astInnerNode{
+public:
+    astNode* slots[N] = {};
+
+    astFixedNode(Kind kind, unsigned int line) : astInnerNode(kind, line){
+        children.items = slots;
+        children.n = N;
+        children.capacity = N;
+    }
 };
 
 /* The abstract syntax tree we construct is in such a manner such that the leaf nodes represent some terminal symbol,
@@ -79,30 +117,27 @@ public:
     virtual void accept(visitor* v) = 0;
     string getLabel();
 
-    astLeafNode(astInnerNode* parent, string symbol, unsigned int line, string lexeme) :
-        astNode(parent, symbol, line){
-            this->lexeme = std::move(lexeme);
+    astLeafNode(Kind kind, unsigned int line, string lexeme) : astNode(kind, line){
+        this->lexeme = std::move(lexeme);
     };
 };
 
 /* For conveience, we also define an abstract astNode derivative for binary operands, which in particular maintains the
  * opcode and reference to the two astNode instances representing the operands.
  */
-class astBinaryOp: public astInnerNode{
+class astBinaryOp: public astFixedNode<2>{
 public:
     string op;
-    astNode* operand1;
-    astNode* operand2;
+    astNode*& operand1(){ return slots[0];}
+    astNode*& operand2(){ return slots[1];}
+    // object class of the result, set during semantic analysis (array-valued expressions are evaluated fused)
+    grammarDFA::Symbol object_class = grammarDFA::SINGLETON;
 
     virtual void accept(visitor* v) = 0;
     string getLabel();
 
-    astBinaryOp(astInnerNode* parent, string op, string symbol, unsigned int line) :
-        astInnerNode(parent, symbol, line){
-            this->op = op;
-            children->resize(2, nullptr);
-            operand1 = children->at(0);
-            operand2 = children->at(1);
+    astBinaryOp(string op, Kind kind, unsigned int line) : astFixedNode<2>(kind, line){
+        this->op = std::move(op);
     }
 };
 
@@ -115,9 +150,9 @@ public:
  * followed by an expression, then an assignment, and then a block of statements. In this case, these would respectively
  * occupy indices 0 up to 3 in the child node vector. However, the declaration and assignment statements are optional;
  * in the case that these are omitted, a nullptr reference is maintained instead at that positional index. In this manner,
- * we preserve positionality. To this extent, certain concrete node implementations bind certain elements in the child
- * node vector to a named variable, for convenience. For example, in the case of astFOR, we have astNode* for_block =
- * children->at(3).
+ * we preserve positionality. To this extent, certain concrete node implementations name certain elements in the child
+ * node vector through an inline accessor, for convenience. For example, in the case of astFOR, for_block() is the
+ * reference held at children.at(3).
  * --------------------------------------------------------------------------------------------------------------------
  */
 
@@ -126,8 +161,13 @@ public:
     grammarDFA::Symbol type;
     grammarDFA::Symbol object_class;
 
-    astTYPE(astInnerNode* parent, string lexeme, grammarDFA::Symbol type, grammarDFA::Symbol object_class, unsigned int line):
-        astLeafNode(parent, "T_TYPE", line, std::move(lexeme)){
+    // for tlstruct named types (set by the resolver): the tlstruct definition block, and the number of static links to
+    // follow from the current frame to reach the frame in which the tlstruct is defined
+    astBLOCK* tls_ref = nullptr;
+    int depth = 0;
+
+    astTYPE(string lexeme, grammarDFA::Symbol type, grammarDFA::Symbol object_class, unsigned int line):
+        astLeafNode(T_TYPE, line, std::move(lexeme)){
         this->type = type;
         this->object_class = object_class;
     }
@@ -139,9 +179,10 @@ class astLITERAL: public astLeafNode{
 public:
     grammarDFA::Symbol type;
     string type_str;
+    value constant; // the value denoted by the lexeme, decoded once by the constant_folder
 
-    astLITERAL(astInnerNode* parent, string lexeme, grammarDFA::Symbol type, string type_str, unsigned int line) :
-        astLeafNode(parent, "LITERAL", line,std::move(lexeme)){
+    astLITERAL(string lexeme, grammarDFA::Symbol type, string type_str, unsigned int line) :
+        astLeafNode(LITERAL, line, std::move(lexeme)){
             this->type = type;
             this->type_str = type_str;
     }
@@ -151,283 +192,309 @@ public:
 
 class astIDENTIFIER: public astLeafNode{
 public:
-    astIDENTIFIER(astInnerNode* parent, string lexeme, unsigned int line) : astLeafNode(parent, "T_IDENTIFIER",
-                                                                                        line, std::move(lexeme)){}
+    // frame address set by the resolver: the number of static links to follow from the current frame, and the slot in
+    // the frame reached; a depth of -1 denotes a member of a tlstruct instance, in which case the slot is the offset of
+    // the member in the instance (set during semantic analysis)
+    int depth = -1;
+    int slot = -1;
+
+    astIDENTIFIER(string lexeme, unsigned int line) : astLeafNode(T_IDENTIFIER, line, std::move(lexeme)){}
 
     void accept(visitor* v) override;
 };
 
-class astELEMENT: public astInnerNode{
+class astELEMENT: public astFixedNode<2>{
 public:
-    astNode* identifier;
-    astNode* index;
+    astNode*& identifier(){ return slots[0];}
+    astNode*& index(){ return slots[1];}
+    grammarDFA::Symbol type = grammarDFA::T_AUTO; // type of the element, set during semantic analysis
 
-    explicit astELEMENT(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "ELEMENT", line){
-        children->resize(2, nullptr);
-    }
+    explicit astELEMENT(unsigned int line) : astFixedNode<2>(ELEMENT, line){}
 
     void accept(visitor* v) override;
 };
 
 class astMULTOP: public astBinaryOp{
 public:
-    astMULTOP(astInnerNode* parent, string op, unsigned int line) :
-    astBinaryOp(parent, op, "MULTOP", line){}
+    astMULTOP(string op, unsigned int line) : astBinaryOp(std::move(op), MULTOP, line){}
 
     void accept(visitor* v) override;
 };
 
 class astADDOP: public astBinaryOp{
 public:
-    astADDOP(astInnerNode* parent, string op, unsigned int line) :
-            astBinaryOp(parent, op, "ADDOP", line){}
+    astADDOP(string op, unsigned int line) : astBinaryOp(std::move(op), ADDOP, line){}
 
     void accept(visitor* v) override;
 };
 
 class astRELOP: public astBinaryOp{
 public:
-    astRELOP(astInnerNode* parent, string op, unsigned int line) :
-            astBinaryOp(parent, op, "RELOP", line){}
+    astRELOP(string op, unsigned int line) : astBinaryOp(std::move(op), RELOP, line){}
 
     void accept(visitor* v) override;
 };
 
 class astAPARAMS: public astInnerNode{
 public:
-    explicit astAPARAMS(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "APARAMS", line){}
+    explicit astAPARAMS(unsigned int line) : astInnerNode(APARAMS, line){}
 
     void accept(visitor* v) override;
 };
 
-class astFUNC_CALL: public astInnerNode{
+class astFUNC_CALL: public astFixedNode<2>{
 public:
-    astNode* identifier;
-    astNode* aparams;
+    astNode*& identifier(){ return slots[0];}
+    astNode*& aparams(){ return slots[1];}
+    funcSymbol* callee = nullptr; // function resolved during semantic analysis (by identifier and type-signature)
+    int depth = 0; // number of static links to follow from the current frame to reach the static parent of the callee
 
-    explicit astFUNC_CALL(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "FUNC_CALL", line){
-        children->resize(2, nullptr);
-    }
+    explicit astFUNC_CALL(unsigned int line) : astFixedNode<2>(FUNC_CALL, line){}
 
     void accept(visitor* v) override;
 };
 
-class astSUBEXPR: public astInnerNode{
+class astSUBEXPR: public astFixedNode<1>{
 public:
-    astNode* subexpr;
+    astNode*& subexpr(){ return slots[0];}
 
-    explicit astSUBEXPR(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "SUBEXPR", line){
-        children->resize(1, nullptr);
-    }
+    explicit astSUBEXPR(unsigned int line) : astFixedNode<1>(SUBEXPR, line){}
 
     void accept(visitor* v) override;
 };
 
-class astUNARY: public astInnerNode{
+class astUNARY: public astFixedNode<1>{
 public:
     string op;
-    astNode* operand;
+    astNode*& operand(){ return slots[0];}
+    grammarDFA::Symbol object_class = grammarDFA::SINGLETON; // object class of the result, set during semantic analysis
 
-    explicit astUNARY(astInnerNode* parent, string op, unsigned int line) :
-        astInnerNode(parent, "UNARY", line){
-            this->op = op;
-            children->resize(1, nullptr);
+    explicit astUNARY(string op, unsigned int line) : astFixedNode<1>(UNARY, line){
+        this->op = std::move(op);
     }
 
     string getLabel() override;
     void accept(visitor* v) override;
 };
 
-class astASSIGNMENT_IDENTIFIER: public astInnerNode{
+class astASSIGNMENT_IDENTIFIER: public astFixedNode<2>{
 public:
-    astNode* identifier;
-    astNode* expression;
+    astNode*& identifier(){ return slots[0];}
+    astNode*& expression(){ return slots[1];}
 
-    explicit astASSIGNMENT_IDENTIFIER(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "ASSIGNMENT", line){
-        children->resize(2, nullptr);
-    }
+    explicit astASSIGNMENT_IDENTIFIER(unsigned int line) : astFixedNode<2>(ASSIGNMENT, line){}
 
     void accept(visitor* v) override;
 };
 
-class astASSIGNMENT_ELEMENT: public astInnerNode{
+class astASSIGNMENT_ELEMENT: public astFixedNode<2>{
 public:
-    astNode* element;
-    astNode* expression;
+    astNode*& element(){ return slots[0];}
+    astNode*& expression(){ return slots[1];}
 
-    explicit astASSIGNMENT_ELEMENT(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "ASSIGNMENT", line){
-        children->resize(2, nullptr);
-    }
+    explicit astASSIGNMENT_ELEMENT(unsigned int line) : astFixedNode<2>(ASSIGNMENT, line){}
 
     void accept(visitor* v) override;
 };
 
-class astASSIGNMENT_MEMBER: public astInnerNode{
+class astASSIGNMENT_MEMBER: public astFixedNode<2>{
 public:
-    astNode* tls_name;
-    astNode* assignment;
+    astNode*& tls_name(){ return slots[0];}
+    astNode*& assignment(){ return slots[1];}
 
-    explicit astASSIGNMENT_MEMBER(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "ASSIGNMENT", line){
-        children->resize(2, nullptr);
-    }
+    explicit astASSIGNMENT_MEMBER(unsigned int line) : astFixedNode<2>(ASSIGNMENT, line){}
 
     void accept(visitor* v) override;
 };
 
-class astVAR_DECL: public astInnerNode{
+class astVAR_DECL: public astFixedNode<3>{
 public:
-    astNode* identifier;
-    astNode* type;
-    astNode* expression;
+    astNode*& identifier(){ return slots[0];}
+    astNode*& type(){ return slots[1];}
+    astNode*& expression(){ return slots[2];}
 
-    explicit astVAR_DECL(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "VAR_DECL", line){
-        children->resize(3, nullptr);
-    }
+    explicit astVAR_DECL(unsigned int line) : astFixedNode<3>(VAR_DECL, line){}
 
     void accept(visitor* v) override;
 };
 
-class astARR_DECL: public astInnerNode{
+class astARR_DECL: public astFixedNode<3>{
 public:
-    astNode* identifier;
-    astNode* size;
-    astNode* type;
+    astNode*& identifier(){ return slots[0];}
+    astNode*& size(){ return slots[1];}
+    astNode*& type(){ return slots[2];}
 
-    explicit astARR_DECL(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "ARR_DECL", line){
-        children->resize(3, nullptr);
-    }
+    explicit astARR_DECL(unsigned int line) : astFixedNode<3>(ARR_DECL, line){}
 
     void accept(visitor* v) override;
 };
 
-class astTLS_DECL: public astInnerNode{
+class astTLS_DECL: public astFixedNode<2>{
 public:
-    astNode* identifier;
-    astNode* tls_block;
+    astNode*& identifier(){ return slots[0];}
+    astNode*& tls_block(){ return slots[1];}
 
-    explicit astTLS_DECL(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "TLS_DECL", line){
-        children->resize(2, nullptr);
-    }
+    explicit astTLS_DECL(unsigned int line) : astFixedNode<2>(TLS_DECL, line){}
 
     void accept(visitor* v) override;
 };
 
-class astPRINT: public astInnerNode{
+class astPRINT: public astFixedNode<1>{
 public:
-    astNode* expression;
+    astNode*& expression(){ return slots[0];}
 
-    explicit astPRINT(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "PRINT", line){
-        children->resize(1, nullptr);
-    }
+    explicit astPRINT(unsigned int line) : astFixedNode<1>(PRINT, line){}
 
     void accept(visitor* v) override;
 };
 
-class astRETURN: public astInnerNode{
+class astRETURN: public astFixedNode<1>{
 public:
-    astNode* expression;
+    astNode*& expression(){ return slots[0];}
 
-    explicit astRETURN(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "RETURN", line){
-        children->resize(1, nullptr);
-    }
+    explicit astRETURN(unsigned int line) : astFixedNode<1>(RETURN, line){}
 
     void accept(visitor* v) override;
 };
 
-class astIF: public astInnerNode{
+class astIF: public astFixedNode<3>{
 public:
-    astNode* expression;
-    astNode* if_block;
-    astNode* else_block;
+    astNode*& expression(){ return slots[0];}
+    astNode*& if_block(){ return slots[1];}
+    astNode*& else_block(){ return slots[2];}
 
-    explicit astIF(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "IF", line){
-        children->resize(3, nullptr);
-    }
+    explicit astIF(unsigned int line) : astFixedNode<3>(IF, line){}
 
     void accept(visitor* v) override;
 };
 
-class astFOR: public astInnerNode{
+class astFOR: public astFixedNode<4>{
 public:
-    astNode* decl;
-    astNode* expression;
-    astNode* assignment;
-    astNode* for_block;
+    astNode*& decl(){ return slots[0];}
+    astNode*& expression(){ return slots[1];}
+    astNode*& assignment(){ return slots[2];}
+    astNode*& for_block(){ return slots[3];}
+    // the range of frame slots caching the expressions hoisted out of the loop (set by the loop_hoister)
+    int hoisted_first = 0;
+    int n_hoisted = 0;
 
-    explicit astFOR(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "FOR", line){
-        children->resize(4, nullptr);
-    }
+    explicit astFOR(unsigned int line) : astFixedNode<4>(FOR, line){}
 
     void accept(visitor* v) override;
+
+protected:
+    astFOR(Kind kind, unsigned int line) : astFixedNode<4>(kind, line){}
 };
 
-class astWHILE: public astInnerNode{
+/* A parallel for loop, i.e. one whose iterations are independent of each other and may hence be executed concurrently.
+ * The semantic analysis restricts the header to the form parallel for(let i:int = a; i < b; i = i + 1) (or i <= b)
+ * and the body to writes to its own locals and to the elements of arrays indexed by the loop variable, such that
+ * executing the iterations in any order yields the same result as executing them sequentially.
+ */
+class astPAR_FOR: public astFOR{
 public:
-    astNode* expression;
-    astNode* while_block;
+    explicit astPAR_FOR(unsigned int line) : astFOR(PAR_FOR, line){}
 
-    explicit astWHILE(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "WHILE", line){
-        children->resize(2, nullptr);
-    }
+    void accept(visitor* v) override;
+};
+
+class astWHILE: public astFixedNode<2>{
+public:
+    astNode*& expression(){ return slots[0];}
+    astNode*& while_block(){ return slots[1];}
+    // the range of frame slots caching the expressions hoisted out of the loop (set by the loop_hoister)
+    int hoisted_first = 0;
+    int n_hoisted = 0;
+
+    explicit astWHILE(unsigned int line) : astFixedNode<2>(WHILE, line){}
 
     void accept(visitor* v) override;
 };
 
 class astFPARAMS: public astInnerNode{
 public:
-    explicit astFPARAMS(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "FPARAMS", line){}
+    explicit astFPARAMS(unsigned int line) : astInnerNode(FPARAMS, line){}
 
     void accept(visitor* v) override;
 };
 
-class astFPARAM: public astInnerNode{
+class astFPARAM: public astFixedNode<2>{
 public:
-    astNode* identifier;
-    astNode* type;
+    astNode*& identifier(){ return slots[0];}
+    astNode*& type(){ return slots[1];}
 
-    explicit astFPARAM(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "FPARAM", line){
-        children->resize(2, nullptr);
-    }
+    explicit astFPARAM(unsigned int line) : astFixedNode<2>(FPARAM, line){}
 
     void accept(visitor* v) override;
 };
 
-class astFUNC_DECL: public astInnerNode{
+class astFUNC_DECL: public astFixedNode<4>{
 public:
-    astNode* type;
-    astNode* identifier;
-    astNode* fparams;
-    astNode* function_block;
+    astNode*& type(){ return slots[0];}
+    astNode*& identifier(){ return slots[1];}
+    astNode*& fparams(){ return slots[2];}
+    astNode*& function_block(){ return slots[3];}
 
-    explicit astFUNC_DECL(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "FUNC_DECL", line){
-        children->resize(4, nullptr);
-    }
+    explicit astFUNC_DECL(unsigned int line) : astFixedNode<4>(FUNC_DECL, line){}
 
     void accept(visitor* v) override;
 };
 
-class astMEMBER_ACCESS: public astInnerNode{
+class astMEMBER_ACCESS: public astFixedNode<2>{
 public:
-    astNode* tls_name;
-    astNode* member;
+    astNode*& tls_name(){ return slots[0];}
+    astNode*& member(){ return slots[1];}
+    // type and object class of the member accessed (or returned by the member function), set during semantic analysis
+    grammarDFA::Symbol type = grammarDFA::T_AUTO;
+    grammarDFA::Symbol object_class = grammarDFA::SINGLETON;
 
-    explicit astMEMBER_ACCESS(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "MEMBER_ACCESS", line){
-        children->resize(2, nullptr);
+    explicit astMEMBER_ACCESS(unsigned int line) : astFixedNode<2>(MEMBER_ACCESS, line){}
+
+    void accept(visitor* v) override;
+};
+
+/* Wraps a loop-invariant expression hoisted out of a loop by the loop_hoister: the expression is evaluated at most once
+ * per entry into the loop (on the first evaluation of the node), with the result cached in the specified slot of the
+ * current frame (or, in the case of the virtual machine, in a register) and reused by subsequent iterations.
+ */
+class astHOISTED: public astFixedNode<1>{
+public:
+    astNode*& expression(){ return slots[0];}
+    int slot;
+
+    astHOISTED(astNode* expression, int slot, unsigned int line) : astFixedNode<1>(HOISTED, line){
+        this->slot = slot;
+        slots[0] = expression;
     }
 
     void accept(visitor* v) override;
 };
 
+/* The layout of the instances of a tlstruct, computed once per definition during semantic analysis: each member declared
+ * at the top level of the definition block is assigned an offset (in declaration order) in the flat record holding the
+ * members of an instance (see tl_record), with which each identifier referring to the member is annotated. Member
+ * functions are bound to each call during semantic analysis (see astFUNC_CALL::callee), and hence are shared by all
+ * instances rather than held by them.
+ */
+struct tls_layout{
+    int n_fields = 0;
+};
+
 class astBLOCK: public astInnerNode{
 public:
-    explicit astBLOCK(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "BLOCK", line){}
+    int frame_size = 0; // for function and tlstruct definition blocks, the number of slots in a frame (set by the resolver)
+    tls_layout* layout = nullptr; // for tlstruct definition blocks, the layout of instances (set in semantic analysis)
+
+    explicit astBLOCK(unsigned int line) : astInnerNode(BLOCK, line){}
 
     void accept(visitor* v) override;
 };
 
 class astPROGRAM: public astInnerNode{
 public:
-    explicit astPROGRAM(astInnerNode* parent, unsigned int line) : astInnerNode(parent, "PROGRAM", line){}
+    int frame_size = 0; // the number of slots in the frame of the main program, i.e. global variables (set by the resolver)
+
+    explicit astPROGRAM(unsigned int line) : astInnerNode(PROGRAM, line){}
 
     void accept(visitor* v) override;
 };
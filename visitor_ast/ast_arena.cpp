@@ -0,0 +1,38 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "ast_arena.h"
+
+#include <cstdint>
+
+void* ast_arena::allocate(size_t size, size_t align){
+    auto addr = (uintptr_t) curr;
+    uintptr_t aligned = (addr + align - 1) & ~(uintptr_t) (align - 1);
+
+    if(curr == nullptr || aligned + size > (uintptr_t) end){
+        // start a new block (or a dedicated block, in the unlikely case of an allocation larger than a block)
+        size_t block_size = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+        char* block = static_cast<char*>(::operator new(block_size)); // aligned to alignof(max_align_t)
+
+        blocks.push_back(block);
+        reserved_bytes += block_size;
+        curr = block;
+        end = block + block_size;
+        aligned = (uintptr_t) block;
+    }
+
+    curr = (char*) (aligned + size);
+    return (void*) aligned;
+}
+
+ast_arena::~ast_arena(){
+    // destroy objects in the reverse order of construction, and then release the blocks in one go
+    for(auto it = finalizers.rbegin(); it != finalizers.rend(); it++){
+        it->destroy(it->object);
+    }
+
+    for(char* block : blocks){
+        ::operator delete(block);
+    }
+}
@@ -0,0 +1,70 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_AST_ARENA_H
+#define CPS2000_AST_ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/* A bump allocator from which the nodes of an abstract syntax tree (and the arrays of child references of nodes with a
+ * variable number of children) are allocated. Memory is obtained in blocks of BLOCK_SIZE bytes, and each allocation
+ * simply advances a pointer into the current block, such that nodes are laid out contiguously in the order in which they
+ * are created by the parser (i.e. roughly in the order in which they are visited).
+ *
+ * Nodes are never freed individually; rather, the entire tree is freed at once when the arena is destroyed. Since some
+ * nodes hold strings (eg. the lexeme of leaf nodes), the destructors of such nodes are recorded upon allocation, and run
+ * when the arena is destroyed.
+ */
+class ast_arena{
+public:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    size_t n_nodes = 0; // number of nodes allocated, also used to assign each node a unique id
+
+    ast_arena() = default;
+    ast_arena(const ast_arena&) = delete;
+    ast_arena& operator=(const ast_arena&) = delete;
+    ~ast_arena();
+
+    // allocates and constructs a node of type T, assigning it the next node id
+    template<typename T, typename... Args>
+    T* make(Args&&... args){
+        T* node = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        node->node_id = (int) ++n_nodes;
+
+        if(!is_trivially_destructible<T>::value){
+            finalizers.push_back({node, [](void* object){ static_cast<T*>(object)->~T();}});
+        }
+
+        return node;
+    }
+
+    // allocates uninitialised memory of the specified size and alignment (a power of 2, at most alignof(max_align_t))
+    void* allocate(size_t size, size_t align);
+
+    // the number of bytes obtained from the system for blocks
+    size_t reserved() const{
+        return reserved_bytes;
+    }
+
+private:
+    struct finalizer{
+        void* object;
+        void (*destroy)(void*);
+    };
+
+    vector<char*> blocks;
+    char* curr = nullptr; // next free byte in the current block
+    char* end = nullptr; // end of the current block
+    size_t reserved_bytes = 0;
+    vector<finalizer> finalizers;
+};
+
+#endif //CPS2000_AST_ARENA_H
@@ -28,6 +28,7 @@ class astPRINT;
 class astRETURN;
 class astIF;
 class astFOR;
+class astPAR_FOR;
 class astWHILE;
 class astFPARAMS;
 class astFPARAM;
@@ -35,6 +36,7 @@ class astFUNC_DECL;
 class astMEMBER_ACCESS;
 class astBLOCK;
 class astPROGRAM;
+class astHOISTED;
 
 class visitor{
 public:
@@ -59,6 +61,7 @@ public:
     virtual void visit(astRETURN* ast_return) = 0;
     virtual void visit(astIF* ast_if) = 0;
     virtual void visit(astFOR* ast_for) = 0;
+    virtual void visit(astPAR_FOR* ast_par_for) = 0;
     virtual void visit(astWHILE* ast_while) = 0;
     virtual void visit(astFPARAMS* ast_fparams) = 0;
     virtual void visit(astFPARAM* ast_fparam) = 0;
@@ -66,6 +69,7 @@ public:
     virtual void visit(astMEMBER_ACCESS* ast_member_acc) = 0;
     virtual void visit(astBLOCK* ast_block) = 0;
     virtual void visit(astPROGRAM* ast_program) = 0;
+    virtual void visit(astHOISTED* ast_hoisted) = 0;
 };
 
 #endif //CPS2000_VISITOR_H
@@ -0,0 +1,224 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_BYTECODE_H
+#define CPS2000_BYTECODE_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace std;
+
+struct vm_string;
+struct vm_array;
+struct vm_struct;
+
+/* A register of the virtual machine. Registers are untagged: since Tea2Lang is statically typed, the bytecode compiler
+ * knows the type held in each register at every program point and selects a typed opcode accordingly (eg. ADD_I32 vs
+ * ADD_F32). Hence a register need only be wide enough for the largest primitive, i.e. 8 bytes (a pointer), with strings,
+ * arrays and tlstruct instances held by reference.
+ */
+union vm_value{
+    int32_t i;
+    float f;
+    bool b;
+    char c;
+    vm_string* s;
+    vm_array* a;
+    vm_struct* t;
+};
+
+/* The header of each string, array and tlstruct instance allocated at run time, which is owned by the heap of the virtual
+ * machine and freed once no longer reachable from the registers (see vm_heap). String constants are owned by the
+ * program instead, and are never freed.
+ */
+struct vm_object{
+    enum Kind : uint8_t{
+        STRING, ARRAY, STRUCT
+    };
+
+    Kind kind;
+    bool marked = false;
+
+    explicit vm_object(Kind kind) : kind(kind){}
+};
+
+/* Run-time representation of a string. Strings are immutable, however a string may share the buffer holding its
+ * characters with the strings of which it is a prefix: appending to the string at the end of a buffer extends the buffer
+ * in place (leaving the characters of the strings sharing it unchanged), such that building a string through repeated
+ * appends takes linear rather than quadratic time.
+ */
+struct vm_string: vm_object{
+    shared_ptr<string> chars;
+    size_t length;
+
+    explicit vm_string(const string& str) : vm_object(STRING), chars(make_shared<string>(str)), length(str.size()){}
+    vm_string(shared_ptr<string> chars, size_t length) : vm_object(STRING), chars(std::move(chars)), length(length){}
+
+    string_view view() const{ return string_view(chars->data(), length);}
+};
+
+// Run-time representation of an array; elements are stored contiguously as registers, and hence hold any element type
+struct vm_array: vm_object{
+    int32_t size;
+    vm_value* data;
+
+    explicit vm_array(int32_t size) : vm_object(ARRAY), size(size), data(new vm_value[size]()){} // elements are zeroed
+    ~vm_array(){ delete[] data;}
+};
+
+// Run-time representation of a tlstruct instance; the members are laid out in declaration order (see vm_layout)
+struct vm_struct: vm_object{
+    int32_t layout;
+    uint16_t n_fields;
+    vm_value* fields;
+
+    vm_struct(int32_t layout, uint16_t n_fields) : vm_object(STRUCT), layout(layout), n_fields(n_fields),
+                                                   fields(new vm_value[n_fields]()){} // members are zeroed
+    ~vm_struct(){ delete[] fields;}
+};
+
+/* The element type tags used by instructions which must know the type of the values they operate on at run time, i.e.
+ * printing, and element-wise array operations (where the scalar operation is applied per element).
+ */
+enum vm_type : uint16_t{
+    VT_BOOL, VT_INT, VT_FLOAT, VT_CHAR, VT_STRING, VT_STRUCT
+};
+
+/* The instruction set. Operands a, b and c are register indices unless otherwise stated, where 'k' denotes an index into
+ * the constant pool, 'g' an absolute register index in the bottom-most (global) frame, 'f' a function index, 'l' a
+ * tlstruct layout index, and 'j' a jump target (an instruction index held across operands b and c).
+ *
+ * Scalar binary operations are typed: the suffix gives the type of the operands (I32 = int, F32 = float, C8 = char,
+ * B = bool, STR = string), so that no run-time dispatch on the type of a value is ever required.
+ */
+enum vm_opcode : uint16_t{
+    OP_HALT,
+    OP_MOV,             // a <- b
+    OP_LOADK,           // a <- constants[k = b]
+    OP_LOADG,           // a <- globals[g = b]
+    OP_STOREG,          // globals[g = a] <- b
+
+    OP_ADD_I32, OP_SUB_I32, OP_MUL_I32, OP_DIV_I32,    // a <- b op c
+    OP_ADD_F32, OP_SUB_F32, OP_MUL_F32, OP_DIV_F32,
+    OP_ADD_C8, OP_SUB_C8,
+    OP_ADD_STR,
+    OP_AND, OP_OR,
+
+    OP_EQ_I32, OP_NE_I32, OP_LT_I32, OP_LE_I32, OP_GT_I32, OP_GE_I32,
+    OP_EQ_F32, OP_NE_F32, OP_LT_F32, OP_LE_F32, OP_GT_F32, OP_GE_F32,
+    OP_EQ_C8, OP_NE_C8, OP_LT_C8, OP_LE_C8, OP_GT_C8, OP_GE_C8,
+    OP_EQ_B, OP_NE_B, OP_LT_B, OP_LE_B, OP_GT_B, OP_GE_B,
+    OP_EQ_STR, OP_NE_STR, OP_LT_STR, OP_LE_STR, OP_GT_STR, OP_GE_STR,
+
+    OP_NEG_I32, OP_NEG_F32, OP_NOT,                    // a <- op b
+
+    OP_ARR_BINOP,       // a <- b op c element-wise; the following instruction holds the scalar opcode in its op field
+    OP_ARR_UNOP,        // a <- op b element-wise; the following instruction holds the scalar opcode in its op field
+    OP_NEWARR,          // a <- new array of size b, which will be initialised with c (immediate) elements
+    OP_AFILL,           // a[c (immediate)...size-1] <- b
+    OP_ASETI,           // a[b (immediate)] <- c
+    OP_ALOAD,           // a <- b[c]
+    OP_ASTORE,          // a[b] <- c
+    OP_ACHKSIZE,        // run-time error unless a and b are arrays of the same size
+
+    OP_NEWSTRUCT,       // a <- new instance of layout l = b, with all members zeroed (initialised by its init function)
+    OP_LOADF,           // a <- b.fields[c (immediate)]
+    OP_STOREF,          // a.fields[b (immediate)] <- c
+
+    OP_JMP,             // pc <- j
+    OP_JMPF,            // if not a: pc <- j
+    OP_JMPT,            // if a: pc <- j
+
+    OP_CALL,            // call function f = b with its frame based at register a; the result is returned in a
+    OP_RET,             // return a to the caller
+
+    OP_PRINT,           // print a, of type b (vm_type)
+    OP_PRINT_ARR        // print array a, with elements of type b (vm_type)
+};
+
+struct vm_instruction{
+    vm_opcode op;
+    uint16_t a;
+    uint16_t b;
+    uint16_t c;
+
+    uint32_t target() const{ return ((uint32_t) c << 16u) | b;}
+    void set_target(uint32_t j){ b = (uint16_t) (j & 0xFFFFu); c = (uint16_t) (j >> 16u);}
+};
+
+/* Debugging information associated with each instruction, namely the source line number and (for array instructions)
+ * the identifier of the array, used solely for reporting run-time errors in the same manner as the interpreter.
+ */
+struct vm_debug_info{
+    unsigned int line;
+    int32_t name; // index into bytecode_program::names, -1 if not applicable
+};
+
+struct vm_function{
+    string identifier;
+    uint16_t n_params; // including the implicit tlstruct instance for member functions
+    uint16_t n_regs;
+    vector<vm_instruction> code;
+    vector<vm_debug_info> debug;
+};
+
+// The layout of a tlstruct: the number of members and the function which initialises the members of a new instance
+struct vm_layout{
+    string identifier;
+    uint16_t n_fields;
+    uint16_t init_func;
+};
+
+/* A compiled Tea2Lang program. Function 0 is always the (implicit) main function holding the top-level statements of
+ * the program; its frame sits at the bottom of the register stack, and hence its registers double as the global
+ * variables which are accessible from within any function via OP_LOADG and OP_STOREG.
+ */
+struct bytecode_program{
+    vector<vm_function> functions;
+    vector<vm_layout> layouts;
+    vector<vm_value> constants;
+    deque<vm_string> string_constants; // deque so that references held by constants are never invalidated
+    vector<uint32_t> string_constant_ids; // the index in constants of each of the string_constants, in the same order
+    vector<string> names;
+};
+
+/* The view of a function executed by the virtual machine. The instructions and debugging information are referenced
+ * rather than owned, such that they can be executed either in place from a bytecode_program, or directly from a memory
+ * mapped program image (see program_image) without being copied.
+ */
+struct vm_routine{
+    const vm_instruction* code;
+    const vm_debug_info* debug;
+    uint32_t n_instructions;
+    uint16_t n_params;
+    uint16_t n_regs;
+};
+
+// The view of a program executed by the virtual machine; the referenced program (or image) must outlive it
+struct vm_executable{
+    vector<vm_routine> functions;
+    const vm_layout* layouts = nullptr;
+    const vm_value* constants = nullptr;
+    const string* names = nullptr;
+
+    vm_executable() = default;
+
+    explicit vm_executable(const bytecode_program& program){
+        for(const vm_function& func : program.functions){
+            functions.push_back(vm_routine{func.code.data(), func.debug.data(), (uint32_t) func.code.size(),
+                                           func.n_params, func.n_regs});
+        }
+
+        layouts = program.layouts.data();
+        constants = program.constants.data();
+        names = program.names.data();
+    }
+};
+
+#endif //CPS2000_BYTECODE_H
@@ -0,0 +1,1034 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include <cstring>
+#include <iostream>
+#include "bytecode_compiler.h"
+
+// ----- CODE GENERATION UTILITY FUNCTIONS -----
+
+/* Checks that an operand fits in the 16 bits of an instruction, i.e. that the program does not exceed the limits of the
+ * bytecode (eg. 65536 constants, functions or tlstruct definitions); otherwise the program is reported (once) as not
+ * supported, rather than being compiled with a truncated (and hence wrong) operand.
+ */
+void bytecode_compiler::check_operand(int operand, unsigned int line){
+    if((operand < 0 || operand > UINT16_MAX) && !operand_overflow){
+        operand_overflow = true;
+        unsupported(line, "instruction operand " + to_string(operand) + " (exceeding the 65536 constants, functions, "
+        "tlstruct definitions or members which may be indexed)");
+    }
+}
+
+// Appends an instruction to the function currently being compiled, returning its index (for back-patching jumps)
+int bytecode_compiler::emit(vm_opcode op, int a, int b, int c, unsigned int line, int name){
+    vm_function& func = program->functions[contexts.back().func];
+
+    check_operand(a, line);
+    check_operand(b, line);
+    check_operand(c, line);
+
+    func.code.push_back(vm_instruction{op, (uint16_t) a, (uint16_t) b, (uint16_t) c});
+    func.debug.push_back(vm_debug_info{line, name});
+
+    return (int) func.code.size() - 1;
+}
+
+// Sets the jump target of the jump instruction at index pc
+void bytecode_compiler::patch(int pc, int target){
+    program->functions[contexts.back().func].code[pc].set_target(target);
+}
+
+// Returns the index of the next instruction to be emitted
+int bytecode_compiler::here(){
+    return (int) program->functions[contexts.back().func].code.size();
+}
+
+/* Registers are allocated in a stack-like manner: variables are allocated a register upon declaration, which is released
+ * at the end of the enclosing block, whereas temporaries are released at the end of the enclosing statement. Hence the
+ * registers above next_reg are always free, which is what allows the frame of a callee to be placed at the top of the
+ * frame of the caller (see call()).
+ */
+int bytecode_compiler::alloc_reg(){
+    context& ctx = contexts.back();
+
+    if(ctx.next_reg == UINT16_MAX){
+        unsupported(0, "function " + program->functions[ctx.func].identifier + " requires too many registers");
+        return ctx.next_reg - 1;
+    }
+
+    int reg = ctx.next_reg++;
+    ctx.max_reg = max(ctx.max_reg, ctx.next_reg);
+
+    return reg;
+}
+
+void bytecode_compiler::free_regs(int mark){
+    contexts.back().next_reg = mark;
+}
+
+/* Compiles the expression rooted at node, returning the register holding the result. If target is not -1, the result is
+ * guaranteed to be placed in register target; otherwise the result is either placed in a new temporary or is the
+ * register of the variable being read (hence the result is only valid up till the next write to that variable).
+ */
+int bytecode_compiler::expression(astNode* node, int target){
+    int ref_target = target_reg;
+
+    target_reg = target;
+    node->accept(this);
+    target_reg = ref_target;
+
+    if(target != -1 && curr_reg != target){
+        emit(OP_MOV, target, curr_reg, 0, node->line);
+        curr_reg = target;
+    }
+
+    return curr_reg;
+}
+
+/* The expressions hoisted out of a loop (by the loop_hoister) are cached in registers allocated upon entering the loop,
+ * which are retained until the end of the loop: for each expression, a register holding its result is followed by a flag
+ * register, which is cleared on entering the loop and set once the expression is evaluated (see astHOISTED).
+ */
+void bytecode_compiler::begin_hoisted(int first, int n, unsigned int line){
+    vm_value unset{};
+    unset.b = false;
+
+    for(int slot = first; slot < first + n; slot++){
+        int reg = alloc_reg();
+        int flag = alloc_reg();
+
+        contexts.back().hoisted_regs[slot] = reg;
+        emit(OP_LOADK, flag, constant(unset), 0, line);
+    }
+}
+
+// Compiles a statement, releasing any temporaries; only declarations retain the register allocated to the variable
+void bytecode_compiler::statement(astNode* node){
+    int mark = contexts.back().next_reg;
+
+    target_reg = -1;
+    node->accept(this);
+
+    if(dynamic_cast<astVAR_DECL*>(node) == nullptr && dynamic_cast<astARR_DECL*>(node) == nullptr){
+        free_regs(mark);
+    }
+}
+
+// Returns the index in the constant pool of the specified value, adding it to the constant pool if need be
+int bytecode_compiler::constant(vm_value value){
+    uint64_t key = 0;
+    memcpy(&key, &value, sizeof(vm_value));
+
+    auto it = constant_ids.find(key);
+    if(it != constant_ids.end()){
+        return it->second;
+    }
+
+    program->constants.push_back(value);
+    constant_ids[key] = (int) program->constants.size() - 1;
+
+    return (int) program->constants.size() - 1;
+}
+
+int bytecode_compiler::string_constant(const string& str){
+    auto it = string_ids.find(str);
+    if(it != string_ids.end()){
+        return it->second;
+    }
+
+    program->string_constants.emplace_back(str);
+
+    vm_value value{};
+    value.s = &program->string_constants.back();
+    program->string_constant_ids.push_back((uint32_t) program->constants.size());
+    program->constants.push_back(value);
+    string_ids[str] = (int) program->constants.size() - 1;
+
+    return (int) program->constants.size() - 1;
+}
+
+int bytecode_compiler::name_index(const string& name){
+    auto it = names.find(name);
+    if(it != names.end()){
+        return it->second;
+    }
+
+    program->names.push_back(name);
+    names[name] = (int) program->names.size() - 1;
+
+    return (int) program->names.size() - 1;
+}
+
+void bytecode_compiler::unsupported(unsigned int line, const string& reason){
+    err_count++;
+    std::cerr << "ln " << line << ": " << reason << " is not supported by the bytecode compiler" << std::endl;
+}
+
+// ----- SCOPING UTILITY FUNCTIONS -----
+
+// Finds the entry with the matching identifier in the innermost scope declaring it, returning nullptr if not found
+bytecode_compiler::entry* bytecode_compiler::lookup(const string& identifier){
+    for(auto scope = scopes.rbegin(); scope != scopes.rend(); scope++){
+        auto it = scope->find(identifier);
+
+        if(it != scope->end()){
+            return &it->second;
+        }
+    }
+
+    return nullptr;
+}
+
+// Returns the layout of the tlstruct named type, -1 if not found
+int bytecode_compiler::layout_of(const type_t& type, unsigned int line){
+    entry* e = lookup(type.second);
+
+    if(e == nullptr || e->kind != STRUCT){
+        unsupported(line, "tlstruct " + type.second + " outside of its scope");
+        return -1;
+    }
+
+    return e->layout;
+}
+
+/* Emits code reading the variable (or member) specified by the entry, returning the register holding the value (as per
+ * expression()). The type and object class of the variable are set as the type of the current expression.
+ */
+int bytecode_compiler::read_entry(entry* e, int target, unsigned int line){
+    context& ctx = contexts.back();
+    int dst = e->index;
+
+    curr_type = e->info->type;
+    curr_obj_class = e->info->obj_class;
+
+    if(e->kind == LOCAL && e->func == ctx.func){ // local variable, held in a register of the current frame
+        if(target != -1 && target != dst){
+            emit(OP_MOV, target, dst, 0, line);
+            dst = target;
+        }
+    }
+    else if(e->kind == LOCAL && e->func == 0){ // global variable, held in a register of the main frame
+        dst = (target != -1) ? target : alloc_reg();
+        emit(OP_LOADG, dst, e->index, 0, line);
+    }
+    else if(e->kind == FIELD && e->layout == ctx.self_layout){ // member of the tlstruct instance held in register 0
+        dst = (target != -1) ? target : alloc_reg();
+        emit(OP_LOADF, dst, 0, e->index, line);
+    }
+    else{
+        unsupported(line, "access to a variable local to an enclosing function");
+        dst = (target != -1) ? target : alloc_reg();
+    }
+
+    return dst;
+}
+
+// Emits code writing the value held in register src to the variable (or member) specified by the entry
+void bytecode_compiler::write_entry(entry* e, int src, unsigned int line){
+    context& ctx = contexts.back();
+
+    if(e->kind == LOCAL && e->func == ctx.func){
+        if(src != e->index){
+            emit(OP_MOV, e->index, src, 0, line);
+        }
+    }
+    else if(e->kind == LOCAL && e->func == 0){
+        emit(OP_STOREG, e->index, src, 0, line);
+    }
+    else if(e->kind == FIELD && e->layout == ctx.self_layout){
+        emit(OP_STOREF, 0, e->index, src, line);
+    }
+    else{
+        unsupported(line, "access to a variable local to an enclosing function");
+    }
+}
+
+// Returns true if declarations in the current scope are members of a tlstruct, i.e. we are in a tlstruct definition block
+bool bytecode_compiler::declaring_member(){
+    return tls_top_scope != -1 && tls_top_scope == (int) scopes.size() - 1;
+}
+
+/* Adds a variable to the current scope, where reg is the register holding its value. For a member of a tlstruct, the
+ * value is stored at the next offset of the instance being initialised, else reg is bound to the variable.
+ */
+void bytecode_compiler::declare(const string& identifier, int reg, const type_t& type, grammarDFA::Symbol obj_class,
+                                unsigned int line){
+    context& ctx = contexts.back();
+    auto* info = new var_info{type, obj_class};
+
+    if(declaring_member()){
+        layout_info& layout = layouts[ctx.self_layout];
+        entry member{FIELD, ctx.func, (int) layout.fields.size(), ctx.self_layout, info};
+
+        emit(OP_STOREF, 0, member.index, reg, line);
+        layout.fields[identifier] = member;
+        scopes.back()[identifier] = member;
+    }
+    else{
+        scopes.back()[identifier] = entry{LOCAL, ctx.func, reg, -1, info};
+    }
+}
+
+// Emits code setting a register to the default value of the specified type, returning the register
+int bytecode_compiler::default_value(const type_t& type, int target, unsigned int line){
+    if(type.first == grammarDFA::T_TLSTRUCT){
+        return instantiate(type.second, target, line);
+    }
+
+    int dst = (target != -1) ? target : alloc_reg();
+
+    if(type.first == grammarDFA::T_STRING){ // default: ""
+        emit(OP_LOADK, dst, string_constant(""), 0, line);
+    }
+    else{ // default: false, 0, 0.0 or '\0', all of which are represented by a zeroed register
+        emit(OP_LOADK, dst, constant(vm_value{}), 0, line);
+    }
+
+    return dst;
+}
+
+/* Emits code creating a new instance of the tlstruct named type, which is then initialised by calling the initialisation
+ * function associated with its layout (which evaluates the member declarations in the tlstruct definition block).
+ */
+int bytecode_compiler::instantiate(const string& tls_name, int target, unsigned int line){
+    int layout = layout_of(type_t(grammarDFA::T_TLSTRUCT, tls_name), line);
+    int base = alloc_reg();
+
+    if(layout != -1){
+        emit(OP_NEWSTRUCT, base, layout, 0, line);
+        emit(OP_CALL, base, program->layouts[layout].init_func, 0, line);
+    }
+
+    if(target != -1 && target != base){
+        emit(OP_MOV, target, base, 0, line);
+        free_regs(base);
+
+        return target;
+    }
+
+    return base;
+}
+
+/* Emits code calling the function bound to the astFUNC_CALL node during semantic analysis. The frame of the callee is
+ * placed at the top of the frame of the caller, i.e. at the next free register (base), with the actual parameters
+ * evaluated in place into the registers base, base+1, ... which thus double as the formal parameters of the callee.
+ * For member functions, the tlstruct instance on which the function is invoked (receiver, or else the instance on which
+ * the calling member function was invoked) is passed in register base. The result is returned in register base.
+ */
+int bytecode_compiler::call(astFUNC_CALL* node, entry* receiver, int target){
+    context& ctx = contexts.back();
+    funcSymbol* callee = node->callee;
+
+    auto func = (callee != nullptr) ? functions.find(callee->func_ref) : functions.end();
+    if(func == functions.end()){
+        unsupported(node->line, "call to a function declared outside of its scope");
+        return (target != -1) ? target : alloc_reg();
+    }
+
+    int base = ctx.next_reg;
+
+    if(func->second.layout != -1){ // member function
+        int self = alloc_reg();
+
+        if(receiver != nullptr){
+            read_entry(receiver, self, node->line);
+        }
+        else if(ctx.self_layout == func->second.layout){
+            emit(OP_MOV, self, 0, 0, node->line);
+        }
+        else{
+            unsupported(node->line, "call to member function " + callee->identifier + " outside of a tlstruct instance");
+        }
+    }
+
+    if(node->aparams() != nullptr){
+        for(auto &c : ((astAPARAMS*) node->aparams())->children){
+            int reg = alloc_reg();
+            expression(c, reg);
+            free_regs(reg + 1);
+        }
+    }
+
+    if(contexts.back().next_reg == base){ // ensure a register is allocated for the result
+        alloc_reg();
+    }
+
+    emit(OP_CALL, base, func->second.func, 0, node->line);
+    free_regs(base + 1);
+
+    curr_type = callee->type;
+    curr_obj_class = callee->ret_obj_class;
+
+    if(target != -1 && target != base){
+        emit(OP_MOV, target, base, 0, node->line);
+        free_regs(base);
+
+        return target;
+    }
+
+    return base;
+}
+
+// Sets up the compilation of a new function, returning its index
+int bytecode_compiler::begin_function(const string& identifier, int self_layout){
+    int func = (int) program->functions.size();
+    int n_regs = (self_layout != -1) ? 1 : 0; // register 0 holds the tlstruct instance for member functions
+
+    program->functions.push_back(vm_function{identifier, (uint16_t) n_regs, (uint16_t) n_regs, {}, {}});
+    contexts.push_back(context{func, n_regs, n_regs, self_layout});
+
+    return func;
+}
+
+void bytecode_compiler::end_function(){
+    program->functions[contexts.back().func].n_regs = (uint16_t) contexts.back().max_reg;
+    contexts.pop_back();
+}
+
+// Returns true if the AST subtree rooted at node contains a function call (i.e. evaluating it may have side effects)
+bool bytecode_compiler::has_call(astNode* node){
+    if(node == nullptr){
+        return false;
+    }
+    else if(dynamic_cast<astFUNC_CALL*>(node) != nullptr){
+        return true;
+    }
+
+    auto* inner = dynamic_cast<astInnerNode*>(node);
+    if(inner != nullptr){
+        for(auto &c : inner->children){
+            if(has_call(c)){
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+vm_type bytecode_compiler::type_tag(const type_t& type){
+    switch(type.first){
+        case grammarDFA::T_BOOL: return VT_BOOL;
+        case grammarDFA::T_INT: return VT_INT;
+        case grammarDFA::T_FLOAT: return VT_FLOAT;
+        case grammarDFA::T_CHAR: return VT_CHAR;
+        case grammarDFA::T_STRING: return VT_STRING;
+        default: return VT_STRUCT;
+    }
+}
+
+// Selects the typed opcode for a multiplicative or additive operation, OP_HALT if the operation is not defined on the type
+vm_opcode bytecode_compiler::scalar_binop(const string& op, grammarDFA::Symbol type){
+    if(op == "and"){ return OP_AND;}
+    else if(op == "or"){ return OP_OR;}
+
+    switch(type){
+        case grammarDFA::T_INT:
+            if(op == "*"){ return OP_MUL_I32;}
+            else if(op == "/"){ return OP_DIV_I32;}
+            else if(op == "+"){ return OP_ADD_I32;}
+            else{ return OP_SUB_I32;}
+        case grammarDFA::T_FLOAT:
+            if(op == "*"){ return OP_MUL_F32;}
+            else if(op == "/"){ return OP_DIV_F32;}
+            else if(op == "+"){ return OP_ADD_F32;}
+            else{ return OP_SUB_F32;}
+        case grammarDFA::T_CHAR:
+            if(op == "+"){ return OP_ADD_C8;}
+            else if(op == "-"){ return OP_SUB_C8;}
+            else{ return OP_HALT;}
+        case grammarDFA::T_STRING:
+            return (op == "+") ? OP_ADD_STR : OP_HALT;
+        default:
+            return OP_HALT;
+    }
+}
+
+// Selects the typed opcode for a relational operation, OP_HALT if the operation is not defined on the type
+vm_opcode bytecode_compiler::scalar_relop(const string& op, grammarDFA::Symbol type){
+    int offset;
+
+    if(op == "=="){ offset = 0;}
+    else if(op == "!="){ offset = 1;}
+    else if(op == "<"){ offset = 2;}
+    else if(op == "<="){ offset = 3;}
+    else if(op == ">"){ offset = 4;}
+    else{ offset = 5;}
+
+    // the relational opcodes of each type are laid out in the same order as offset
+    switch(type){
+        case grammarDFA::T_INT: return (vm_opcode) (OP_EQ_I32 + offset);
+        case grammarDFA::T_FLOAT: return (vm_opcode) (OP_EQ_F32 + offset);
+        case grammarDFA::T_CHAR: return (vm_opcode) (OP_EQ_C8 + offset);
+        case grammarDFA::T_BOOL: return (vm_opcode) (OP_EQ_B + offset);
+        case grammarDFA::T_STRING: return (vm_opcode) (OP_EQ_STR + offset);
+        default: return OP_HALT;
+    }
+}
+
+/* Compiles a binary operation. As in the interpreter, the operation (and hence the opcode) is determined from the type
+ * and object class of the second operand; if an array, the scalar operation is applied element-wise.
+ */
+void bytecode_compiler::binary_operation(astBinaryOp* node, bool relational){
+    int dst = target_reg;
+    int mark = contexts.back().next_reg;
+
+    // if evaluating the second operand may have side effects, the value of the first operand must be maintained in a
+    // temporary (rather than read from the register of a variable which might be written in the meantime)
+    int op1 = expression(node->operand1(), has_call(node->operand2()) ? alloc_reg() : -1);
+    type_t op1_type = curr_type;
+
+    int op2 = expression(node->operand2(), -1);
+    type_t type = (curr_type.first != grammarDFA::T_AUTO) ? curr_type : op1_type;
+    grammarDFA::Symbol obj_class = curr_obj_class;
+
+    free_regs(mark);
+    if(dst == -1){ dst = alloc_reg();}
+
+    vm_opcode op = relational ? scalar_relop(node->op, type.first) : scalar_binop(node->op, type.first);
+    if(op == OP_HALT){
+        unsupported(node->line, "binary operation " + node->op + " on type " + type.second);
+    }
+
+    if(obj_class == grammarDFA::ARRAY){
+        emit(OP_ARR_BINOP, dst, op1, op2, node->line);
+        emit(op, 0, 0, 0, node->line);
+    }
+    else{
+        emit(op, dst, op1, op2, node->line);
+    }
+
+    curr_reg = dst;
+    curr_type = relational ? type_t(grammarDFA::T_BOOL, "bool") : type;
+    curr_obj_class = obj_class;
+}
+
+// ----- BYTECODE COMPILER VISITOR RULES -----
+
+void bytecode_compiler::visit(astTYPE* node){}
+
+void bytecode_compiler::visit(astLITERAL* node){
+    vm_value value{};
+    int k;
+
+    curr_obj_class = grammarDFA::SINGLETON;
+    curr_type = type_t(node->type, node->type_str);
+
+    // literals are decoded by the constant_folder, and added to the constant pool
+    switch(node->type){
+        case grammarDFA::T_BOOL: value.b = node->constant.b; k = constant(value); break;
+        case grammarDFA::T_INT: value.i = node->constant.i; k = constant(value); break;
+        case grammarDFA::T_FLOAT: value.f = node->constant.f; k = constant(value); break;
+        case grammarDFA::T_CHAR: value.c = node->constant.c; k = constant(value); break;
+        default: k = string_constant(node->constant.str());
+    }
+
+    curr_reg = (target_reg != -1) ? target_reg : alloc_reg();
+    emit(OP_LOADK, curr_reg, k, 0, node->line);
+}
+
+// only called when the identifier refers to an operand standing for a variable
+void bytecode_compiler::visit(astIDENTIFIER* node){
+    entry* e = lookup(node->lexeme);
+
+    if(e == nullptr || e->kind == STRUCT){
+        unsupported(node->line, "identifier " + node->lexeme + " outside of its scope");
+        curr_reg = (target_reg != -1) ? target_reg : alloc_reg();
+        return;
+    }
+
+    curr_reg = read_entry(e, target_reg, node->line);
+}
+
+// only called when the identifier refers to an operand standing for an array element
+void bytecode_compiler::visit(astELEMENT* node){
+    string arr_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    entry* e = lookup(arr_ident);
+    int dst = target_reg;
+    int mark = contexts.back().next_reg;
+
+    if(e == nullptr || e->kind == STRUCT){
+        unsupported(node->line, "array " + arr_ident + " outside of its scope");
+        curr_reg = (dst != -1) ? dst : alloc_reg();
+        return;
+    }
+
+    // as in the interpreter, the index is evaluated before the array is read
+    int index = expression(node->index(), -1);
+    int arr = read_entry(e, -1, node->line);
+
+    free_regs(mark);
+    if(dst == -1){ dst = alloc_reg();}
+
+    emit(OP_ALOAD, dst, arr, index, node->line, name_index(arr_ident));
+
+    curr_reg = dst;
+    curr_type = e->info->type;
+    curr_obj_class = grammarDFA::SINGLETON; // since we do not support multi-dim arrays, element is always SINGLETON
+}
+
+void bytecode_compiler::visit(astMULTOP* node){
+    binary_operation(node, false);
+}
+
+void bytecode_compiler::visit(astADDOP* node){
+    binary_operation(node, false);
+}
+
+void bytecode_compiler::visit(astRELOP* node){
+    binary_operation(node, true);
+}
+
+void bytecode_compiler::visit(astAPARAMS* node){} // actual parameters are compiled in place by call()
+
+void bytecode_compiler::visit(astFUNC_CALL* node){
+    curr_reg = call(node, nullptr, target_reg);
+}
+
+void bytecode_compiler::visit(astSUBEXPR* node){
+    curr_reg = expression(node->subexpr(), target_reg);
+}
+
+void bytecode_compiler::visit(astUNARY* node){
+    int dst = target_reg;
+    int mark = contexts.back().next_reg;
+    int operand = expression(node->operand(), -1);
+    vm_opcode op = OP_NOT;
+
+    if(node->op == "-"){
+        if(curr_type.first == grammarDFA::T_INT){ op = OP_NEG_I32;}
+        else if(curr_type.first == grammarDFA::T_FLOAT){ op = OP_NEG_F32;}
+        else{ unsupported(node->line, "unary operation - on type " + curr_type.second);}
+    }
+
+    free_regs(mark);
+    if(dst == -1){ dst = alloc_reg();}
+
+    if(curr_obj_class == grammarDFA::ARRAY){
+        emit(OP_ARR_UNOP, dst, operand, 0, node->line);
+        emit(op, 0, 0, 0, node->line);
+    }
+    else{
+        emit(op, dst, operand, 0, node->line);
+    }
+
+    curr_reg = dst;
+}
+
+void bytecode_compiler::visit(astASSIGNMENT_IDENTIFIER* node){
+    string ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    entry* e = lookup(ident);
+
+    if(e == nullptr || e->kind == STRUCT){
+        unsupported(node->line, "identifier " + ident + " outside of its scope");
+        return;
+    }
+
+    int src;
+    if(e->kind == LOCAL && e->func == contexts.back().func && e->info->obj_class != grammarDFA::ARRAY){
+        src = expression(node->expression(), e->index); // evaluate directly into the register of the variable
+    }
+    else{
+        src = expression(node->expression(), -1);
+    }
+
+    // if type associated with the variable is anonymous, set to type of the expression
+    if(e->info->type.first == grammarDFA::T_AUTO){
+        e->info->type = curr_type;
+    }
+
+    // the size of an array cannot change; check that the sizes of the arrays match
+    if(curr_obj_class == grammarDFA::ARRAY){
+        int old = read_entry(e, -1, node->line);
+        emit(OP_ACHKSIZE, src, old, 0, node->line);
+    }
+
+    write_entry(e, src, node->line);
+}
+
+void bytecode_compiler::visit(astASSIGNMENT_ELEMENT* node){
+    string arr_ident = ((astIDENTIFIER*) ((astELEMENT*) node->element())->identifier())->lexeme;
+    entry* e = lookup(arr_ident);
+
+    if(e == nullptr || e->kind == STRUCT){
+        unsupported(node->line, "array " + arr_ident + " outside of its scope");
+        return;
+    }
+
+    astNode* index_node = ((astELEMENT*) node->element())->index();
+    int index = expression(index_node, has_call(node->expression()) ? alloc_reg() : -1);
+    int src = expression(node->expression(), -1);
+
+    if(e->info->type.first == grammarDFA::T_AUTO){
+        e->info->type = curr_type;
+    }
+
+    int arr = read_entry(e, -1, node->line);
+    emit(OP_ASTORE, arr, index, src, node->line, name_index(arr_ident));
+}
+
+void bytecode_compiler::visit(astASSIGNMENT_MEMBER* node){
+    string tls_ident = ((astIDENTIFIER*) node->tls_name())->lexeme;
+    entry* tls = lookup(tls_ident);
+
+    if(tls == nullptr || tls->kind == STRUCT){
+        unsupported(node->line, "identifier " + tls_ident + " outside of its scope");
+        return;
+    }
+
+    int layout = layout_of(tls->info->type, node->line);
+    if(layout == -1){ return;}
+
+    auto* assignment = dynamic_cast<astASSIGNMENT_IDENTIFIER*>(node->assignment());
+
+    if(assignment != nullptr){ // assignment of a member
+        string member_ident = ((astIDENTIFIER*) assignment->identifier())->lexeme;
+        entry& member = layouts[layout].fields.at(member_ident);
+
+        int src = expression(assignment->expression(), -1);
+        if(member.info->type.first == grammarDFA::T_AUTO){
+            member.info->type = curr_type;
+        }
+
+        int instance = read_entry(tls, -1, node->line);
+
+        if(curr_obj_class == grammarDFA::ARRAY){
+            int old = alloc_reg();
+            emit(OP_LOADF, old, instance, member.index, node->line);
+            emit(OP_ACHKSIZE, src, old, 0, node->line);
+        }
+
+        emit(OP_STOREF, instance, member.index, src, node->line);
+    }
+    else{ // assignment of an element of a member array
+        auto* element_assignment = (astASSIGNMENT_ELEMENT*) node->assignment();
+        auto* element = (astELEMENT*) element_assignment->element();
+        string member_ident = ((astIDENTIFIER*) element->identifier())->lexeme;
+        entry& member = layouts[layout].fields.at(member_ident);
+
+        int index = expression(element->index(), has_call(element_assignment->expression()) ? alloc_reg() : -1);
+        int src = expression(element_assignment->expression(), -1);
+        if(member.info->type.first == grammarDFA::T_AUTO){
+            member.info->type = curr_type;
+        }
+
+        int instance = read_entry(tls, -1, node->line);
+        int arr = alloc_reg();
+
+        emit(OP_LOADF, arr, instance, member.index, node->line);
+        emit(OP_ASTORE, arr, index, src, node->line, name_index(member_ident));
+    }
+}
+
+void bytecode_compiler::visit(astVAR_DECL* node){
+    string var_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    type_t var_type(((astTYPE*) node->type())->type, ((astTYPE*) node->type())->lexeme);
+
+    int mark = contexts.back().next_reg;
+    int reg = declaring_member() ? -1 : alloc_reg(); // members are stored in the instance rather than a register
+
+    if(node->expression() != nullptr){
+        reg = expression(node->expression(), reg);
+
+        // if type associated with definition is anonymous, set to type of the expression
+        if(var_type.first == grammarDFA::T_AUTO){
+            var_type = curr_type;
+        }
+    }
+    else{
+        reg = default_value(var_type, reg, node->line);
+    }
+
+    declare(var_ident, reg, var_type, grammarDFA::SINGLETON, node->line);
+    free_regs(declaring_member() ? mark : reg + 1);
+}
+
+void bytecode_compiler::visit(astARR_DECL* node){
+    string arr_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    type_t arr_type(((astTYPE*) node->type())->type, ((astTYPE*) node->type())->lexeme);
+    int name = name_index(arr_ident);
+
+    int mark = contexts.back().next_reg;
+    int arr = alloc_reg();
+    int size = expression(node->size(), -1);
+
+    int n_assignment_elts = node->n_children - 3; // the number of elements being assigned (can be 0)
+    if(n_assignment_elts > UINT16_MAX){
+        unsupported(node->line, "initialisation of more than 65535 elements of array " + arr_ident);
+    }
+
+    // allocates the array, checking that the size is positive and at least the number of elements being assigned
+    emit(OP_NEWARR, arr, size, n_assignment_elts, node->line, name);
+
+    if(arr_type.first != grammarDFA::T_AUTO && n_assignment_elts == 0){
+        // elements of a new array are zeroed i.e. already hold the default value of bool, int, float and char types
+        if(arr_type.first == grammarDFA::T_STRING || arr_type.first == grammarDFA::T_TLSTRUCT){
+            // note that, as in the interpreter, a single default instance is shared by each element
+            int value = default_value(arr_type, -1, node->line);
+            emit(OP_AFILL, arr, value, 0, node->line);
+        }
+    }
+    else if(n_assignment_elts == 0){ // as in the interpreter, an unassigned anonymous array is filled with its size
+        emit(OP_AFILL, arr, size, 0, node->line);
+    }
+    else{
+        int value = size;
+
+        for(int i = 0; i < n_assignment_elts; i++){
+            free_regs(arr + 1);
+            value = expression(node->children.at(i + 3), -1);
+
+            // if type associated with definition is anonymous, set to type of the expression
+            if(arr_type.first == grammarDFA::T_AUTO){
+                arr_type = curr_type;
+            }
+
+            emit(OP_ASETI, arr, i, value, node->line);
+        }
+
+        // any elements not initialised are set to the value of the last initialised element
+        emit(OP_AFILL, arr, value, n_assignment_elts, node->line);
+    }
+
+    declare(arr_ident, arr, arr_type, grammarDFA::ARRAY, node->line);
+    free_regs(declaring_member() ? mark : arr + 1);
+}
+
+/* A tlstruct definition is compiled into a layout, along with an initialisation function (with the instance in register
+ * 0) comprising the statements in the definition block, where each top-level declaration defines a member. Member
+ * functions are compiled as functions which, likewise, take the instance on which they are invoked in register 0.
+ */
+void bytecode_compiler::visit(astTLS_DECL* node){
+    string tls_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+    int layout = (int) layouts.size();
+
+    layouts.emplace_back();
+    program->layouts.push_back(vm_layout{tls_ident, 0, 0});
+
+    int func = begin_function(tls_ident, layout);
+    program->layouts[layout].init_func = (uint16_t) func;
+    check_operand(func, node->line);
+
+    int ref_tls_top_scope = tls_top_scope;
+    scopes.emplace_back();
+    tls_top_scope = (int) scopes.size() - 1;
+
+    for(auto &c : ((astBLOCK*) node->tls_block())->children){
+        statement(c);
+    }
+
+    emit(OP_RET, 0, 0, 0, node->line); // returns the initialised instance
+    end_function();
+
+    scopes.pop_back();
+    tls_top_scope = ref_tls_top_scope;
+
+    program->layouts[layout].n_fields = (uint16_t) layouts[layout].fields.size();
+
+    // as in semantic analysis, the named type is only accessible after the definition
+    scopes.back()[tls_ident] = entry{STRUCT, contexts.back().func, -1, layout,
+                                     new var_info{type_t(grammarDFA::T_TLSTRUCT, tls_ident), grammarDFA::SINGLETON}};
+}
+
+void bytecode_compiler::visit(astPRINT* node){
+    int reg = expression(node->expression(), -1);
+
+    if(curr_type.first == grammarDFA::T_AUTO || curr_type.first == grammarDFA::T_TLSTRUCT){
+        unsupported(node->line, "print operation on type " + curr_type.second);
+    }
+
+    emit((curr_obj_class == grammarDFA::ARRAY) ? OP_PRINT_ARR : OP_PRINT, reg, type_tag(curr_type), 0, node->line);
+}
+
+void bytecode_compiler::visit(astRETURN* node){
+    int reg = expression(node->expression(), -1);
+    emit(OP_RET, reg, 0, 0, node->line);
+}
+
+void bytecode_compiler::visit(astIF* node){
+    int cond = expression(node->expression(), -1);
+    int jump_else = emit(OP_JMPF, cond, 0, 0, node->line);
+
+    statement(node->if_block());
+
+    if(node->else_block() != nullptr){
+        int jump_end = emit(OP_JMP, 0, 0, 0, node->line);
+
+        patch(jump_else, here());
+        statement(node->else_block());
+        patch(jump_end, here());
+    }
+    else{
+        patch(jump_else, here());
+    }
+}
+
+void bytecode_compiler::visit(astFOR* node){
+    int mark = contexts.back().next_reg;
+
+    // the optional declaration is accessible in the scope of the for-block
+    scopes.emplace_back();
+    if(node->decl() != nullptr){ statement(node->decl());}
+    begin_hoisted(node->hoisted_first, node->n_hoisted, node->line);
+
+    int loop = here();
+    int cond = expression(node->expression(), -1);
+    int jump_end = emit(OP_JMPF, cond, 0, 0, node->line);
+
+    statement(node->for_block());
+    if(node->assignment() != nullptr){ statement(node->assignment());}
+
+    patch(emit(OP_JMP, 0, 0, 0, node->line), loop);
+    patch(jump_end, here());
+
+    scopes.pop_back();
+    free_regs(mark);
+}
+
+// The virtual machine is single-threaded, and hence executes the iterations of a parallel for loop sequentially
+void bytecode_compiler::visit(astPAR_FOR* node){
+    visit((astFOR*) node);
+}
+
+void bytecode_compiler::visit(astWHILE* node){
+    int mark = contexts.back().next_reg;
+    begin_hoisted(node->hoisted_first, node->n_hoisted, node->line);
+
+    int loop = here();
+    int cond = expression(node->expression(), -1);
+    int jump_end = emit(OP_JMPF, cond, 0, 0, node->line);
+
+    if(node->while_block() != nullptr){ statement(node->while_block());}
+
+    patch(emit(OP_JMP, 0, 0, 0, node->line), loop);
+    patch(jump_end, here());
+
+    free_regs(mark);
+}
+
+void bytecode_compiler::visit(astFPARAMS* node){}
+void bytecode_compiler::visit(astFPARAM* node){}
+
+void bytecode_compiler::visit(astFUNC_DECL* node){
+    string func_ident = ((astIDENTIFIER*) node->identifier())->lexeme;
+
+    // a function declared at the top-level of a tlstruct definition block is a member function
+    int layout = declaring_member() ? contexts.back().self_layout : -1;
+    int func = begin_function(func_ident, layout);
+    functions[(astBLOCK*) node->function_block()] = func_info{func, layout};
+
+    // the formal parameters are held in the first registers of the frame (after the instance, for member functions)
+    scopes.emplace_back();
+    if(node->fparams() != nullptr){
+        for(auto &c : ((astFPARAMS*) node->fparams())->children){
+            string fparam_ident = ((astIDENTIFIER*) ((astFPARAM*) c)->identifier())->lexeme;
+            auto* fparam_type = (astTYPE*) ((astFPARAM*) c)->type();
+
+            declare(fparam_ident, alloc_reg(), type_t(fparam_type->type, fparam_type->lexeme), fparam_type->object_class,
+                    node->line);
+        }
+    }
+    program->functions[func].n_params = (uint16_t) contexts.back().next_reg;
+
+    for(auto &c : ((astBLOCK*) node->function_block())->children){
+        statement(c);
+    }
+    emit(OP_RET, 0, 0, 0, node->line); // unreachable, since semantic analysis checks that each function always returns
+
+    scopes.pop_back();
+    end_function();
+}
+
+void bytecode_compiler::visit(astMEMBER_ACCESS* node){
+    string tls_ident = ((astIDENTIFIER*) node->tls_name())->lexeme;
+    entry* tls = lookup(tls_ident);
+    int dst = target_reg;
+    int mark = contexts.back().next_reg;
+
+    if(tls == nullptr || tls->kind == STRUCT){
+        unsupported(node->line, "identifier " + tls_ident + " outside of its scope");
+        curr_reg = (dst != -1) ? dst : alloc_reg();
+        return;
+    }
+
+    int layout = layout_of(tls->info->type, node->line);
+    if(layout == -1){
+        curr_reg = (dst != -1) ? dst : alloc_reg();
+        return;
+    }
+
+    if(auto* func_call = dynamic_cast<astFUNC_CALL*>(node->member())){ // member function call
+        curr_reg = call(func_call, tls, dst);
+    }
+    else if(auto* element = dynamic_cast<astELEMENT*>(node->member())){ // element of a member array
+        string member_ident = ((astIDENTIFIER*) element->identifier())->lexeme;
+        entry& member = layouts[layout].fields.at(member_ident);
+
+        int index = expression(element->index(), -1);
+        int instance = read_entry(tls, -1, node->line);
+        int arr = alloc_reg();
+        emit(OP_LOADF, arr, instance, member.index, node->line);
+
+        free_regs(mark);
+        if(dst == -1){ dst = alloc_reg();}
+        emit(OP_ALOAD, dst, arr, index, node->line, name_index(member_ident));
+
+        curr_reg = dst;
+        curr_type = member.info->type;
+        curr_obj_class = grammarDFA::SINGLETON;
+    }
+    else{ // member
+        string member_ident = ((astIDENTIFIER*) node->member())->lexeme;
+        entry& member = layouts[layout].fields.at(member_ident);
+
+        int instance = read_entry(tls, -1, node->line);
+
+        free_regs(mark);
+        if(dst == -1){ dst = alloc_reg();}
+        emit(OP_LOADF, dst, instance, member.index, node->line);
+
+        curr_reg = dst;
+        curr_type = member.info->type;
+        curr_obj_class = member.info->obj_class;
+    }
+}
+
+void bytecode_compiler::visit(astBLOCK* node){
+    int mark = contexts.back().next_reg;
+
+    // maintain scoping: new scope for symbols within block, the registers of which are released on exiting the block
+    scopes.emplace_back();
+    for(auto &c : node->children){
+        statement(c);
+    }
+    scopes.pop_back();
+
+    free_regs(mark);
+}
+
+void bytecode_compiler::visit(astPROGRAM* node){
+    begin_function("main", -1); // function 0, the frame of which holds the global variables
+
+    for(auto &c : node->children){
+        statement(c);
+    }
+
+    emit(OP_HALT, 0, 0, 0, node->line);
+    end_function();
+}
+
+// A hoisted expression is evaluated (into its register) only if its flag register is not yet set since entering the loop
+void bytecode_compiler::visit(astHOISTED* node){
+    int reg = contexts.back().hoisted_regs.at(node->slot);
+    int jump_cached = emit(OP_JMPT, reg + 1, 0, 0, node->line);
+
+    expression(node->expression(), reg);
+
+    vm_value set{};
+    set.b = true;
+    emit(OP_LOADK, reg + 1, constant(set), 0, node->line);
+    patch(jump_cached, here());
+
+    curr_reg = reg;
+}
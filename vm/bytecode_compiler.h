@@ -0,0 +1,154 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_BYTECODE_COMPILER_H
+#define CPS2000_BYTECODE_COMPILER_H
+
+#include <unordered_map>
+#include "bytecode.h"
+#include "../symbol_table/symbol.h"
+#include "../visitor_ast/visitor.h"
+
+/* Lowers a (semantically checked) abstract syntax tree into a bytecode_program for execution on the virtual_machine.
+ *
+ * Identifiers are resolved at compile time to registers of the frame of the function being compiled, to registers of
+ * the global (main) frame, or to member offsets of the tlstruct instance on which a member function is invoked. Likewise
+ * each function call is bound to the function resolved during semantic analysis (see astFUNC_CALL::callee), and each
+ * operation is lowered to an opcode specialised on the type of its operands.
+ *
+ * Constructs which the bytecode backend does not support (eg. a nested function accessing a local variable of the
+ * enclosing function) are reported on stderr and counted in err_count, in which case the program should be run by the
+ * interpreter instead.
+ */
+class bytecode_compiler: public visitor{
+public:
+    void visit(astTYPE* node) override;
+    void visit(astLITERAL* node) override;
+    void visit(astIDENTIFIER* node) override;
+    void visit(astELEMENT* node) override;
+    void visit(astMULTOP* node) override;
+    void visit(astADDOP* node) override;
+    void visit(astRELOP* node) override;
+    void visit(astAPARAMS* node) override;
+    void visit(astFUNC_CALL* node) override;
+    void visit(astSUBEXPR* node) override;
+    void visit(astUNARY* node) override;
+    void visit(astASSIGNMENT_IDENTIFIER* node) override;
+    void visit(astASSIGNMENT_ELEMENT* node) override;
+    void visit(astASSIGNMENT_MEMBER* node) override;
+    void visit(astVAR_DECL* node) override;
+    void visit(astARR_DECL* node) override;
+    void visit(astTLS_DECL* node) override;
+    void visit(astPRINT* node) override;
+    void visit(astRETURN* node) override;
+    void visit(astIF* node) override;
+    void visit(astFOR* node) override;
+    void visit(astPAR_FOR* node) override;
+    void visit(astWHILE* node) override;
+    void visit(astFPARAMS* node) override;
+    void visit(astFPARAM* node) override;
+    void visit(astFUNC_DECL* node) override;
+    void visit(astMEMBER_ACCESS* node) override;
+    void visit(astBLOCK* node) override;
+    void visit(astPROGRAM* node) override;
+    void visit(astHOISTED* node) override;
+
+    bytecode_program* program = new bytecode_program;
+    int err_count = 0;
+
+private:
+    // Compile-time information on a variable (or tlstruct member); the type is updated as anonymous types are deduced
+    struct var_info{
+        type_t type;
+        grammarDFA::Symbol obj_class;
+    };
+
+    enum EntryKind{
+        LOCAL, FIELD, STRUCT
+    };
+
+    /* An entry in the compile-time scope table: a LOCAL is held in register 'index' of the frame of function 'func', a
+     * FIELD is the member at offset 'index' of a tlstruct instance with layout 'layout', and a STRUCT is the definition
+     * of the tlstruct named type with layout 'layout'.
+     */
+    struct entry{
+        EntryKind kind;
+        int func;
+        int index;
+        int layout;
+        var_info* info;
+    };
+
+    typedef unordered_map<string, entry> compile_scope;
+
+    // Maintains the state of the function currently being compiled
+    struct context{
+        int func;
+        int next_reg;
+        int max_reg;
+        int self_layout; // layout of the tlstruct instance held in register 0, or -1 if not a member function
+        unordered_map<int, int> hoisted_regs; // register caching each hoisted expression, by slot (see begin_hoisted)
+    };
+
+    struct func_info{
+        int func;
+        int layout; // layout of the tlstruct declaring the function, or -1 if not a member function
+    };
+
+    struct layout_info{
+        unordered_map<string, entry> fields;
+    };
+
+    vector<compile_scope> scopes = vector<compile_scope>(1);
+    vector<context> contexts;
+    unordered_map<astBLOCK*, func_info> functions;
+    vector<layout_info> layouts;
+    unordered_map<string, int> names;
+    unordered_map<uint64_t, int> constant_ids;
+    unordered_map<string, int> string_ids;
+    int tls_top_scope = -1; // scope index of the members of the tlstruct being declared, -1 if not in a tlstruct body
+    bool operand_overflow = false; // true once an operand exceeding 16 bits has been reported
+
+    // state of the expression being compiled
+    int target_reg = -1;
+    int curr_reg;
+    type_t curr_type;
+    grammarDFA::Symbol curr_obj_class;
+
+    void check_operand(int operand, unsigned int line);
+    int emit(vm_opcode op, int a, int b, int c, unsigned int line, int name = -1);
+    void patch(int pc, int target);
+    int here();
+
+    int alloc_reg();
+    void free_regs(int mark);
+    void begin_hoisted(int first, int n, unsigned int line);
+    int expression(astNode* node, int target);
+    void statement(astNode* node);
+    void binary_operation(astBinaryOp* node, bool relational);
+    int constant(vm_value value);
+    int string_constant(const string& str);
+    int name_index(const string& name);
+
+    entry* lookup(const string& identifier);
+    int layout_of(const type_t& type, unsigned int line);
+    int read_entry(entry* e, int target, unsigned int line);
+    void write_entry(entry* e, int src, unsigned int line);
+    bool declaring_member();
+    void declare(const string& identifier, int reg, const type_t& type, grammarDFA::Symbol obj_class,
+                 unsigned int line);
+    int default_value(const type_t& type, int target, unsigned int line);
+    int instantiate(const string& tls_name, int target, unsigned int line);
+    int call(astFUNC_CALL* node, entry* receiver, int target);
+    int begin_function(const string& identifier, int self_layout);
+    void end_function();
+    void unsupported(unsigned int line, const string& reason);
+
+    static bool has_call(astNode* node);
+    static vm_type type_tag(const type_t& type);
+    static vm_opcode scalar_binop(const string& op, grammarDFA::Symbol type);
+    static vm_opcode scalar_relop(const string& op, grammarDFA::Symbol type);
+};
+
+#endif //CPS2000_BYTECODE_COMPILER_H
@@ -0,0 +1,414 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "program_image.h"
+#include "build_id.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* The identifier of the build of the compiler (a hash of its sources, see cmake/build_id.cmake) forms part of the key of
+ * each image, such that images written by a build from different sources are never loaded, while builds from the same
+ * sources share them.
+ */
+static const char build_id[] = TEALANG_BUILD_ID;
+static const char image_magic[8] = {'T', 'L', 'G', 'I', 'M', 'G', '1', '\0'};
+
+struct image_header{
+    char magic[8];
+    uint64_t key;
+    uint64_t source_size;
+    uint64_t image_size;
+    uint64_t checksum; // of the payload, i.e. the bytes following the header
+    uint32_t n_functions;
+    uint32_t n_layouts;
+    uint32_t n_constants;
+    uint32_t n_string_constants;
+    uint32_t n_names;
+    uint32_t reserved;
+};
+
+struct image_function{
+    uint64_t code_offset;
+    uint64_t debug_offset;
+    uint32_t n_instructions;
+    uint16_t n_params;
+    uint16_t n_regs;
+};
+
+struct image_layout{
+    uint16_t n_fields;
+    uint16_t init_func;
+};
+
+// ----- UTILITY FUNCTIONS -----
+
+// 64-bit FNV-1a hash of a sequence of bytes, continuing from the hash specified
+static uint64_t fnv1a(const char* bytes, size_t n, uint64_t hash = 0xcbf29ce484222325ull){
+    for(size_t i = 0; i < n; i++){
+        hash ^= (unsigned char) bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+// Checksum of a sequence of bytes, hashing (as by fnv1a) a word of 8 bytes rather than a single byte at a time
+static uint64_t checksum(const char* bytes, size_t n){
+    uint64_t hash = 0xcbf29ce484222325ull;
+    size_t i = 0;
+
+    for(; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)){
+        uint64_t word;
+        memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3ull;
+    }
+
+    return fnv1a(bytes + i, n - i, hash);
+}
+
+static size_t align8(size_t offset){
+    return (offset + 7) & ~(size_t) 7;
+}
+
+// Appends the bytes of an object to the image being written, returning their offset
+template<typename T>
+static size_t append(vector<char>& image, const T* items, size_t n){
+    size_t offset = image.size();
+    image.insert(image.end(), (const char*) items, (const char*) (items + n));
+    return offset;
+}
+
+static void append_string(vector<char>& image, const string& str){
+    auto length = (uint32_t) str.size();
+    append(image, &length, 1);
+    append(image, str.data(), str.size());
+}
+
+static void pad(vector<char>& image){
+    image.resize(align8(image.size()), '\0');
+}
+
+// Reads a string from the image at the offset specified (advancing it), returning false if it lies out of bounds
+static bool read_string(const char* image, size_t size, size_t& offset, string& str){
+    uint32_t length;
+
+    if(offset + sizeof(length) > size){
+        return false;
+    }
+    memcpy(&length, image + offset, sizeof(length));
+    offset += sizeof(length);
+
+    if(length > size - offset){
+        return false;
+    }
+    str.assign(image + offset, length);
+    offset += length;
+
+    return true;
+}
+
+// Checks that an array of n instances of T at the offset specified lies within an image of the size specified
+template<typename T>
+static bool in_bounds(uint64_t offset, uint64_t n, size_t size){
+    return offset % alignof(T) == 0 && offset <= size && n <= (size - offset) / sizeof(T);
+}
+
+/* Checks the operands of each instruction of function f against the tables of the image, i.e. that registers lie within
+ * the frame of the function (or of the main program, for globals), that constants, functions and layouts exist, and that
+ * jumps land within the code, which must end in an instruction transferring control elsewhere. The debugging information
+ * must refer to existing names, as must that of instructions reporting errors on arrays. Offsets into arrays and
+ * tlstruct instances depend on the values held at run-time, and hence are checked (or guaranteed) as for a freshly
+ * compiled program.
+ */
+static bool check_code(const image_header& header, const image_function* functions, uint32_t f,
+                       const vm_instruction* code, const vm_debug_info* debug){
+    uint32_t n = functions[f].n_instructions;
+    uint16_t n_regs = functions[f].n_regs;
+    uint16_t n_globals = functions[0].n_regs;
+    auto reg = [n_regs](uint16_t r){ return r < n_regs;};
+
+    if(n == 0 || (code[n - 1].op != OP_HALT && code[n - 1].op != OP_RET && code[n - 1].op != OP_JMP)){
+        return false;
+    }
+
+    for(uint32_t pc = 0; pc < n; pc++){
+        const vm_instruction& in = code[pc];
+        bool valid;
+
+        switch(in.op){
+            case OP_HALT: valid = true; break;
+            case OP_MOV: case OP_NEG_I32: case OP_NEG_F32: case OP_NOT: case OP_ACHKSIZE:
+                valid = reg(in.a) && reg(in.b);
+                break;
+            case OP_LOADK: valid = reg(in.a) && in.b < header.n_constants; break;
+            case OP_LOADG: valid = reg(in.a) && in.b < n_globals; break;
+            case OP_STOREG: valid = in.a < n_globals && reg(in.b); break;
+
+            case OP_ARR_BINOP: // the following instruction must hold a scalar binary opcode
+                valid = reg(in.a) && reg(in.b) && reg(in.c) && pc + 1 < n && code[pc + 1].op >= OP_ADD_I32 &&
+                        code[pc + 1].op <= OP_GE_STR;
+                break;
+            case OP_ARR_UNOP: // the following instruction must hold a scalar unary opcode
+                valid = reg(in.a) && reg(in.b) && pc + 1 < n && code[pc + 1].op >= OP_NEG_I32 &&
+                        code[pc + 1].op <= OP_NOT;
+                break;
+            case OP_NEWARR: valid = reg(in.a) && reg(in.b) && debug[pc].name >= 0; break;
+            case OP_AFILL: valid = reg(in.a) && reg(in.b); break;
+            case OP_ASETI: valid = reg(in.a) && reg(in.c); break;
+            case OP_ALOAD: case OP_ASTORE:
+                valid = reg(in.a) && reg(in.b) && reg(in.c) && debug[pc].name >= 0;
+                break;
+
+            case OP_NEWSTRUCT: valid = reg(in.a) && in.b < header.n_layouts; break;
+            case OP_LOADF: valid = reg(in.a) && reg(in.b); break;
+            case OP_STOREF: valid = reg(in.a) && reg(in.c); break;
+
+            case OP_JMP: valid = in.target() < n; break;
+            case OP_JMPF: case OP_JMPT: valid = reg(in.a) && in.target() < n; break;
+
+            case OP_CALL: valid = reg(in.a) && in.b < header.n_functions; break;
+            case OP_RET: valid = f != 0 && reg(in.a); break; // the main program halts instead
+
+            case OP_PRINT: case OP_PRINT_ARR: valid = reg(in.a) && in.b <= VT_STRUCT; break;
+
+            default: // i.e. the scalar binary operations, otherwise not an opcode at all
+                valid = in.op >= OP_ADD_I32 && in.op <= OP_GE_STR && reg(in.a) && reg(in.b) && reg(in.c);
+        }
+
+        if(!valid || debug[pc].name < -1 || (debug[pc].name >= 0 && (uint32_t) debug[pc].name >= header.n_names)){
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// ----- KEYS AND PATHS -----
+
+uint64_t program_image::source_key(const string& source){
+    return fnv1a(source.data(), source.size(), fnv1a(build_id, sizeof(build_id) - 1));
+}
+
+string program_image::cache_path(const string& source_path){
+    const char* cache_dir = getenv("TEALANG_CACHE_DIR");
+
+    if(cache_dir == nullptr || *cache_dir == '\0'){
+        return source_path + "c";
+    }
+
+    // distinguish source files of the same name in different directories by the hash of their path
+    string filename = source_path.substr(source_path.find_last_of("\\/") + 1);
+    filename.erase(filename.rfind('.')); // i.e. the .tlg extension
+    char hash[17];
+    snprintf(hash, sizeof(hash), "%016llx", (unsigned long long) fnv1a(source_path.data(), source_path.size()));
+
+    return string(cache_dir) + "/" + filename + "." + hash + ".tlgc";
+}
+
+// ----- WRITING IMAGES -----
+
+bool program_image::store(const bytecode_program& program, uint64_t key, uint64_t source_size, const string& path){
+    vector<char> image(sizeof(image_header), '\0');
+
+    // the function table is filled in once the offsets of the code of each function are known
+    size_t functions_offset = image.size();
+    image.resize(functions_offset + program.functions.size() * sizeof(image_function), '\0');
+    pad(image);
+
+    for(const vm_layout& layout : program.layouts){
+        image_layout entry{layout.n_fields, layout.init_func};
+        append(image, &entry, 1);
+    }
+    pad(image);
+
+    // string constants hold pointers, which are replaced by the index of the string upon loading
+    append(image, program.constants.data(), program.constants.size());
+    append(image, program.string_constant_ids.data(), program.string_constant_ids.size());
+    pad(image);
+
+    for(const vm_string& str : program.string_constants){
+        append_string(image, string(str.view()));
+    }
+    for(const string& name : program.names){
+        append_string(image, name);
+    }
+    pad(image);
+
+    vector<image_function> functions;
+    for(const vm_function& func : program.functions){
+        image_function entry{};
+        entry.n_instructions = (uint32_t) func.code.size();
+        entry.n_params = func.n_params;
+        entry.n_regs = func.n_regs;
+
+        entry.code_offset = append(image, func.code.data(), func.code.size());
+        pad(image);
+        entry.debug_offset = append(image, func.debug.data(), func.debug.size());
+        pad(image);
+
+        functions.push_back(entry);
+    }
+    memcpy(image.data() + functions_offset, functions.data(), functions.size() * sizeof(image_function));
+
+    image_header header{};
+    memcpy(header.magic, image_magic, sizeof(image_magic));
+    header.key = key;
+    header.source_size = source_size;
+    header.image_size = image.size();
+    header.n_functions = (uint32_t) program.functions.size();
+    header.n_layouts = (uint32_t) program.layouts.size();
+    header.n_constants = (uint32_t) program.constants.size();
+    header.n_string_constants = (uint32_t) program.string_constants.size();
+    header.n_names = (uint32_t) program.names.size();
+    header.checksum = checksum(image.data() + sizeof(image_header), image.size() - sizeof(image_header));
+    memcpy(image.data(), &header, sizeof(header));
+
+    // write to a temporary file, and then atomically replace the existing image (if any)
+    string tmp_path = path + ".tmp" + to_string(getpid());
+    FILE* file = fopen(tmp_path.c_str(), "wb");
+    if(file == nullptr){
+        return false;
+    }
+
+    bool written = fwrite(image.data(), 1, image.size(), file) == image.size();
+    written = (fclose(file) == 0) && written;
+
+    if(!written || rename(tmp_path.c_str(), path.c_str()) != 0){
+        remove(tmp_path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+// ----- LOADING IMAGES -----
+
+program_image* program_image::load(const string& path, uint64_t key, uint64_t source_size){
+    int fd = open(path.c_str(), O_RDONLY);
+    if(fd < 0){
+        return nullptr;
+    }
+
+    struct stat st{};
+    if(fstat(fd, &st) != 0 || (size_t) st.st_size < sizeof(image_header)){
+        close(fd);
+        return nullptr;
+    }
+
+    auto size = (size_t) st.st_size;
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping remains valid once the file is closed
+
+    if(mapping == MAP_FAILED){
+        return nullptr;
+    }
+
+    auto* image = new program_image();
+    image->mapping = mapping;
+    image->mapping_size = size;
+
+    /* The image is validated once upon loading, such that a truncated or otherwise corrupt image is treated as a miss:
+     * the payload must match the checksum in the header, each section must lie within the image, and the operands of
+     * each instruction must be valid (see check_code). Hence the virtual machine executes a loaded image unchecked, as
+     * it does a freshly compiled program.
+     */
+    const char* bytes = (const char*) mapping;
+    const auto* header = (const image_header*) bytes;
+
+    if(memcmp(header->magic, image_magic, sizeof(image_magic)) != 0 || header->key != key ||
+       header->source_size != source_size || header->image_size != size || header->n_functions == 0 ||
+       header->checksum != checksum(bytes + sizeof(image_header), size - sizeof(image_header))){
+        delete image;
+        return nullptr;
+    }
+
+    size_t offset = sizeof(image_header);
+    const auto* functions = (const image_function*) (bytes + offset);
+    if(!in_bounds<image_function>(offset, header->n_functions, size)){
+        delete image;
+        return nullptr;
+    }
+    offset = align8(offset + header->n_functions * sizeof(image_function));
+
+    const auto* layouts = (const image_layout*) (bytes + offset);
+    if(!in_bounds<image_layout>(offset, header->n_layouts, size)){
+        delete image;
+        return nullptr;
+    }
+    offset = align8(offset + header->n_layouts * sizeof(image_layout));
+
+    const auto* constants = (const vm_value*) (bytes + offset);
+    if(!in_bounds<vm_value>(offset, header->n_constants, size)){
+        delete image;
+        return nullptr;
+    }
+    offset += header->n_constants * sizeof(vm_value);
+
+    const auto* string_constant_ids = (const uint32_t*) (bytes + offset);
+    if(!in_bounds<uint32_t>(offset, header->n_string_constants, size)){
+        delete image;
+        return nullptr;
+    }
+    offset = align8(offset + header->n_string_constants * sizeof(uint32_t));
+
+    // reconstruct the tables holding pointers or strings
+    bool valid = true;
+    for(uint32_t i = 0; i < header->n_layouts; i++){
+        valid = valid && layouts[i].init_func < header->n_functions;
+        image->layouts.push_back(vm_layout{"", layouts[i].n_fields, layouts[i].init_func});
+    }
+
+    image->constants.assign(constants, constants + header->n_constants);
+
+    for(uint32_t i = 0; i < header->n_string_constants && valid; i++){
+        string str;
+        valid = read_string(bytes, size, offset, str) && string_constant_ids[i] < header->n_constants;
+
+        if(valid){
+            image->string_constants.emplace_back(str);
+            image->constants[string_constant_ids[i]].s = &image->string_constants.back();
+        }
+    }
+    for(uint32_t i = 0; i < header->n_names && valid; i++){
+        string name;
+        valid = read_string(bytes, size, offset, name);
+        image->names.push_back(name);
+    }
+
+    // the code and debugging information of each function are executed in place from the mapping
+    for(uint32_t i = 0; i < header->n_functions && valid; i++){
+        const image_function& func = functions[i];
+        valid = in_bounds<vm_instruction>(func.code_offset, func.n_instructions, size) &&
+                in_bounds<vm_debug_info>(func.debug_offset, func.n_instructions, size) &&
+                check_code(*header, functions, i, (const vm_instruction*) (bytes + func.code_offset),
+                           (const vm_debug_info*) (bytes + func.debug_offset));
+
+        image->exe.functions.push_back(vm_routine{(const vm_instruction*) (bytes + func.code_offset),
+                                                  (const vm_debug_info*) (bytes + func.debug_offset),
+                                                  func.n_instructions, func.n_params, func.n_regs});
+    }
+
+    if(!valid){
+        delete image;
+        return nullptr;
+    }
+
+    image->exe.layouts = image->layouts.data();
+    image->exe.constants = image->constants.data();
+    image->exe.names = image->names.data();
+
+    return image;
+}
+
+program_image::~program_image(){
+    if(mapping != nullptr){
+        munmap(mapping, mapping_size);
+    }
+}
@@ -0,0 +1,67 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_PROGRAM_IMAGE_H
+#define CPS2000_PROGRAM_IMAGE_H
+
+#include <deque>
+#include <string>
+#include <vector>
+#include "bytecode.h"
+
+/* An on-disk cache of compiled programs, such that repeated runs of an unchanged source skip lexing, parsing, semantic
+ * analysis and bytecode compilation altogether.
+ *
+ * A compiled (and hence checked) bytecode_program is serialised into a flat image, keyed by a hash of the source and of
+ * the build of the compiler. On a later run, the image is memory mapped and executed in place: the instructions and the
+ * debugging information of each function (i.e. the bulk of the image) are referenced directly from the mapping, and
+ * only the small tables holding pointers or strings (the constants, names and layouts) are reconstructed upon loading.
+ *
+ * The image is laid out as follows, with each section aligned to 8 bytes:
+ *      header | functions | layouts | constants | string constant ids | strings | (code, debug info) per function
+ * where strings holds the string constants followed by the names, each as a 32-bit length followed by its characters.
+ * Values are stored in the native byte order, such that an image is only valid on the architecture which wrote it.
+ */
+class program_image{
+public:
+    program_image(const program_image&) = delete;
+    program_image& operator=(const program_image&) = delete;
+    ~program_image();
+
+    // hash of the source and of the build of the compiler, identifying the images valid for the source
+    static uint64_t source_key(const string& source);
+
+    /* The path of the image of the source file at the path specified: if the TEALANG_CACHE_DIR environment variable is
+     * set, images are kept in that directory (named after the file and a hash of its path), and otherwise next to the
+     * source file (with a .tlgc extension).
+     */
+    static string cache_path(const string& source_path);
+
+    /* Writes the image of a program to the path specified, returning false if it could not be written. The image is
+     * first written to a temporary file which then replaces any existing image, such that concurrent runs never observe
+     * a partially written image.
+     */
+    static bool store(const bytecode_program& program, uint64_t key, uint64_t source_size, const string& path);
+
+    // Maps the image at the path specified, returning nullptr if there is no valid image for the key and source size
+    static program_image* load(const string& path, uint64_t key, uint64_t source_size);
+
+    const vm_executable* executable() const{
+        return &exe;
+    }
+
+private:
+    program_image() = default;
+
+    void* mapping = nullptr;
+    size_t mapping_size = 0;
+
+    vector<vm_layout> layouts;
+    vector<vm_value> constants;
+    deque<vm_string> string_constants;
+    vector<string> names;
+    vm_executable exe;
+};
+
+#endif //CPS2000_PROGRAM_IMAGE_H
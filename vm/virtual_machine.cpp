@@ -0,0 +1,341 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "virtual_machine.h"
+
+// ----- RUN-TIME ERROR REPORTING UTILITY FUNCTIONS -----
+
+// Reports a run-time error raised by the instruction preceding pc, and terminates
+void virtual_machine::runtime_error(const vm_routine* func, uint32_t pc, const string& msg){
+    std::cerr << "ln " << func->debug[pc - 1].line << ": " << msg << std::endl;
+    throw std::runtime_error("Runtime errors encountered, see trace above.");
+}
+
+void virtual_machine::bounds_error(const vm_routine* func, uint32_t pc, int32_t index, int32_t size){
+    runtime_error(func, pc, "index " + to_string(index) + " is out of bounds of array " +
+                            program->names[func->debug[pc - 1].name] + " with size " + to_string(size));
+}
+
+// ----- UTILITY FUNCTIONS -----
+
+/* Collects the objects no longer reachable from the registers of the active frames, i.e. those below top, if due; called
+ * by each allocating instruction prior to allocating (such that any object in use is held by a register).
+ */
+void virtual_machine::collect_garbage(size_t top){
+    if(heap.due()){
+        heap.collect(registers.data(), top);
+    }
+}
+
+// Applies a scalar binary operation; used for the element-wise application of an operation over arrays
+vm_value virtual_machine::scalar_binop(vm_opcode op, vm_value x, vm_value y, const vm_routine* func, uint32_t pc){
+    vm_value r{};
+
+    switch(op){
+        case OP_ADD_I32: r.i = x.i + y.i; break;
+        case OP_SUB_I32: r.i = x.i - y.i; break;
+        case OP_MUL_I32: r.i = x.i * y.i; break;
+        case OP_DIV_I32:
+            if(y.i == 0){ runtime_error(func, pc, "division by zero encountered");}
+            r.i = x.i / y.i;
+            break;
+        case OP_ADD_F32: r.f = x.f + y.f; break;
+        case OP_SUB_F32: r.f = x.f - y.f; break;
+        case OP_MUL_F32: r.f = x.f * y.f; break;
+        case OP_DIV_F32:
+            if(y.f == 0){ runtime_error(func, pc, "division by zero encountered");}
+            r.f = x.f / y.f;
+            break;
+        case OP_ADD_C8: r.c = (char) (x.c + y.c); break;
+        case OP_SUB_C8: r.c = (char) (x.c - y.c); break;
+        case OP_ADD_STR: r.s = heap.concat(x.s, y.s); break;
+        case OP_AND: r.b = x.b && y.b; break;
+        case OP_OR: r.b = x.b || y.b; break;
+
+        case OP_EQ_I32: r.b = x.i == y.i; break;
+        case OP_NE_I32: r.b = x.i != y.i; break;
+        case OP_LT_I32: r.b = x.i < y.i; break;
+        case OP_LE_I32: r.b = x.i <= y.i; break;
+        case OP_GT_I32: r.b = x.i > y.i; break;
+        case OP_GE_I32: r.b = x.i >= y.i; break;
+        case OP_EQ_F32: r.b = x.f == y.f; break;
+        case OP_NE_F32: r.b = x.f != y.f; break;
+        case OP_LT_F32: r.b = x.f < y.f; break;
+        case OP_LE_F32: r.b = x.f <= y.f; break;
+        case OP_GT_F32: r.b = x.f > y.f; break;
+        case OP_GE_F32: r.b = x.f >= y.f; break;
+        case OP_EQ_C8: r.b = x.c == y.c; break;
+        case OP_NE_C8: r.b = x.c != y.c; break;
+        case OP_LT_C8: r.b = x.c < y.c; break;
+        case OP_LE_C8: r.b = x.c <= y.c; break;
+        case OP_GT_C8: r.b = x.c > y.c; break;
+        case OP_GE_C8: r.b = x.c >= y.c; break;
+        case OP_EQ_B: r.b = x.b == y.b; break;
+        case OP_NE_B: r.b = x.b != y.b; break;
+        case OP_LT_B: r.b = x.b < y.b; break;
+        case OP_LE_B: r.b = x.b <= y.b; break;
+        case OP_GT_B: r.b = x.b > y.b; break;
+        case OP_GE_B: r.b = x.b >= y.b; break;
+        case OP_EQ_STR: r.b = x.s->view() == y.s->view(); break;
+        case OP_NE_STR: r.b = x.s->view() != y.s->view(); break;
+        case OP_LT_STR: r.b = x.s->view() < y.s->view(); break;
+        case OP_LE_STR: r.b = x.s->view() <= y.s->view(); break;
+        case OP_GT_STR: r.b = x.s->view() > y.s->view(); break;
+        case OP_GE_STR: r.b = x.s->view() >= y.s->view(); break;
+        default: break;
+    }
+
+    return r;
+}
+
+// Applies a scalar unary operation; used for the element-wise application of an operation over arrays
+vm_value virtual_machine::scalar_unop(vm_opcode op, vm_value x){
+    vm_value r{};
+
+    switch(op){
+        case OP_NEG_I32: r.i = -1 * x.i; break;
+        case OP_NEG_F32: r.f = -1 * x.f; break;
+        case OP_NOT: r.b = !x.b; break;
+        default: break;
+    }
+
+    return r;
+}
+
+void virtual_machine::print_value(vm_value value, vm_type type){
+    switch(type){
+        case VT_BOOL: out->put_bool(value.b); break;
+        case VT_INT: out->put_int(value.i); break;
+        case VT_FLOAT: out->put_float(value.f); break;
+        case VT_CHAR: out->put_char(value.c); break;
+        default: out->put_string(value.s->chars->data(), value.s->length);
+    }
+}
+
+// ----- DISPATCH LOOP -----
+
+void virtual_machine::run(){
+    const vm_value* K = program->constants;
+    const vm_routine* func = &program->functions[0];
+    const vm_instruction* code = func->code;
+    uint32_t pc = 0;
+    size_t base = 0;
+
+    registers.assign(max<size_t>(func->n_regs, 1024), vm_value{});
+    frames.push_back(frame{0, 0, 0});
+
+    vm_value* G = registers.data(); // registers of the main frame, i.e. the global variables
+    vm_value* R = G + base; // registers of the current frame
+
+    while(true){
+        const vm_instruction& in = code[pc++];
+
+        switch(in.op){
+            case OP_HALT:
+                frames.clear();
+                return;
+
+            case OP_MOV: R[in.a] = R[in.b]; break;
+            case OP_LOADK: R[in.a] = K[in.b]; break;
+            case OP_LOADG: R[in.a] = G[in.b]; break;
+            case OP_STOREG: G[in.a] = R[in.b]; break;
+
+            case OP_ADD_I32: R[in.a].i = R[in.b].i + R[in.c].i; break;
+            case OP_SUB_I32: R[in.a].i = R[in.b].i - R[in.c].i; break;
+            case OP_MUL_I32: R[in.a].i = R[in.b].i * R[in.c].i; break;
+            case OP_DIV_I32:
+                if(R[in.c].i == 0){ runtime_error(func, pc, "division by zero encountered");}
+                R[in.a].i = R[in.b].i / R[in.c].i;
+                break;
+            case OP_ADD_F32: R[in.a].f = R[in.b].f + R[in.c].f; break;
+            case OP_SUB_F32: R[in.a].f = R[in.b].f - R[in.c].f; break;
+            case OP_MUL_F32: R[in.a].f = R[in.b].f * R[in.c].f; break;
+            case OP_DIV_F32:
+                if(R[in.c].f == 0){ runtime_error(func, pc, "division by zero encountered");}
+                R[in.a].f = R[in.b].f / R[in.c].f;
+                break;
+            case OP_ADD_C8: R[in.a].c = (char) (R[in.b].c + R[in.c].c); break;
+            case OP_SUB_C8: R[in.a].c = (char) (R[in.b].c - R[in.c].c); break;
+            case OP_ADD_STR:
+                collect_garbage(base + func->n_regs);
+                R[in.a].s = heap.concat(R[in.b].s, R[in.c].s);
+                break;
+            case OP_AND: R[in.a].b = R[in.b].b && R[in.c].b; break;
+            case OP_OR: R[in.a].b = R[in.b].b || R[in.c].b; break;
+
+            case OP_EQ_I32: R[in.a].b = R[in.b].i == R[in.c].i; break;
+            case OP_NE_I32: R[in.a].b = R[in.b].i != R[in.c].i; break;
+            case OP_LT_I32: R[in.a].b = R[in.b].i < R[in.c].i; break;
+            case OP_LE_I32: R[in.a].b = R[in.b].i <= R[in.c].i; break;
+            case OP_GT_I32: R[in.a].b = R[in.b].i > R[in.c].i; break;
+            case OP_GE_I32: R[in.a].b = R[in.b].i >= R[in.c].i; break;
+            case OP_EQ_F32: R[in.a].b = R[in.b].f == R[in.c].f; break;
+            case OP_NE_F32: R[in.a].b = R[in.b].f != R[in.c].f; break;
+            case OP_LT_F32: R[in.a].b = R[in.b].f < R[in.c].f; break;
+            case OP_LE_F32: R[in.a].b = R[in.b].f <= R[in.c].f; break;
+            case OP_GT_F32: R[in.a].b = R[in.b].f > R[in.c].f; break;
+            case OP_GE_F32: R[in.a].b = R[in.b].f >= R[in.c].f; break;
+
+            case OP_EQ_C8: case OP_NE_C8: case OP_LT_C8: case OP_LE_C8: case OP_GT_C8: case OP_GE_C8:
+            case OP_EQ_B: case OP_NE_B: case OP_LT_B: case OP_LE_B: case OP_GT_B: case OP_GE_B:
+            case OP_EQ_STR: case OP_NE_STR: case OP_LT_STR: case OP_LE_STR: case OP_GT_STR: case OP_GE_STR:
+                R[in.a] = scalar_binop(in.op, R[in.b], R[in.c], func, pc);
+                break;
+
+            case OP_NEG_I32: R[in.a].i = -1 * R[in.b].i; break;
+            case OP_NEG_F32: R[in.a].f = -1 * R[in.b].f; break;
+            case OP_NOT: R[in.a].b = !R[in.b].b; break;
+
+            case OP_ARR_BINOP:{
+                collect_garbage(base + func->n_regs);
+                vm_opcode op = code[pc++].op;
+                vm_array* x = R[in.b].a;
+                vm_array* y = R[in.c].a;
+
+                if(x->size != y->size){
+                    runtime_error(func, pc, "arrays have mismatched sizes " + to_string(x->size) + " and " +
+                                            to_string(y->size));
+                }
+
+                vm_array* result = heap.new_array(x->size);
+                for(int32_t i = 0; i < x->size; i++){
+                    result->data[i] = scalar_binop(op, x->data[i], y->data[i], func, pc);
+                }
+
+                R[in.a].a = result;
+                break;
+            }
+            case OP_ARR_UNOP:{
+                collect_garbage(base + func->n_regs);
+                vm_opcode op = code[pc++].op;
+                vm_array* x = R[in.b].a;
+
+                vm_array* result = heap.new_array(x->size);
+                for(int32_t i = 0; i < x->size; i++){
+                    result->data[i] = scalar_unop(op, x->data[i]);
+                }
+
+                R[in.a].a = result;
+                break;
+            }
+
+            case OP_NEWARR:{
+                int32_t size = R[in.b].i;
+                const string& name = program->names[func->debug[pc - 1].name];
+
+                if(size < 1){
+                    runtime_error(func, pc, "size of array " + name + " must be a positive integer");
+                }
+                if(size < in.c){
+                    runtime_error(func, pc, "cannot assign " + to_string(in.c) + " elements to array " + name +
+                                            " of size " + to_string(size));
+                }
+
+                collect_garbage(base + func->n_regs);
+                R[in.a].a = heap.new_array(size);
+                break;
+            }
+            case OP_AFILL:{
+                vm_array* arr = R[in.a].a;
+                for(int32_t i = in.c; i < arr->size; i++){
+                    arr->data[i] = R[in.b];
+                }
+                break;
+            }
+            case OP_ASETI: R[in.a].a->data[in.b] = R[in.c]; break;
+            case OP_ALOAD:{
+                vm_array* arr = R[in.b].a;
+                int32_t index = R[in.c].i;
+
+                if(index < 0 || index >= arr->size){ bounds_error(func, pc, index, arr->size);}
+
+                R[in.a] = arr->data[index];
+                break;
+            }
+            case OP_ASTORE:{
+                vm_array* arr = R[in.a].a;
+                int32_t index = R[in.b].i;
+
+                if(index < 0 || index >= arr->size){ bounds_error(func, pc, index, arr->size);}
+
+                arr->data[index] = R[in.c];
+                break;
+            }
+            case OP_ACHKSIZE:
+                if(R[in.a].a->size != R[in.b].a->size){
+                    runtime_error(func, pc, "arrays have mismatched sizes " + to_string(R[in.a].a->size) + " and " +
+                                            to_string(R[in.b].a->size));
+                }
+                break;
+
+            case OP_NEWSTRUCT:
+                collect_garbage(base + func->n_regs);
+                R[in.a].t = heap.new_struct(in.b, program->layouts[in.b].n_fields);
+                break;
+            case OP_LOADF: R[in.a] = R[in.b].t->fields[in.c]; break;
+            case OP_STOREF: R[in.a].t->fields[in.b] = R[in.c]; break;
+
+            case OP_JMP: pc = in.target(); break;
+            case OP_JMPF:
+                if(!R[in.a].b){ pc = in.target();}
+                break;
+            case OP_JMPT:
+                if(R[in.a].b){ pc = in.target();}
+                break;
+
+            case OP_CALL:{
+                if(frames.size() > max_depth){ // i.e. the number of active calls, excluding the main program
+                    runtime_error(func, pc, "maximum call depth of " + to_string(max_depth) + " exceeded");
+                }
+
+                frames.back().pc = pc;
+                base += in.a;
+                func = &program->functions[in.b];
+
+                // grow the register stack if need be, in which case the frame pointers must be updated
+                if(base + func->n_regs > registers.size()){
+                    registers.resize(max(base + func->n_regs, 2 * registers.size()), vm_value{});
+                    G = registers.data();
+                }
+
+                frames.push_back(frame{in.b, 0, base});
+                R = G + base;
+                code = func->code;
+                pc = 0;
+                break;
+            }
+            case OP_RET:{
+                R[0] = R[in.a]; // the result is returned in the register of the caller holding the first parameter
+                frames.pop_back();
+
+                const frame& caller = frames.back();
+                func = &program->functions[caller.func];
+                code = func->code;
+                pc = caller.pc;
+                base = caller.base;
+                R = G + base;
+                break;
+            }
+
+            case OP_PRINT:
+                print_value(R[in.a], (vm_type) in.b);
+                out->end_line();
+                break;
+            case OP_PRINT_ARR:{
+                vm_array* arr = R[in.a].a;
+
+                out->put_char('{');
+                for(int32_t i = 0; i < arr->size; i++){
+                    if(i != 0){
+                        out->put_string(", ", 2);
+                    }
+                    print_value(arr->data[i], (vm_type) in.b);
+                }
+                out->put_char('}');
+                out->end_line();
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,60 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_VIRTUAL_MACHINE_H
+#define CPS2000_VIRTUAL_MACHINE_H
+
+#include <iostream>
+#include "bytecode.h"
+#include "vm_heap.h"
+#include "../output_sink/output_sink.h"
+
+/* Executes a compiled program (see bytecode_compiler and vm_executable) on a register machine.
+ *
+ * The registers of all active function calls are held in a single contiguous stack of vm_value instances, where each
+ * call has a frame of n_regs registers starting at its base. The frame of a callee starts at the register of the caller
+ * holding the first actual parameter, such that parameters are passed without copying. Calls do not recurse on the C++
+ * stack; instead, the return address of each active call is maintained in an explicit stack of frames. Both stacks are
+ * heap-allocated and grow as required, hence the depth of recursion is only bounded by the maximum call depth specified
+ * (exceeding which is reported as a run-time error), rather than by the native stack.
+ *
+ * Strings, arrays and tlstruct instances are allocated from (and owned by) a garbage collected heap, see vm_heap.
+ *
+ * Run-time errors are reported in the same manner as the interpreter, using the line numbers and identifiers maintained
+ * in the debugging information of each function. Printed values are written to the output sink specified.
+ */
+class virtual_machine{
+public:
+    virtual_machine(const vm_executable* program, size_t max_depth, output_sink* out){
+        this->program = program;
+        this->max_depth = max_depth;
+        this->out = out;
+    }
+
+    void run();
+
+private:
+    struct frame{
+        uint32_t func;
+        uint32_t pc; // return address, i.e. the instruction following the call
+        size_t base;
+    };
+
+    const vm_executable* program;
+    size_t max_depth; // maximum number of active calls (and tlstruct instantiations)
+    output_sink* out;
+    vector<vm_value> registers;
+    vector<frame> frames;
+    vm_heap heap;
+
+    vm_value scalar_binop(vm_opcode op, vm_value x, vm_value y, const vm_routine* func, uint32_t pc);
+    static vm_value scalar_unop(vm_opcode op, vm_value x);
+    void print_value(vm_value value, vm_type type);
+    void collect_garbage(size_t top);
+
+    [[noreturn]] void runtime_error(const vm_routine* func, uint32_t pc, const string& msg);
+    [[noreturn]] void bounds_error(const vm_routine* func, uint32_t pc, int32_t index, int32_t size);
+};
+
+#endif //CPS2000_VIRTUAL_MACHINE_H
@@ -0,0 +1,147 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#include "vm_heap.h"
+
+#include <cstring>
+
+vm_heap::~vm_heap(){
+    for(vm_object* object : objects){
+        free(object);
+    }
+}
+
+// ----- ALLOCATION -----
+
+vm_string* vm_heap::concat(const vm_string* x, const vm_string* y){
+    vm_string* result;
+
+    // x is extended in place only if no other string extends it already, and y is not held by the same buffer
+    if(x->length == x->chars->size() && x->chars != y->chars){
+        x->chars->append(y->chars->data(), y->length);
+        result = new vm_string(x->chars, x->length + y->length);
+        track(result, sizeof(vm_string) + y->length);
+    }
+    else{
+        auto chars = make_shared<string>();
+        chars->reserve(x->length + y->length);
+        chars->append(x->chars->data(), x->length).append(y->chars->data(), y->length);
+
+        result = new vm_string(std::move(chars), x->length + y->length);
+        track(result, size_of(result));
+    }
+
+    return result;
+}
+
+vm_array* vm_heap::new_array(int32_t size){
+    auto* arr = new vm_array(size);
+    track(arr, size_of(arr));
+
+    return arr;
+}
+
+vm_struct* vm_heap::new_struct(int32_t layout, uint16_t n_fields){
+    auto* instance = new vm_struct(layout, n_fields);
+    track(instance, size_of(instance));
+
+    return instance;
+}
+
+void vm_heap::track(vm_object* object, size_t bytes){
+    objects.insert(object);
+    allocated += bytes;
+
+    lowest = min(lowest, (uintptr_t) object);
+    highest = max(highest, (uintptr_t) object);
+}
+
+// ----- COLLECTION -----
+
+void vm_heap::collect(const vm_value* roots, size_t n){
+    for(size_t i = 0; i < n; i++){
+        mark(roots[i]);
+    }
+
+    while(!pending.empty()){
+        vm_object* object = pending.back();
+        pending.pop_back();
+
+        if(object->kind == vm_object::ARRAY){
+            auto* arr = (vm_array*) object;
+            for(int32_t i = 0; i < arr->size; i++){ mark(arr->data[i]);}
+        }
+        else if(object->kind == vm_object::STRUCT){
+            auto* instance = (vm_struct*) object;
+            for(uint16_t i = 0; i < instance->n_fields; i++){ mark(instance->fields[i]);}
+        }
+    }
+
+    // sweep the objects which were not marked, clearing the marks of the rest for the next collection
+    live = 0;
+    for(auto it = objects.begin(); it != objects.end();){
+        vm_object* object = *it;
+
+        if(object->marked){
+            object->marked = false;
+            live += size_of(object);
+            it++;
+        }
+        else{
+            it = objects.erase(it);
+            free(object);
+        }
+    }
+
+    allocated = 0;
+}
+
+// Marks the object referenced by a value (if any), deferring the scanning of its elements or members
+void vm_heap::mark(vm_value value){
+    uintptr_t address;
+    memcpy(&address, &value, sizeof(address));
+
+    if(address < lowest || address > highest){
+        return;
+    }
+
+    auto it = objects.find((vm_object*) address);
+    if(it != objects.end() && !(*it)->marked){
+        (*it)->marked = true;
+
+        if((*it)->kind != vm_object::STRING){
+            pending.push_back(*it);
+        }
+    }
+}
+
+size_t vm_heap::size_of(const vm_object* object){
+    switch(object->kind){
+        case vm_object::STRING: return size_of((const vm_string*) object);
+        case vm_object::ARRAY: return size_of((const vm_array*) object);
+        case vm_object::STRUCT: return size_of((const vm_struct*) object);
+    }
+
+    return 0; // unreachable, since every kind of object is handled above
+}
+
+size_t vm_heap::size_of(const vm_string* str){
+    return sizeof(vm_string) + str->length;
+}
+
+size_t vm_heap::size_of(const vm_array* arr){
+    return sizeof(vm_array) + arr->size * sizeof(vm_value);
+}
+
+size_t vm_heap::size_of(const vm_struct* instance){
+    return sizeof(vm_struct) + instance->n_fields * sizeof(vm_value);
+}
+
+void vm_heap::free(vm_object* object){
+    switch(object->kind){
+        case vm_object::STRING: delete (vm_string*) object; break;
+        case vm_object::ARRAY: delete (vm_array*) object; break;
+        case vm_object::STRUCT: delete (vm_struct*) object; break;
+    }
+}
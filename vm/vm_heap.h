@@ -0,0 +1,62 @@
+//
+// Created by agent on 17/10/2026.
+//
+
+#ifndef CPS2000_VM_HEAP_H
+#define CPS2000_VM_HEAP_H
+
+#include <unordered_set>
+#include "bytecode.h"
+
+/* Owns the strings, arrays and tlstruct instances allocated by the virtual machine, freeing those no longer reachable by
+ * a mark and sweep collection, once the number of bytes allocated since the previous collection exceeds the number of
+ * bytes which survived it (and at least MIN_COLLECT_BYTES), such that the time spent collecting is proportional to the
+ * time spent allocating.
+ *
+ * Since registers are untagged (see vm_value), the collector cannot tell whether a register holds a reference; instead,
+ * the registers of the active frames (the roots), and the elements and members of each object reached, are scanned
+ * conservatively: any value which is the address of an object allocated by the heap is taken to reference it. Hence an
+ * object is never freed while reachable, although an integer (or stale register) may occasionally retain an object for
+ * longer than necessary. Collections only take place between instructions (see virtual_machine::run), such that every
+ * object in use is held by a register.
+ */
+class vm_heap{
+public:
+    static constexpr size_t MIN_COLLECT_BYTES = 1 << 20;
+
+    vm_heap() = default;
+    vm_heap(const vm_heap&) = delete;
+    vm_heap& operator=(const vm_heap&) = delete;
+    ~vm_heap();
+
+    // the concatenation of two strings, appending to the buffer of x in place if x is at its end (see vm_string)
+    vm_string* concat(const vm_string* x, const vm_string* y);
+
+    vm_array* new_array(int32_t size);
+    vm_struct* new_struct(int32_t layout, uint16_t n_fields);
+
+    // true if enough bytes have been allocated since the previous collection for another to take place
+    bool due() const{
+        return allocated >= max(MIN_COLLECT_BYTES, live);
+    }
+
+    // frees the objects which are not reachable from the n registers specified
+    void collect(const vm_value* roots, size_t n);
+
+private:
+    unordered_set<vm_object*> objects;
+    uintptr_t lowest = UINTPTR_MAX, highest = 0; // bounds of the addresses of the objects, to quickly rule out values
+    size_t allocated = 0; // bytes allocated since the previous collection
+    size_t live = 0; // bytes held by the objects which survived the previous collection
+    vector<vm_object*> pending; // objects marked, the elements or members of which are yet to be scanned
+
+    void track(vm_object* object, size_t bytes);
+    void mark(vm_value value);
+    static size_t size_of(const vm_object* object); // dispatches on the kind of the object to the overloads below
+    static size_t size_of(const vm_string* str);
+    static size_t size_of(const vm_array* arr);
+    static size_t size_of(const vm_struct* instance);
+    static void free(vm_object* object);
+};
+
+#endif //CPS2000_VM_HEAP_H